@@ -61,7 +61,14 @@
 #include <arg.h>
 #include <stdlib.h>
 #include <ctime>
+#include <cmath>
+#include <climits>
+#include <chrono>
+#include <thread>
 #include <sstream>
+#include <set>
+#include <algorithm>
+
 #include <base/PasswordFile.h>
 #include <base_utils/Format.hxx>
 #include <pom/pom/om_flags.hxx>
@@ -112,6 +119,32 @@
 #include <base_utils/OSEnvironment.hxx>
 #include <TcCrypto/TcCrypto.h>
 
+#if defined( WNT )
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#if defined( __AVX2__ )
+#include <immintrin.h>
+#define SLV_UTF8_AVX2
+#elif defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#include <emmintrin.h>
+#define SLV_UTF8_SSE2
+#if defined( __SSSE3__ )
+#include <tmmintrin.h>
+#define SLV_UTF8_SSSE3
+#endif
+#endif
+
 #ifdef WNT
 #define strcasecmp stricmp
 #define strncasecmp strnicmp
@@ -216,9 +249,19 @@ typedef  struct args
     int help;                /**< 0 = minimum usage help, 1 = detailed help information. */
     int keep_system_log;     /**< true = keep the system log when process has terminated */
     logical alt;             /**< true = keep the system log when process has terminated */
+    logical both_flag;       /**< true = process both from_uids and to_uids in a single run */
+    logical seq_flag;        /**< true = process flattened classes one statement at a time */
     char* file_name;         /**< File name from the command line */
     logical log_details;     /**< true = log addition details in the syslog and keep the system log when process has terminated */
     char* val_class_n;       /**< Validation class name, primarily used for the definitive source of object details such as the object's class ID (cpid), etc. */
+    int  chunk_size;         /**< Number of keys processed per working transaction, 0 = all work is done in a single transaction */
+    int  max_rows_per_sec;   /**< Throttle for chunked DML (rows per second), 0 = no throttle */
+    logical estimate_flag;   /**< true = estimate the counts from a block sample instead of a full run */
+    double sample_pct;       /**< Percentage of table blocks read with -estimate */
+    char* out_file;          /**< -find_ref/-validate_cids: every matching row is streamed to this CSV file, -max does not apply. -find_class: uid,class file. -find_stub: one CSV line per stub. -edit_array: reject file */
+    int  resume_line;        /**< -edit_array: number of CSV data lines skipped, I.e. the last line committed by a previous -chunk= run */
+    int  threads;            /**< -scan_vla: degree of parallelism of the VLA table scans, 0 = database default */
+    char* bench;             /**< Name of the micro-benchmark to run, no database connection is made */
  } args_t;
 
 
@@ -241,6 +284,9 @@ typedef  struct bp
 typedef struct ref
 {
     char uid[MAX_UID_SIZE + 1];             /**< Object IDs (UIDs) */
+    int  vla_cat;                           /**< -scan_vla: inconsistency category of the object's VLA (VLA_CAT_*) */
+    int  vla_cnt;                           /**< -scan_vla: count column of the object's VLA */
+    int  vla_rows;                          /**< -scan_vla: number of VLA rows of the object */
  } ref_t;
 
 
@@ -250,6 +296,8 @@ typedef struct ref_cpid
     char uid[MAX_UID_SIZE + 1];              /**< Object IDs (UIDs) */
     int ref_cid;                             /**< class ID found in the reference (bad class ID) */
     int tar_cid;                             /**< class ID found in the target table (good class ID) */
+    int slot;                                /**< Small-array slot (column offset) holding the reference, 0 otherwise */
+    int vc_idx;                              /**< Validation class whose table holds the target, only used with -vc=ALL */
 } ref_cpid_t;
 
 
@@ -363,11 +411,15 @@ static void output_scan_vla_attr_hdr( const char prefix, const cls_t* cls, const
 static void output_scan_vla_details( const char prefix, const cls_t* cls, const cls_t* flat, const att_t* att );
 static void output_scan_vla_parallel_data( const cls_t* cls, const cls_t* flat, att_t* attr );
 static int get_inconsistent_vlas( cls_t* cls, const cls_t* flat, att_t* att );
+static int repair_vlas( cls_t* cls, const cls_t* flat, att_t* att, int* repaired );
+static int count_vla_tables( const std::vector<hier_t>& hier, const std::vector<cls_t>& meta );
+static void output_scan_vla_progress( int accum_cnt );
 static int output_vlas( cls_t* cls, int* accum_cnt, int* attr_cnt, char** last_attr_name );
 static int output_flattened_vlas( const std::vector<hier_t>& hier, std::vector<cls_t>& meta, cls_t* flat, int* accum_cnt, int* attr_cnt );
 static std::string get_sa_where_clause( const att_t *att );
 static std::string get_sa_sql_extension( const att_t *att, const std::string base_sql, const std::string to_uid );
 static int get_refs( cls_t *cls, const cls_t *flat, att_t *att );
+static int stream_refs( cls_t *cls, const cls_t *flat, att_t *att );
 static int output_refs( cls_t *cls, int *accum_cnt, int *attr_cnt, char **last_attr_name );
 static int output_flattened_refs( const std::vector<hier_t>& hier, std::vector<cls_t>& meta, cls_t* flat, int* accum_cnt, int* attr_cnt );
 static int get_ref_cnt( const cls_t *cls, const cls_t *flat, const att_t *att, const std::string from_uid, const std::string to_uid, int* count );
@@ -376,6 +428,8 @@ static int query_class_to_find_class_of_uid ( std::vector< std::string > uids, c
 static int query_class_to_find_class_of_uid (  const std::string uid, const std::string target_class, std::string  &found_class );
 static std::string get_class_name_from_cpid( std::string cpid );
 static int get_flattened_class_names( std::vector< std::string > &flattened_classes );
+static int query_flattened_classes_to_find_class_of_uids( std::vector< std::string > &uids, std::vector< std::string > &flattened_classes, std::map< std::string, std::string > &found_classes );
+static int find_class_bulk( int* found_count );
 static int find_unresolved( std::vector< std::string > &original_vec, std::map< std::string, std::string > &result_map, std::vector< std::string > &unresolved_vec );
 static int find_unresolved( const std::string class_name, std::vector< std::string > &original_vec, std::map< std::string, std::string > &result_map, std::vector< std::string > &unresolved_vec );
 static int get_and_validate_class_tag(const std::string uid, const std::string target_class, std::string &found_class, tag_t* classTag, logical* db_validated, const char* option);
@@ -383,6 +437,7 @@ static int lockAndUnlock(tag_t objTag, tag_t classTag, const std::string uid);
 static int validate_cmd_line_class_and_attribute_params( );
 static std::string bitwise_and( const char* column, int value );
 static void output_stub_details( std::vector<std::string>* uid_vec, int* found_count );
+static std::string list_to_csv_string( std::vector<std::string> list );
 
 static logical refreshToLock( tag_t tag, int pom_lock, tag_t class_tag );
 static logical loadToNoLock( tag_t tag, tag_t class_tag );
@@ -397,7 +452,7 @@ static int database_tx_check();
 static int find_ref_op( int *found_count );
 static int find_ext_ref_op();
 static int check_ref_op();
-static int find_class_op();
+static int find_class_op( int* found_count );
 static int find_stub_op( int* found_count );
 static int load_obj_op();
 static int add_ref_op();
@@ -406,21 +461,30 @@ static int delete_obj_op();
 static int validate_bp_op( Op op );
 static int correct_bp_op( Op op );
 static int validate_or_correct_bp( Op op );
-static int where_ref_op();
+static int where_ref_op( int* found_count );
 static int str_len_val_op(int* bad_count );
+static int str_len_val_attr(const char* cls, const char* attr, int tar_type, int tar_slen, int tar_arry, const char* uid, int* bad_count, logical* work_done);
+static int str_len_val_all(int* bad_count);
+static int run_bench( const char* name );
+static int EV_bench_csv( );
+static logical slv_client_side();
 static int str_len_meta_op();
 static int scan_vla_op( int* found_count ); 
 static int remove_unneeded_bp_op( int* found_count );
 static int validate_bp2_op( int* found_count );
 static int validate_cids_op( int* found_count );
-static int edit_array_op( );
+static int edit_array_op( int* found_count );
 
 static logical compare_object_to_bp( const std::string from_uid, const std::string from_class, const std::string to_uid, const std::string to_class, int refs, std::vector< bp_t > &bptrs );
 static logical is_digit( char ch );
 
 static int get_string_sizes(const char *cls_tbl, const char *cls_col, int max_size, const char* uid, std::vector< std::string >  *uid_vec, std::vector< std::string > &puids, std::vector< int > &calc_sizes);
+static int get_client_string_sizes(const char *tbl, const char *col, logical is_vla, int max_size, const char* uid, std::vector< std::string >  *uid_vec, std::vector< std::string > &puids, std::vector< int > *seqs, std::vector< int > &calc_sizes);
+static int get_table_string_sizes(const char *cls_tbl, std::vector< std::string > &cols, std::vector< int > &max_sizes, std::vector< std::string > *uid_vec, std::vector< std::vector< std::string > > &puids, std::vector< std::vector< int > > &calc_sizes);
+static int get_client_table_string_sizes(const char *cls_tbl, std::vector< std::string > &cols, std::vector< int > &max_sizes, std::vector< std::string > *uid_vec, std::vector< std::vector< std::string > > &puids, std::vector< std::vector< int > > &calc_sizes);
 static int validate_string_sizes(const char* func, const char* cls, const char* attr, const char *cls_tbl, const char *cls_col, int max_size, std::vector< std::string > &puids, std::vector< int > &calc_sizes, int* bad_count);
 static int truncate_strings(const char *tbl, const char *col, int max_size, EIM_uid_t *uids, int* ints, int size);
+static void SLV_release_keys();
 
 static int get_vla_string_sizes(const char *cls_tbl, const char *cls_col, int max_size, const char* uid, std::vector< std::string >  *uid_vec, std::vector< std::string > &puids, std::vector< int > &seqs, std::vector< int > &calc_sizes);
 static int validate_vla_string_sizes(const char* func, const char* cls, const char* attr, const char *cls_tbl, const char *cls_col, int max_size, std::vector< std::string > &puids, std::vector< int > &seqs, std::vector< int > &calc_sizes, int* bad_count);
@@ -450,6 +514,27 @@ static int get_class_table_name( const char* cls_name, const char** cls_tbl );
 static std::string get_storage_mode( const char* cls_name );
 static std::string get_top_query_table( int cid );
 
+/* UID set routines */
+static logical is_uid_file_op( Op op );
+static int     read_uid_file( FILE* fp, const char* file_name, int* line_no, int max_uids, std::vector< std::string >* uid_vec );
+static int     load_uid_file( const char* file_name, std::vector< std::string >* uid_vec );
+static int     UID_SET_stage( std::vector< std::string >* uids );
+static int     exec_uid_array_dml( const char* sql, const char* message, EIM_uid_t* uids, int size );
+static void    UID_SET_release();
+static char*   create_uid_specific_where_clause( const char* sql_prefix, std::vector<std::string>* uids );
+static int     RUB_dml_or_ddl( const char* sql );
+static void    RUB_create_temporary_table_index( const char* index_name, const char* table_name, const char* column_name );
+static void    RUB_drop_temporary_table_index( const char* index_name, const char* table_name );
+
+/* Streaming export (-out=) routines */
+static int     OUT_open( const char* header );
+static void    OUT_printf( const char* format, ... );
+static int     OUT_close();
+static int     OUT_stage( const std::string& select_sql );
+static void    OUT_fetch_page( int first_rn, std::vector< ref_cpid_t >& page );
+static void    OUT_clear_stage();
+static void    OUT_release_stage();
+
 /* **********************
 ** Licensing routines
 ** *********************/
@@ -515,6 +600,30 @@ static int DMS_cache_cpids_of_class( const unsigned int n_tags, const tag_t *ins
 static args_t *args;
 static int DDS_array_value_g = 7;  /* Arrays of length 7 or greater are large arrays */
 
+/* Streaming export (-out=) state, see the OUT_* routines. */
+static char* tbl_out_rows = NULL;
+
+static const char* idx_out_rows = "RM1_I_OUT_ROWS";
+
+static const int    OUT_PAGE_ROWS   = 10000;         // Rows read (from the staging table or a paged query) per query.
+static const size_t OUT_BLOCK_BYTES = 64 * 1024;     // Output is written to the file in blocks of this size.
+
+static FILE*     out_fp = NULL;
+static long long out_row_cnt = 0;                   // Data rows written to the -out file.
+
+/* Staged UID set (-uid= lists and -f= files), see the UID set routines. */
+static char* tbl_uid_set = NULL;
+
+static const char* idx_uid_set = "RM1_I_UID_SET";
+static const char* uid_set_col_name = "puid";
+
+static std::set<std::string> uid_set_staged;  // UIDs currently in tbl_uid_set
+
+/* Sampled UIDs (-estimate), see the block sampling routines. */
+static char* tbl_sample_uids = NULL;
+
+static const char* idx_sample_uids = "RM1_I_SAMPLE_UIDS";
+
 
 /* Each image target has its own unique logger named after itself. */
 static Teamcenter::Logging::Logger* logger()
@@ -610,9 +719,19 @@ extern int main (int argc, char **argv)
         args->help = 0;
         args->keep_system_log = FALSE;
         args->alt = FALSE;
+        args->both_flag = FALSE;
+        args->seq_flag = FALSE;
         args->file_name = NULL;
         args->log_details = FALSE;
         args->val_class_n = NULL;
+        args->chunk_size = 0;
+        args->max_rows_per_sec = 0;
+        args->estimate_flag = FALSE;
+        args->sample_pct = 1.0;
+        args->out_file = NULL;
+        args->threads = 0;
+        args->bench = NULL;
+        args->resume_line = 0;
 
         getCmdLineArgs( argc, argv, args );
 
@@ -622,6 +741,11 @@ extern int main (int argc, char **argv)
             return (OK);
         }
 
+        if ( args->bench != NULL )
+        {
+            return run_bench( args->bench );
+        }
+
         if ( args->keep_system_log || args->log_details )
         {
             ERROR_set_log_file_status( ERROR_KEEP_LOG_FILE );
@@ -714,6 +838,20 @@ extern int main (int argc, char **argv)
 
         EIM_start_transaction();
 
+        if ( args->file_name != NULL && is_uid_file_op( args->op ) )
+        {
+            ifail = load_uid_file( args->file_name, args->uid_vec );
+
+            if ( ifail != OK )
+            {
+                EIM_commit_transaction( "reference_manager" );
+                POM_stop( true );
+                return ifail;
+            }
+
+            args->uid_flag = ( args->uid_vec->size() > 0 ? TRUE : FALSE );
+        }
+
         int found_count = 0;
 
         switch (args->op)
@@ -735,7 +873,7 @@ extern int main (int argc, char **argv)
 
        case find_class:
             cons_out( "\nOperation: find class" );
-            ifail = find_class_op();
+            ifail = find_class_op( &found_count );
             break;
 
        case find_stub:
@@ -775,12 +913,13 @@ extern int main (int argc, char **argv)
 
       case where_ref:
            cons_out( "\nOperation: where-referenced" );
-           ifail = where_ref_op();
+           ifail = where_ref_op( &found_count );
            break;
 
       case str_len_val:
           cons_out("\nOperation: string length validation");
           ifail = str_len_val_op( &found_count );
+          SLV_release_keys();
           break;
 
       case str_len_meta:
@@ -805,7 +944,7 @@ extern int main (int argc, char **argv)
 
       case edit_array:
           cons_out( "\nOperation: edit array" );
-          ifail = edit_array_op( );
+          ifail = edit_array_op( &found_count );
           break;   
 
       case validate_cids:
@@ -819,6 +958,8 @@ extern int main (int argc, char **argv)
            break;
         }
 
+        UID_SET_release();
+
         if ( args->target_cnt >= 0 && found_count != args->target_cnt )
         {
             ifail = POM_invalid_value;
@@ -1163,6 +1304,17 @@ static int find_ref_op( int* found_count )
         dumpRefMetadata( meta );
     }
 
+    if( args->out_file != NULL )
+    {
+        // -max does not apply, every reference is streamed to the -out file.
+        args->max_ref_cnt = INT_MAX;
+
+        if( OUT_open( "class,attribute,table,column,puid" ) != OK )
+        {
+            return POM_invalid_value;
+        }
+    }
+
     /* Loop through each class and each reference    */
     /* looking for a reference to the specified UID. */
     int ref_cnt = 0;
@@ -1296,6 +1448,16 @@ static int find_ref_op( int* found_count )
     msg << "\nTotal references found                    = " << ref_cnt;
     cons_out( msg.str() );
 
+    if( args->out_file != NULL )
+    {
+        int lcl_ifail = OUT_close();
+
+        if( ifail == OK )
+        {
+            ifail = lcl_ifail;
+        }
+    }
+
     return( ifail );
 }
 
@@ -1428,10 +1590,11 @@ static int find_ext_ref_op()
     return( ifail );
 }
 
-static int find_class_op()
+static int find_class_op( int* found_count )
 {
     cons_out( "" );
     int ifail = OK;
+    *found_count = 0;
     std::vector< std::string >  *uid_vec_lcl = args->uid_vec;
     std::string class_name;
     
@@ -1445,7 +1608,11 @@ static int find_class_op()
     std::map< std::string, std::string > found_classes;
     std::vector< std::string > flattened_classes;
 
-    if( args->uid_flag )
+    if( args->out_file != NULL && ( args->uid_flag || args->file_name != NULL ) )
+    {
+        ifail = find_class_bulk( found_count );
+    }
+    else if( args->uid_flag )
     {
         if( args->class_flag && args->class_n != NULL && strcmp( args->class_n, "POM_object" ) != 0 )
         {
@@ -1467,30 +1634,9 @@ static int find_class_op()
         {
             ifail = get_flattened_class_names( flattened_classes );
 
-            for( int j=0; j<flattened_classes.size(); j++ ) 
+            if( flattened_classes.size() > 0 )
             {
-                if( (j & 1) == 0 )
-                {
-                    ifail = query_class_to_find_class_of_uid( unresolved_02, flattened_classes[j].c_str(), found_classes );
-                    unresolved_01.clear();
-                    ifail = find_unresolved( unresolved_02, found_classes, unresolved_01 );
-
-                    if( unresolved_01.size() == 0 )
-                    {
-                        break;
-                    }
-                }
-                else
-                {
-                    ifail = query_class_to_find_class_of_uid( unresolved_01, flattened_classes[j].c_str(), found_classes );
-                    unresolved_02.clear();
-                    ifail = find_unresolved( unresolved_01, found_classes, unresolved_02 );
-
-                    if( unresolved_02.size() == 0 )
-                    {
-                        break;
-                    }
-                }
+                ifail = query_flattened_classes_to_find_class_of_uids( unresolved_02, flattened_classes, found_classes );
             }
         }
 
@@ -1503,6 +1649,7 @@ static int find_class_op()
             if( it != found_classes.end() )
             {
                 uid_class_name = it->second;
+                (*found_count)++;
             }
 
             std::stringstream msg;
@@ -1513,7 +1660,7 @@ static int find_class_op()
     }
     else
     {
-        cons_out( "The -uid=<uid> option is required with the -find_class operation" );
+        cons_out( "The -uid=<uid> or -f=<uid_file> option is required with the -find_class operation" );
         ifail = FAIL; 
     }
 
@@ -1527,7 +1674,7 @@ static int find_stub_op( int* found_count )
 
     if ( !args->uid_flag )
     {
-        cons_out( "The -uid=<uid> option is required with the -find_stub operation" );
+        cons_out( "The -uid=<uid> or -f=<uid_file> option is required with the -find_stub operation" );
         return FAIL;
     }
 
@@ -3404,111 +3551,173 @@ static int validate_or_correct_bp( Op op )
 }
 
 #define WHERE_REF_COL_CNT 6
+#define WHERE_REF_PAGE_UIDS 10000        // Target UIDs staged and queried per statement
 
-static int where_ref_op()
+/*
+Returns the target UID predicate of one -where_ref branch. A single UID is passed as
+bind variable :bind_no, more than one is matched against the staged UID set table so
+that each branch scans its table once for the whole set. The caller stages the set
+(UID_SET_stage) before building the statement.
+*/
+static std::string where_ref_uid_pred( const char* col, logical multi, int bind_no )
 {
-    int op_fail = OK;
+    std::stringstream pred;
+    pred << "WHERE " << col;
 
-    if( args->where_ref_sub != 1 && args->where_ref_sub != 2 )
+    if ( multi )
     {
-        ERROR_raise(ERROR_line, POM_internal_error, "Invalid internal where-ref option = %d.", args->where_ref_sub);
+        if ( tbl_uid_set == NULL )
+        {
+            ERROR_raise( ERROR_line, POM_internal_error, "The UID set must be staged before the -where_ref statement is built." );
+        }
+
+        pred << " IN (SELECT " << uid_set_col_name << " FROM " << tbl_uid_set << ") ";
+    }
+    else
+    {
+        pred << " = :" << bind_no << " ";
     }
 
-    if (args->where_ref_sub == 2 && !DDS_DB_object_exists("all_backpointer_references", DDS_view)) 
+    return pred.str();
+}
 
-    {
-        op_fail = FAIL;
+/*
+Queries and reports the references to one page of target UIDs. reported holds the UIDs
+already reported, found_count is incremented for each target that is referenced.
+*/
+static int where_ref_page( std::vector< std::string >* uids, std::set< std::string >& reported, int* found_count )
+{
+    /* Query the POM_BACKPOINTER and the PIMANRELATION tables */
+    /* looking for where the target UIDs might be referenced  */
 
-        cons_out("\nThe internal all_backpointer_references view is not available for this -where_ref2 operation");
+    int     op_fail = OK;
+    logical multi  = ( uids->size() > 1 );
+    int     n_bind = 0;
+
+    if( multi )
+    {
+        UID_SET_stage( uids );
     }
 
-    if( args->uid_flag && op_fail == OK )
+    std::stringstream sql;
+    if (args->where_ref_sub == 1)
     {
-        /* Query the POM_BACKPOINTER and the PIMANRELATION tables */
-        /* looking for where the target UID might be referenced   */
+        // Search the PIMANRELATION and POM_BACKPOINTER table for the specified UID.
+        if( EIM_does_table_exist( "PIMANRELATION" ) == OK )
+        {
+            sql << "SELECT 'PIMANRELATION' AS Table_name, 'rsecondary_objectu' AS Col_Name, a.puid AS PUID, a.rsecondary_objectu AS Ref_UID, a.rsecondary_objectc AS Ref_CPID, b.pname AS Ref_Class, a.rprimary_objectc AS Target_CPID, c.pname AS Target_Class, a.rprimary_objectu AS Target_UID ";
+            sql << "FROM PIMANRELATION a ";
+            sql << "LEFT OUTER JOIN PPOM_CLASS b ON a.rsecondary_objectc = b.pcpid ";
+            sql << "LEFT OUTER JOIN PPOM_CLASS c ON a.rprimary_objectc = c.pcpid ";
+            sql << where_ref_uid_pred( "a.rprimary_objectu", multi, ++n_bind );
 
-        std::vector< std::string >  tar_class;
-        std::vector< int >          tar_cpid;
-        std::string                 cur_class;
-        int                         cur_cpid = -2;
-        long                        ref_cnt = 0;
+            sql << "UNION ALL ";
 
-        std::stringstream sql;
-        if (args->where_ref_sub == 1)
+            sql << "SELECT 'PIMANRELATION' AS Table_name, 'rprimary_objectu' AS Col_Name, a.puid AS PUID, a.rprimary_objectu AS Ref_UID, a.rprimary_objectc AS Ref_CPID, b.pname AS Ref_Class, a.rsecondary_objectc AS Target_CPID, c.pname AS Target_Class, a.rsecondary_objectu AS Target_UID ";
+            sql << "FROM PIMANRELATION a ";
+            sql << "LEFT OUTER JOIN PPOM_CLASS b ON a.rprimary_objectc = b.pcpid ";
+            sql << "LEFT OUTER JOIN PPOM_CLASS c ON a.rsecondary_objectc = c.pcpid ";
+            sql << where_ref_uid_pred( "a.rsecondary_objectu", multi, ++n_bind );
+
+            sql << "UNION ALL ";
+        }
+        else
         {
-            // Search the PIMANRELATION and POM_BACKPOINTER table for the specified UID.
-            if( EIM_does_table_exist( "PIMANRELATION" ) == OK )
-            {
-                sql << "SELECT 'PIMANRELATION' AS Table_name, 'rsecondary_objectu' AS Col_Name, a.puid AS PUID, a.rsecondary_objectu AS Ref_UID, a.rsecondary_objectc AS Ref_CPID, b.pname AS Ref_Class, a.rprimary_objectc AS Target_CPID, c.pname AS Target_Class ";
-                sql << "FROM PIMANRELATION a ";
-                sql << "LEFT OUTER JOIN PPOM_CLASS b ON a.rsecondary_objectc = b.pcpid ";
-                sql << "LEFT OUTER JOIN PPOM_CLASS c ON a.rprimary_objectc = c.pcpid ";
-                sql << "WHERE rprimary_objectu = '" << args->uid << "' ";
+            cons_out( "\nNo PIMANRELATION table was found, removing PIMANRELATION from the target tables." );
+        }
 
-                sql << "UNION ALL ";
+        sql << "SELECT 'POM_BACKPOINTER' AS Table_name, 'from_uid' AS Col_Name, NULL AS PUID, a.from_uid AS Ref_UID, a.from_class AS Ref_CPID, b.pname AS Ref_Class, a.to_class AS Target_CPID, c.pname AS Target_Class, a.to_uid AS Target_UID ";
+        sql << "FROM POM_BACKPOINTER a ";
+        sql << "LEFT OUTER JOIN PPOM_CLASS b ON a.from_class = b.pcpid ";
+        sql << "LEFT OUTER JOIN PPOM_CLASS c ON a.to_class = c.pcpid ";
+        sql << where_ref_uid_pred( "a.to_uid", multi, ++n_bind );
 
-                sql << "SELECT 'PIMANRELATION' AS Table_name, 'rprimary_objectu' AS Col_Name, a.puid AS PUID, a.rprimary_objectu AS Ref_UID, a.rprimary_objectc AS Ref_CPID, b.pname AS Ref_Class, a.rsecondary_objectc AS Target_CPID, c.pname AS Target_Class ";
-                sql << "FROM PIMANRELATION a ";
-                sql << "LEFT OUTER JOIN PPOM_CLASS b ON a.rprimary_objectc = b.pcpid ";
-                sql << "LEFT OUTER JOIN PPOM_CLASS c ON a.rsecondary_objectc = c.pcpid ";
-                sql << "WHERE rsecondary_objectu = '" << args->uid << "' ";
+        sql << "UNION ALL ";
 
-                sql << "UNION ALL ";
-            }
-            else
-            {
-                cons_out( "\nNo PIMANRELATION table was found, removing PIMANRELATION from the target tables." );
-            }
+        sql << "SELECT 'POM_BACKPOINTER' AS Table_name, 'to_uid' AS Col_Name, NULL AS PUID, a.to_uid AS Ref_UID, a.to_class AS Ref_CPID, b.pname AS Ref_Class, a.from_class AS Target_CPID, c.pname AS Target_Class, a.from_uid AS Target_UID ";
+        sql << "FROM POM_BACKPOINTER a ";
+        sql << "LEFT OUTER JOIN PPOM_CLASS b ON a.to_class = b.pcpid ";
+        sql << "LEFT OUTER JOIN PPOM_CLASS c ON a.from_class = c.pcpid ";
+        sql << where_ref_uid_pred( "a.from_uid", multi, ++n_bind );
+    }
+    else if (args->where_ref_sub == 2)
+    {
+        // Search the all_backpointer_references view for the specified UID.
+        sql << "SELECT 'all_backpointer_references' AS Table_name, 'from_uid' AS Col_Name, NULL AS PUID, from_uid AS Ref_UID, -1 AS Ref_CPID, NULL AS Ref_Class, -1 AS Target_CPID, NULL AS Target_class, to_uid AS Target_UID FROM all_backpointer_references ";
+        sql << where_ref_uid_pred( "to_uid", multi, ++n_bind );
+
+        sql << "UNION ALL ";
+        sql << "SELECT 'all_backpointer_references' AS Table_name, 'to_uid' AS Col_Name, NULL AS PUID, to_uid AS Ref_UID, -1 AS Ref_CPID, NULL AS Ref_Class, -1 AS Target_CPID, NULL AS Target_class, from_uid AS Target_UID FROM all_backpointer_references ";
+        sql << where_ref_uid_pred( "from_uid", multi, ++n_bind );
+    }
 
-            sql << "SELECT 'POM_BACKPOINTER' AS Table_name, 'from_uid' AS Col_Name, NULL AS PUID, a.from_uid AS Ref_UID, a.from_class AS Ref_CPID, b.pname AS Ref_Class, a.to_class AS Target_CPID, c.pname AS Target_Class ";
-            sql << "FROM POM_BACKPOINTER a ";
-            sql << "LEFT OUTER JOIN PPOM_CLASS b ON a.from_class = b.pcpid ";
-            sql << "LEFT OUTER JOIN PPOM_CLASS c ON a.to_class = c.pcpid ";
-            sql << "WHERE a.to_uid = '" << args->uid << "' ";
 
-            sql << "UNION ALL ";
+    EIM_value_p_t headers = NULL;
+    EIM_row_p_t report = NULL;
+    EIM_row_p_t row;
+    EIM_select_var_t vars[9];
+    EIM_select_col( &(vars[0]), EIM_varchar, "Table_Name",   CLS_DB_NAME_SIZE+1, false);
+    EIM_select_col( &(vars[1]), EIM_varchar, "Col_Name",     ATT_DB_NAME_SIZE+1, false);
+    EIM_select_col( &(vars[2]), EIM_varchar, "PUID",         MAX_UID_SIZE+1,      true);
+    EIM_select_col( &(vars[3]), EIM_varchar, "Ref_UID",      MAX_UID_SIZE+1,     false);
+    EIM_select_col( &(vars[4]), EIM_integer, "Ref_CPID",     sizeof(int),        false);
+    EIM_select_col( &(vars[5]), EIM_varchar, "Ref_Class",    CLS_DB_NAME_SIZE+1, false);
+    EIM_select_col( &(vars[6]), EIM_integer, "Target_CPID",  sizeof(int),         true);
+    EIM_select_col( &(vars[7]), EIM_varchar, "Target_Class", CLS_DB_NAME_SIZE+1,  true);
+    EIM_select_col( &(vars[8]), EIM_varchar, "Target_UID",   MAX_UID_SIZE+1,     false);
 
-            sql << "SELECT 'POM_BACKPOINTER' AS Table_name, 'to_uid' AS Col_Name, NULL AS PUID, a.to_uid AS Ref_UID, a.to_class AS Ref_CPID, b.pname AS Ref_Class, a.from_class AS Target_CPID, c.pname AS Target_Class ";
-            sql << "FROM POM_BACKPOINTER a ";
-            sql << "LEFT OUTER JOIN PPOM_CLASS b ON a.to_class = b.pcpid ";
-            sql << "LEFT OUTER JOIN PPOM_CLASS c ON a.from_class = c.pcpid ";
-            sql << "WHERE a.from_uid = '" << args->uid << "' ";
-        }
-        else if (args->where_ref_sub == 2)
-        {
-            // Search the all_backpointer_references view for the specified UID.
-            sql << "SELECT 'all_backpointer_references' AS Table_name, 'from_uid' AS Col_Name, NULL AS PUID, from_uid AS Ref_UID, -1 AS Ref_CPID, NULL AS Ref_Class, -1 AS Target_CPID, NULL AS Target_class FROM all_backpointer_references ";
-            sql << "WHERE to_uid = '" << args->uid << "' ";
+    // A single UID is bound once per branch, the same value for each placeholder.
+    EIM_bind_var_t bind_vars[4];
 
-            sql << "UNION ALL ";
-            sql << "SELECT 'all_backpointer_references' AS Table_name, 'to_uid' AS Col_Name, NULL AS PUID, to_uid AS Ref_UID, -1 AS Ref_CPID, NULL AS Ref_Class, -1 AS Target_CPID, NULL AS Target_class FROM all_backpointer_references ";
-            sql << "WHERE from_uid = '" << args->uid << "' ";
+    for( int i = 0; i < ( multi ? 0 : n_bind ); i++ )
+    {
+        EIM_bind_val( &bind_vars[i], EIM_puid, strlen( (*uids)[0].c_str() ) + 1, (*uids)[0].c_str() );
+    }
+
+    op_fail = EIM_exec_sql_bind(sql.str().c_str(), &headers, &report, NULL, 9, vars, ( multi ? 0 : n_bind ), bind_vars);
+
+    // Group the referencing rows by target UID.
+    std::map< std::string, std::vector< EIM_row_p_t > > tar_rows;
+
+    for( row = ( op_fail == OK ? report : NULL ); row != NULL; row = row->next )
+    {
+        char *target_uid = NULL;
+        EIM_find_value (headers, row->line, "Target_UID", EIM_varchar, (void **)&target_uid);
+
+        if( target_uid != NULL )
+        {
+            tar_rows[target_uid].push_back( row );
         }
+    }
 
+    for( int u = 0; u < uids->size() && op_fail == OK; u++ )
+    {
+        const char* tar_uid = (*uids)[u].c_str();
 
-        EIM_value_p_t headers;
-        EIM_row_p_t report;
-        EIM_row_p_t row;
-        EIM_select_var_t vars[8];
-        EIM_select_col( &(vars[0]), EIM_varchar, "Table_Name",   CLS_DB_NAME_SIZE+1, false);
-        EIM_select_col( &(vars[1]), EIM_varchar, "Col_Name",     ATT_DB_NAME_SIZE+1, false);
-        EIM_select_col( &(vars[2]), EIM_varchar, "PUID",         MAX_UID_SIZE+1,      true);
-        EIM_select_col( &(vars[3]), EIM_varchar, "Ref_UID",      MAX_UID_SIZE+1,     false);
-        EIM_select_col( &(vars[4]), EIM_integer, "Ref_CPID",     sizeof(int),        false);
-        EIM_select_col( &(vars[5]), EIM_varchar, "Ref_Class",    CLS_DB_NAME_SIZE+1, false);
-        EIM_select_col( &(vars[6]), EIM_integer, "Target_CPID",  sizeof(int),         true);
-        EIM_select_col( &(vars[7]), EIM_varchar, "Target_Class", CLS_DB_NAME_SIZE+1,  true);
+        if( !reported.insert( tar_uid ).second )
+        {
+            continue;
+        }
 
-        op_fail = EIM_exec_sql_bind(sql.str().c_str(), &headers, &report, NULL, 8, vars, 0, NULL);
+        std::map< std::string, std::vector< EIM_row_p_t > >::const_iterator tar_it = tar_rows.find( tar_uid );
+
+        std::vector< std::string >  tar_class;
+        std::vector< int >          tar_cpid;
+        int                         cur_cpid = -2;
+        long                        ref_cnt = 0;
 
-        if( report != NULL && op_fail == OK )
+        if( tar_it != tar_rows.end() )
         {
+            (*found_count)++;
+
             int col_size[WHERE_REF_COL_CNT] = { 6, 6, 6, 6, 4, 6 };
             int col_strt[WHERE_REF_COL_CNT] = { 0, 0, 0, 0, 0, 0 };
             const char* hdrs[WHERE_REF_COL_CNT] = { "Table", "Column", "PUID", "Ref_UID", "Ref_CPID", "Ref_Class" };
 
-            for( row = report; row != NULL; row = row->next )
+            for( int r = 0; r < tar_it->second.size(); r++ )
             {
+                row = tar_it->second[r];
+
                 char *table_name = NULL;
                 char *col_name = NULL;
                 char *puid = NULL;
@@ -3588,7 +3797,7 @@ static int where_ref_op()
                 {
                     std::stringstream msg;
                     msg.str("");
-                    msg << args->uid << "  " << tar_cpid[i] << "  " << tar_class[i];
+                    msg << tar_uid << "  " << tar_cpid[i] << "  " << tar_class[i];
                     cons_out( msg.str() );
                 }
             }
@@ -3596,7 +3805,7 @@ static int where_ref_op()
             {
                 std::stringstream msg;
                 msg.str("");
-                msg << "\nTARGET: " << args->uid;
+                msg << "\nTARGET: " << tar_uid;
                 cons_out( msg.str() );
             }
 
@@ -3627,8 +3836,10 @@ static int where_ref_op()
 
 
             // Output referencing data.
-            for( row = report; row != NULL; row = row->next )
+            for( int r = 0; r < tar_it->second.size(); r++ )
             {
+                row = tar_it->second[r];
+
                 char *table_name = NULL;
                 char *col_name = NULL;
                 char *puid = NULL;
@@ -3723,7 +3934,7 @@ static int where_ref_op()
                     data_out << " ";
                     tmp++;
                 }
-           
+       
                 // ref_class
                 tmp = 0;
                 if( ref_class != NULL )   
@@ -3754,7 +3965,7 @@ static int where_ref_op()
                     data_out << " ";
                     tmp++;
                 }
-           
+       
                 // target_class
                 tmp = 0;
                 if( target_class != NULL )   
@@ -3765,30 +3976,80 @@ static int where_ref_op()
 */
                 cons_out( data_out.str() );
             }
-
-            EIM_free_result( headers, report);
         }
         else
         {
             std::stringstream msg;
-            if( args->where_ref_sub == 1)  msg << "\nThe target object (" << args->uid << ") was NOT found in POM_BACKPOINTER or in PIMANRELATION.";
-            if( args->where_ref_sub == 2)  msg << "\nThe target object (" << args->uid << ") was NOT found in all_backpointer_references view.";
+            if( args->where_ref_sub == 1)  msg << "\nThe target object (" << tar_uid << ") was NOT found in POM_BACKPOINTER or in PIMANRELATION.";
+            if( args->where_ref_sub == 2)  msg << "\nThe target object (" << tar_uid << ") was NOT found in all_backpointer_references view.";
             cons_out( msg.str() );
         }
+    }
+
+    EIM_free_result( headers, report);
+
+    if( op_fail != OK )
+    {
+        std::stringstream msg;
+        if( args->where_ref_sub == 1)  msg << "\nUnable to access PIMANRELATION table or POM_BACKPOINTER table, ifail = " << op_fail;
+        if( args->where_ref_sub == 2)  msg << "\nUnable to access all_backpointer_references view, ifail = " << op_fail;
+        cons_out( msg.str() );
+    }
+
+    return( op_fail );
+}
+
+static int where_ref_op( int* found_count )
+{
+    int op_fail = OK;
+
+    if( args->where_ref_sub != 1 && args->where_ref_sub != 2 )
+    {
+        ERROR_raise(ERROR_line, POM_internal_error, "Invalid internal where-ref option = %d.", args->where_ref_sub);
+    }
+
+    if (args->where_ref_sub == 2 && !DDS_DB_object_exists("all_backpointer_references", DDS_view)) 
+
+    {
+        op_fail = FAIL;
+
+        cons_out("\nThe internal all_backpointer_references view is not available for this -where_ref2 operation");
+    }
 
-        if( op_fail != OK )
+    if( args->uid_flag && args->uid_vec->size() > 0 && op_fail == OK )
+    {
+        std::vector< std::string >* uids = args->uid_vec;
+        std::set< std::string > reported;
+        *found_count = 0;
+
+        // The target UIDs are staged and queried a page at a time, so that neither the
+        // UID set nor the referencing rows of a long -f= file are held in full.
+        for( size_t first = 0; first < uids->size() && op_fail == OK; first += WHERE_REF_PAGE_UIDS )
         {
+            size_t last = ( first + WHERE_REF_PAGE_UIDS < uids->size() ? first + WHERE_REF_PAGE_UIDS : uids->size() );
+            std::vector< std::string > page( uids->begin() + first, uids->begin() + last );
+
+            ERROR_PROTECT
+
+            op_fail = where_ref_page( &page, reported, found_count );
+
+            ERROR_RECOVER
+
+            op_fail = ERROR_ask_failure_code();
+            EIM_clear_error();
+
             std::stringstream msg;
-            if( args->where_ref_sub == 1)  msg << "\nUnable to access PIMANRELATION table or POM_BACKPOINTER table, ifail = " << op_fail;
-            if( args->where_ref_sub == 2)  msg << "\nUnable to access all_backpointer_references view, ifail = " << op_fail;
+            msg << "\nUnable to search for references to the target UIDs, ifail = " << op_fail << ". See syslog for details.";
             cons_out( msg.str() );
+
+            ERROR_END
         }
      }  
     else 
     {
         if (op_fail == OK)
         {
-            cons_out("\nThe -uid=<uid> option is required with the -where_ref and -where_ref2 options");
+            cons_out("\nThe -uid=<uid> or -f=<uid_file> option is required with the -where_ref and -where_ref2 options");
         }
         
         op_fail = FAIL; 
@@ -3814,22 +4075,20 @@ static int str_len_val_op( int* bad_count)
     logical     work_done = FALSE;
     *bad_count = 0;
 
-    if ( EIM_dbplat() == EIM_dbplat_postgres || ( EIM_dbplat() == EIM_dbplat_oracle && EIM_get_db_cs() == TEXT_CODESET_UTF8 ) )
+    if ( args->expected_error == POM_op_not_supported )
     {
-        std::stringstream msg;
-        msg << "The -str_len_val options is only avaliable with the MS SQL Server, or with Oracle that is NOT configured for UTF-8"; 
-        op_fail = error_out(ERROR_line, POM_op_not_supported, msg.str());
+        // This feature is now supported on every platform, so change an expected-error of POM_op_not_supported to POM_ok.
+        args->expected_error = POM_ok;   
     }
 
-    if (op_fail != OK)
+    if ( slv_client_side() )
     {
-        return(op_fail);
+        cons_out( "String sizes are measured on the client (UTF-8 byte length, character count and validity)." );
     }
 
-    if ( EIM_dbplat() == EIM_dbplat_oracle && args->expected_error == POM_op_not_supported)
+    if ( args->all_flag )
     {
-        // if this feature, in this configurationa, is actually supported, then change expected-error of POM_op_not_supported to POM_ok.
-        args->expected_error = POM_ok;   
+        return( str_len_val_all( bad_count ) );
     }
 
     // Parse the "from" arguments
@@ -3931,19 +4190,11 @@ static int str_len_val_op( int* bad_count)
         return(op_fail);
     }
 
-    const char* cls_tbl = NULL;
-    const char* cls_col = NULL;
-    const char* att_tbl = NULL;
-    const char* att_col = NULL;
-
-    op_fail = get_tables_and_columns(tar_class.c_str(), tar_attribute.c_str(), &cls_tbl, &cls_col, &att_tbl, &att_col);
+    const char* uid = NULL;
 
-    if (op_fail != OK)
+    if (!tar_uid.empty())
     {
-        std::stringstream msg;
-        msg << "Unable to find tables and columns for class " << tar_class << " and attribute " << tar_attribute << " using get_tables_and_columns()";
-        op_fail = error_out(ERROR_line, op_fail, msg.str());
-        return(op_fail);
+        uid = tar_uid.c_str();
     }
 
     op_fail = database_tx_check();
@@ -3955,6 +4206,45 @@ static int str_len_val_op( int* bad_count)
 
     START_WORKING_TX(str_len_val_tx, "str_len_val_tx");
 
+    op_fail = str_len_val_attr(tar_class.c_str(), tar_attribute.c_str(), tar_type, tar_slen, tar_arry, uid, bad_count, &work_done);
+
+    // Commit the work only if it was successful and the user said to commit on the command line.
+    if ((op_fail == OK) && args->commit_flag && work_done)
+    {
+        COMMIT_WORKING_TX(str_len_val_tx, "str_len_val_tx");
+    }
+    else
+    {
+        ROLLBACK_WORKING_TX(str_len_val_tx, "str_len_val_tx");
+    }
+
+    return(op_fail);
+}
+
+/*------------------------------------------------------------------------
+** Validates, or corrects with -commit, the string data or string lengths of one
+** POM_string or POM_long_string attribute. The caller owns the working transaction.
+** ----------------------------------------------------------------------- */
+static int str_len_val_attr(const char* cls, const char* attr, int tar_type, int tar_slen, int tar_arry, const char* uid, int* bad_count, logical* work_done)
+{
+    int op_fail = OK;
+    int ifail = OK;
+
+    const char* cls_tbl = NULL;
+    const char* cls_col = NULL;
+    const char* att_tbl = NULL;
+    const char* att_col = NULL;
+
+    op_fail = get_tables_and_columns(cls, attr, &cls_tbl, &cls_col, &att_tbl, &att_col);
+
+    if (op_fail != OK)
+    {
+        std::stringstream msg;
+        msg << "Unable to find tables and columns for class " << cls << " and attribute " << attr << " using get_tables_and_columns()";
+        op_fail = error_out(ERROR_line, op_fail, msg.str());
+        return(op_fail);
+    }
+
     ERROR_PROTECT
 
     if (tar_arry == 1 || tar_arry == -1 || tar_arry > 6 || tar_arry <= 6)
@@ -3964,13 +4254,6 @@ static int str_len_val_op( int* bad_count)
         std::vector< int > calc_sizes;
         std::vector< int > stored_sizes;
 
-        const char* uid = NULL;
-
-        if (!tar_uid.empty())
-        {
-            uid = tar_uid.c_str();
-        }
-
         switch (tar_type)
         {
         case POM_long_string:
@@ -3992,7 +4275,7 @@ static int str_len_val_op( int* bad_count)
                 {
                     // Now validate the stored string sizes with the data's actual length. 
                     // If -commit was specified on the command line then update the stored string sizes.
-                    ifail = validate_long_string_sizes("LSt", tar_class.c_str(), tar_attribute.c_str(), cls_tbl, cls_col, att_tbl, att_col, puids, calc_sizes, bad_count);
+                    ifail = validate_long_string_sizes("LSt", cls, attr, cls_tbl, cls_col, att_tbl, att_col, puids, calc_sizes, bad_count);
 
                     if (ifail != OK)
                     {
@@ -4002,7 +4285,7 @@ static int str_len_val_op( int* bad_count)
                     }
                     else
                     {
-                        work_done = true;
+                        *work_done = true;
                     }
                 }
                 else
@@ -4033,7 +4316,7 @@ static int str_len_val_op( int* bad_count)
                 {
                     // No validate the stored string sizes with the data's actual length. 
                     // If -commit was specified on the command line then update the stored string sizes.
-                    ifail = validate_vla_long_string_sizes("LSt(VLA)", tar_class.c_str(), tar_attribute.c_str(), att_tbl, att_col, puids, pseqs, calc_sizes, bad_count);
+                    ifail = validate_vla_long_string_sizes("LSt(VLA)", cls, attr, att_tbl, att_col, puids, pseqs, calc_sizes, bad_count);
 
                     if (ifail != OK)
                     {
@@ -4043,7 +4326,7 @@ static int str_len_val_op( int* bad_count)
                     }
                     else
                     {
-                        work_done = true;
+                        *work_done = true;
                     }
                 }
                 else
@@ -4074,7 +4357,7 @@ static int str_len_val_op( int* bad_count)
                 {
                     // No validate the stored string sizes with the data's actual length. 
                     // If -commit was specified on the command line then update the stored string sizes.
-                    ifail = validate_la_long_string_sizes(tar_class.c_str(), tar_attribute.c_str(), att_tbl, att_col, puids, pseqs, calc_sizes, bad_count);
+                    ifail = validate_la_long_string_sizes(cls, attr, att_tbl, att_col, puids, pseqs, calc_sizes, bad_count);
 
                     if (ifail != OK)
                     {
@@ -4084,7 +4367,7 @@ static int str_len_val_op( int* bad_count)
                     }
                     else
                     {
-                        work_done = true;
+                        *work_done = true;
                     }
                 }
                 else
@@ -4115,7 +4398,7 @@ static int str_len_val_op( int* bad_count)
                 {
                     // No validate the stored string sizes with the data's actual length. 
                     // If -commit was specified on the command line then update the stored string sizes.
-                    ifail = validate_sa_long_string_sizes(tar_class.c_str(), tar_attribute.c_str(), att_tbl, att_col, puids, pseqs, calc_sizes, bad_count);
+                    ifail = validate_sa_long_string_sizes(cls, attr, att_tbl, att_col, puids, pseqs, calc_sizes, bad_count);
 
                     if (ifail != OK)
                     {
@@ -4125,7 +4408,7 @@ static int str_len_val_op( int* bad_count)
                     }
                     else
                     {
-                        work_done = true;
+                        *work_done = true;
                     }
                 }
                 else
@@ -4163,7 +4446,7 @@ static int str_len_val_op( int* bad_count)
                 if (op_fail == OK && puids.size() > 0)
                 {
                     // Now validate the strings sizes of POM_string_attributes
-                    ifail = validate_string_sizes("Str", tar_class.c_str(), tar_attribute.c_str(), cls_tbl, cls_col, tar_slen, puids, calc_sizes, bad_count);
+                    ifail = validate_string_sizes("Str", cls, attr, cls_tbl, cls_col, tar_slen, puids, calc_sizes, bad_count);
 
                     if (ifail != OK)
                     {
@@ -4173,7 +4456,7 @@ static int str_len_val_op( int* bad_count)
                     }
                     else
                     {
-                        work_done = true;
+                        *work_done = true;
                     }
                 }
                 else
@@ -4203,7 +4486,7 @@ static int str_len_val_op( int* bad_count)
                 if (op_fail == OK && puids.size() > 0)
                 {
                     // Now validate the strings sizes of POM_string_attributes
-                    ifail = validate_vla_string_sizes("Str(VLA)", tar_class.c_str(), tar_attribute.c_str(), att_tbl, att_col, tar_slen, puids, pseqs, calc_sizes, bad_count);
+                    ifail = validate_vla_string_sizes("Str(VLA)", cls, attr, att_tbl, att_col, tar_slen, puids, pseqs, calc_sizes, bad_count);
 
                     if (ifail != OK)
                     {
@@ -4213,7 +4496,7 @@ static int str_len_val_op( int* bad_count)
                     }
                     else
                     {
-                        work_done = true;
+                        *work_done = true;
                     }
                 }
                 else
@@ -4243,7 +4526,7 @@ static int str_len_val_op( int* bad_count)
                 if (op_fail == OK && puids.size() > 0)
                 {
                     // Now validate the strings sizes of POM_string_attributes
-                    ifail = validate_la_string_sizes(tar_class.c_str(), tar_attribute.c_str(), att_tbl, att_col, tar_slen, puids, pseqs, calc_sizes, bad_count);
+                    ifail = validate_la_string_sizes(cls, attr, att_tbl, att_col, tar_slen, puids, pseqs, calc_sizes, bad_count);
 
                     if (ifail != OK)
                     {
@@ -4253,7 +4536,7 @@ static int str_len_val_op( int* bad_count)
                     }
                     else
                     {
-                        work_done = true;
+                        *work_done = true;
                     }
                 }
                 else
@@ -4296,7 +4579,7 @@ static int str_len_val_op( int* bad_count)
                     if (op_fail == OK && puids.size() > 0)
                     {
                         // Now validate the strings sizes of POM_string_attributes
-                        ifail = validate_string_sizes(func, tar_class.c_str(), tar_attribute.c_str(), cls_tbl, col_name, tar_slen, puids, calc_sizes, bad_count);
+                        ifail = validate_string_sizes(func, cls, attr, cls_tbl, col_name, tar_slen, puids, calc_sizes, bad_count);
 
                         if (ifail != OK)
                         {
@@ -4306,7 +4589,7 @@ static int str_len_val_op( int* bad_count)
                         }
                         else
                         {
-                            work_done = true;
+                            *work_done = true;
                         }
                     }
                     else
@@ -4357,30 +4640,296 @@ static int str_len_val_op( int* bad_count)
     SM_free((void*)att_tbl);
     SM_free((void*)att_col);
 
-    // Commit the work only if it was successful and the user said to commit on the command line.
-    if ((op_fail == OK) && args->commit_flag && work_done)
-    {
-        COMMIT_WORKING_TX(str_len_val_tx, "str_len_val_tx");
-    }
-    else
-    {
-        ROLLBACK_WORKING_TX(str_len_val_tx, "str_len_val_tx");
-    }
-
     return(op_fail);
 }
 
-static int str_len_meta_op()
+
+/*------------------------------------------------------------------------
+** -str_len_val -all: validates every POM_string and POM_long_string attribute.
+** The attributes are read from the metadata with one query and grouped by the
+** physical table that holds their data. The POM_string columns of a class table
+** (scalars and small arrays) are sized together by get_table_string_sizes(), so
+** the table is read once for up to SLV_ALL_COLS_PER_STMT columns, on the
+** client-side platforms as well. Attributes that
+** have their own table (VLA, large array and long strings) go through
+** str_len_val_attr(). Each table is processed in its own working transaction.
+** ----------------------------------------------------------------------- */
+static const int SLV_ALL_COLS_PER_STMT = 100;  // Maximum number of class-table string columns sized by one statement.
+static const int SLV_TABLE_PAGE_ROWS = 10000;   // Rows read per page, in puid order, by get_table_string_sizes().
+
+typedef struct slv_col_s
+{
+    std::string cls;        /**< Class that defines the attribute */
+    std::string attr;       /**< Attribute name */
+    std::string col;        /**< Class table column, with the _n suffix for small arrays */
+    std::string func;       /**< Status prefix - Str or Str(SA)n */
+    int         slen;       /**< Attribute maximum string length */
+} slv_col_t;
+
+typedef struct slv_att_s
+{
+    std::string cls;        /**< Class that defines the attribute */
+    std::string attr;       /**< Attribute name */
+    int         type;       /**< POM_string or POM_long_string */
+    int         slen;       /**< Attribute maximum string length */
+    int         arry;       /**< Attribute array size */
+} slv_att_t;
+
+typedef struct slv_tbl_s
+{
+    std::vector< slv_col_t > cols;   /**< POM_string columns stored on this class table, sized together */
+    std::vector< slv_att_t > atts;   /**< Attributes whose data is stored in this table */
+} slv_tbl_t;
+
+static int str_len_val_all(int* bad_count)
 {
     int op_fail = OK;
-    std::string tar_class;
+    int att_cnt = 0;
+    int skipped_cnt = 0;
+    int failed_cnt = 0;
+    std::map< std::string, slv_tbl_t > tables;
 
-    if (!args->class_flag)
-    {
-        std::stringstream msg;
-        msg << "The -str_len_meta options requires a class name (-c=name).";
-        op_fail = error_out(ERROR_line, POM_invalid_value, msg.str());
-    }
+    op_fail = database_tx_check();
+
+    if (op_fail != OK)
+    {
+        return(op_fail);
+    }
+
+    // One metadata query for every string and long-string attribute.
+    {
+        EIM_select_var_t vars[5];
+        EIM_value_p_t headers = NULL;
+        EIM_row_p_t report = NULL;
+
+        std::stringstream sql;
+        sql << "SELECT a.pname cname, b.pname aname, b.pptype, b.pmax_string_length, b.plength arry FROM PPOM_CLASS a, PPOM_ATTRIBUTE b";
+        sql << " WHERE b.rdefining_classu = a.puid AND b.pptype IN (" << DDS_string << ", " << DDS_long_string << ") ORDER BY a.pname, b.papid";
+
+        EIM_select_col(&(vars[0]), EIM_varchar, "cname", 34, false);
+        EIM_select_col(&(vars[1]), EIM_varchar, "aname", 34, false);
+        EIM_select_col(&(vars[2]), EIM_integer, "pptype", sizeof(int), false);
+        EIM_select_col(&(vars[3]), EIM_integer, "pmax_string_length", sizeof(int), false);
+        EIM_select_col(&(vars[4]), EIM_integer, "arry", sizeof(int), false);
+
+        EIM_exec_sql_bind(sql.str().c_str(), &headers, &report, 0, 5, vars, 0, NULL);
+        EIM_check_error("Retrieving string attribute meta\n");
+
+        for (EIM_row_p_t row = report; row != NULL; row = row->next)
+        {
+            char* cname = NULL;
+            char* aname = NULL;
+            int*  pptype = NULL;
+            int*  max_len = NULL;
+            int*  arry = NULL;
+
+            EIM_find_value(headers, row->line, "cname", EIM_varchar, &cname);
+            EIM_find_value(headers, row->line, "aname", EIM_varchar, &aname);
+            EIM_find_value(headers, row->line, "pptype", EIM_integer, &pptype);
+            EIM_find_value(headers, row->line, "pmax_string_length", EIM_integer, &max_len);
+            EIM_find_value(headers, row->line, "arry", EIM_integer, &arry);
+
+            if (cname == NULL || aname == NULL || pptype == NULL || arry == NULL)
+            {
+                skipped_cnt++;
+                continue;
+            }
+
+            const char* cls_tbl = NULL;
+            const char* cls_col = NULL;
+            const char* att_tbl = NULL;
+            const char* att_col = NULL;
+
+            // Transient, class variable and non-stored attributes are rejected here.
+            if (get_tables_and_columns(cname, aname, &cls_tbl, &cls_col, &att_tbl, &att_col) != OK)
+            {
+                skipped_cnt++;
+                continue;
+            }
+
+            int type = (*pptype == DDS_long_string ? POM_long_string : POM_string);
+            int slen = (max_len != NULL ? *max_len : 0);
+            att_cnt++;
+
+            if (type == POM_string && *arry >= 1 && *arry <= 6)
+            {
+                slv_tbl_t& tbl = tables[cls_tbl];
+
+                for (int i = 0; i < *arry; i++)
+                {
+                    slv_col_t col;
+                    col.cls = cname;
+                    col.attr = aname;
+                    col.slen = slen;
+
+                    if (*arry == 1)
+                    {
+                        col.col = cls_col;
+                        col.func = "Str";
+                    }
+                    else
+                    {
+                        std::stringstream name;
+                        name << cls_col << "_" << i;
+                        col.col = name.str();
+
+                        std::stringstream func;
+                        func << "Str(SA)" << i;
+                        col.func = func.str();
+                    }
+
+                    tbl.cols.push_back(col);
+                }
+            }
+            else
+            {
+                slv_att_t att;
+                att.cls = cname;
+                att.attr = aname;
+                att.type = type;
+                att.slen = slen;
+                att.arry = *arry;
+
+                tables[(att_tbl != NULL ? att_tbl : cls_tbl)].atts.push_back(att);
+            }
+
+            SM_free((void*)cls_tbl);
+            SM_free((void*)cls_col);
+            SM_free((void*)att_tbl);
+            SM_free((void*)att_col);
+        }
+
+        EIM_free_result(headers, report);
+    }
+
+    {
+        std::stringstream msg;
+        msg << "\nString attributes to validate = " << att_cnt << " in " << tables.size() << " tables";
+
+        if (skipped_cnt > 0)
+        {
+            msg << " (" << skipped_cnt << " attributes are not stored and were skipped)";
+        }
+        cons_out(msg.str());
+    }
+
+    int tbl_pos = 0;
+
+    for (std::map< std::string, slv_tbl_t >::iterator it = tables.begin(); it != tables.end(); ++it)
+    {
+        slv_tbl_t& tbl = it->second;
+        tbl_pos++;
+
+        {
+            std::stringstream msg;
+            msg << "\nTable " << tbl_pos << " of " << tables.size() << ": " << it->first;
+
+            if (tbl.cols.size() > 0)
+            {
+                msg << " (" << tbl.cols.size() << " string columns)";
+            }
+            cons_out(msg.str());
+        }
+
+        logical work_done = FALSE;
+        int tbl_fail = OK;
+
+        START_WORKING_TX(slv_all_tx, "slv_all_tx");
+
+        ERROR_PROTECT
+
+        for (size_t first = 0; first < tbl.cols.size() && tbl_fail == OK; first += SLV_ALL_COLS_PER_STMT)
+        {
+            size_t cnt = tbl.cols.size() - first;
+
+            if (cnt > (size_t)SLV_ALL_COLS_PER_STMT)
+            {
+                cnt = SLV_ALL_COLS_PER_STMT;
+            }
+
+            std::vector< std::string > cols;
+            std::vector< int > slens;
+            std::vector< std::vector< std::string > > puids(cnt);
+            std::vector< std::vector< int > > calc_sizes(cnt);
+
+            for (size_t k = 0; k < cnt; k++)
+            {
+                cols.push_back(tbl.cols[first + k].col);
+                slens.push_back(tbl.cols[first + k].slen);
+            }
+
+            tbl_fail = get_table_string_sizes(it->first.c_str(), cols, slens, args->uid_vec, puids, calc_sizes);
+
+            for (size_t k = 0; k < cnt && tbl_fail == OK; k++)
+            {
+                if (puids[k].size() > 0)
+                {
+                    slv_col_t& col = tbl.cols[first + k];
+                    tbl_fail = validate_string_sizes(col.func.c_str(), col.cls.c_str(), col.attr.c_str(), it->first.c_str(), col.col.c_str(), col.slen, puids[k], calc_sizes[k], bad_count);
+                    work_done = true;
+                }
+            }
+        }
+
+        for (size_t k = 0; k < tbl.atts.size() && tbl_fail == OK; k++)
+        {
+            slv_att_t& att = tbl.atts[k];
+            tbl_fail = str_len_val_attr(att.cls.c_str(), att.attr.c_str(), att.type, att.slen, att.arry, NULL, bad_count, &work_done);
+        }
+
+        ERROR_RECOVER
+
+        tbl_fail = ERROR_ask_failure_code();
+
+        ERROR_END
+
+        if ((tbl_fail == OK) && args->commit_flag && work_done)
+        {
+            COMMIT_WORKING_TX(slv_all_tx, "slv_all_tx");
+        }
+        else
+        {
+            ROLLBACK_WORKING_TX(slv_all_tx, "slv_all_tx");
+        }
+
+        if (tbl_fail != OK)
+        {
+            failed_cnt++;
+
+            if (op_fail == OK)
+            {
+                op_fail = tbl_fail;
+            }
+
+            std::stringstream msg;
+            msg << "ERROR: " << it->first << " could not be validated (" << tbl_fail << "), continuing with the next table";
+            cons_out(msg.str());
+        }
+    }
+
+    {
+        std::stringstream msg;
+        msg << "\nTables processed         = " << tables.size();
+        msg << "\nTables failed            = " << failed_cnt;
+        msg << "\nString attributes        = " << att_cnt;
+        msg << "\nTotal eligible records   = " << *bad_count;
+        cons_out(msg.str());
+    }
+
+    return(op_fail);
+}
+
+static int str_len_meta_op()
+{
+    int op_fail = OK;
+    std::string tar_class;
+
+    if (!args->class_flag)
+    {
+        std::stringstream msg;
+        msg << "The -str_len_meta options requires a class name (-c=name).";
+        op_fail = error_out(ERROR_line, POM_invalid_value, msg.str());
+    }
 
     const char *superclass = NULL;
 
@@ -4435,6 +4984,12 @@ static logical compare_object_to_bp( const std::string from_uid, const std::stri
 /* *************************************** */
 /* VLA scanning functionality starts here. */
 /* *************************************** */
+static const int VLA_REPAIR_CHUNK_SIZE = 1000;      // -commit: default objects repaired per working transaction (see -chunk=).
+static int vla_repaired_cnt = 0;                    // -commit: VLAs repaired by repair_vlas().
+static int vla_refs_lost_cnt = 0;                   // -commit: VLA entries dropped by lowering MISSING_ROWS counts.
+static int vla_tables_total = 0;                    // VLA tables to be scanned by this run.
+static int vla_tables_scanned = 0;                  // VLA tables scanned so far.
+
 static int scan_vla_op( int *found_count )
 {
     int ifail = OK;
@@ -4442,19 +4997,6 @@ static int scan_vla_op( int *found_count )
     // Validate input paramters.
     ifail = validate_cmd_line_class_and_attribute_params( );
 
-    if ( args->uid_flag )
-    {
-        std::vector< std::string >* uid_vec_lcl = args->uid_vec;
-        int uid_cnt = (*uid_vec_lcl).size( );
-
-        if ( uid_cnt > 100 )
-        {
-            ifail = POM_invalid_value;
-            std::stringstream msg;
-            msg << "\nError " << ifail << " A maximum of 100 UIDs can be specified.";
-            cons_out( msg.str() );
-        }
-    }
     if ( ifail != OK )
     {
         return ifail;
@@ -4474,6 +5016,48 @@ static int scan_vla_op( int *found_count )
         dumpRefMetadata( meta );
     }
 
+    vla_tables_total = count_vla_tables( hier, meta );
+    vla_tables_scanned = 0;
+    std::string saved_workers;
+
+    {
+        std::stringstream msg;
+        msg << "\nVLA tables to scan = " << vla_tables_total;
+
+        if ( args->threads > 0 && !args->noparallel_flag )
+        {
+            msg << ", " << args->threads << " parallel workers per table";
+
+            // Postgres has no statement hint, the degree of parallelism is a session setting.
+            // The current value is saved so that it can be put back after the scan.
+            if ( EIM_dbplat() == EIM_dbplat_postgres )
+            {
+                EIM_select_var_t vars[1];
+                EIM_value_p_t headers = NULL;
+                EIM_row_p_t report = NULL;
+
+                EIM_select_col( &( vars[0] ), EIM_varchar, "val", 64, false );
+                EIM_exec_sql_bind( "SELECT current_setting('max_parallel_workers_per_gather') AS val", &headers, &report, 0, 1, vars, 0, NULL );
+                EIM_check_error( "scan_vla_op()\n" );
+
+                char* val = NULL;
+
+                if ( report != NULL )
+                {
+                    EIM_find_value( headers, report->line, "val", EIM_varchar, &val );
+                }
+                saved_workers = ( val != NULL ? val : "" );
+                EIM_free_result( headers, report );
+
+                std::stringstream sql;
+                sql << "SET max_parallel_workers_per_gather = " << args->threads;
+                EIM_exec_imm( sql.str().c_str(), "scan_vla_op(): setting max_parallel_workers_per_gather" );
+                EIM_check_error( "scan_vla_op()\n" );
+            }
+        }
+        cons_out( msg.str() );
+    }
+
     int vla_cnt = 0;
     int class_cnt = meta.size();
     int att_processed = 0;
@@ -4510,6 +5094,14 @@ static int scan_vla_op( int *found_count )
         }
     }
 
+    if ( !saved_workers.empty() )
+    {
+        std::stringstream sql;
+        sql << "SET max_parallel_workers_per_gather = " << saved_workers;
+        EIM_exec_imm( sql.str().c_str(), "scan_vla_op(): restoring max_parallel_workers_per_gather" );
+        EIM_check_error( "scan_vla_op()\n" );
+    }
+
     if ( last_class != NULL && last_att != NULL )
     {
         std::stringstream msg;
@@ -4523,6 +5115,12 @@ static int scan_vla_op( int *found_count )
     msg << "\nNormal VLA attributes processed    = " << att_processed;
     msg << "\nFlattened VLA attributes processed = " << flat_att_processed;
     msg << "\nTotal inconsistent VLAs found      = " << vla_cnt;      
+
+    if ( args->commit_flag )
+    {
+        msg << "\nTotal inconsistent VLAs repaired   = " << vla_repaired_cnt;
+        msg << "\nMissing VLA entries dropped        = " << vla_refs_lost_cnt << ( vla_refs_lost_cnt > 0 ? " (see syslog for each object)" : "" );
+    }
     cons_out( msg.str() );
 
     return ( ifail );
@@ -4532,6 +5130,25 @@ static int scan_vla_op( int *found_count )
 #define VSR_DATA_LINE '.'
 #define VSR_INFO_LINE '+'
 
+/* -scan_vla inconsistency categories, in the order they are tested. */
+#define VLA_CAT_MISSING_ROWS 1      /* count column is greater than the number of VLA rows */
+#define VLA_CAT_EXTRA_ROWS   2      /* count column is less than the number of VLA rows */
+#define VLA_CAT_SEQ_RANGE    3      /* sequence values do not run from 0 to count - 1 */
+#define VLA_CAT_SEQ_DUP      4      /* sequence values are within range but duplicated */
+
+/*-----------------------------------------------------------------*/
+static const char* get_vla_cat_name( int vla_cat )
+{
+    switch ( vla_cat )
+    {
+    case VLA_CAT_MISSING_ROWS: return "MISSING_ROWS";
+    case VLA_CAT_EXTRA_ROWS:   return "EXTRA_ROWS";
+    case VLA_CAT_SEQ_RANGE:    return "SEQ_RANGE";
+    case VLA_CAT_SEQ_DUP:      return "SEQ_DUP";
+    default:                   return "UNKNOWN";
+    }
+}
+
 /*-----------------------------------------------------------------*/
 static void output_scan_vla_err( const cls_t* cls, const cls_t* flat, const att_t* att, int ifail, const char* msg )
 {
@@ -4609,12 +5226,28 @@ static void output_scan_vla_attr_hdr( const char prefix, const cls_t* cls, const
     {
         if ( uid_cnt >= 0 )
         {
-            msg << att->uid_cnt << " inconsistent VLAs found";
+            int cat_cnts[VLA_CAT_SEQ_DUP + 1] = { 0 };
+
+            for ( int i = 0; i < att->uid_cnt; i++ )
+            {
+                if ( att->uids[i].vla_cat > 0 && att->uids[i].vla_cat <= VLA_CAT_SEQ_DUP )
+                {
+                    cat_cnts[att->uids[i].vla_cat]++;
+                }
+            }
+
+            msg << att->uid_cnt << " inconsistent VLAs found (";
+
+            for ( int cat = VLA_CAT_MISSING_ROWS; cat <= VLA_CAT_SEQ_DUP; cat++ )
+            {
+                msg << ( cat > VLA_CAT_MISSING_ROWS ? ", " : "" ) << get_vla_cat_name( cat ) << " = " << cat_cnts[cat];
+            }
+            msg << ")";
         }
 
         if ( !args->min_flag )
         {
-            msg << "\n" << VSR_HDR_LINE << "  uid,class-cnt,sequence";
+            msg << "\n" << VSR_HDR_LINE << "  uid,class-cnt,sequence,category";
         }
     }
 
@@ -4715,6 +5348,7 @@ static void output_scan_vla_details( const char prefix, const cls_t* cls, const
                     // Get the sequence values
                     int first_valid = -1;
                     int last_valid = -1;
+                    const char* sep = "";
 
                     for ( row = report; row != NULL; row = row->next )
                     {
@@ -4734,13 +5368,15 @@ static void output_scan_vla_details( const char prefix, const cls_t* cls, const
                             }
                             else if ( first_valid == last_valid )
                             {
-                                msg << first_valid << " ";
+                                msg << sep << first_valid;
+                                sep = " ";
                                 first_valid = *int_ptr;
                                 last_valid = *int_ptr;
                             }
                             else
                             {
-                                msg << first_valid << "-" << last_valid << " ";
+                                msg << sep << first_valid << "-" << last_valid;
+                                sep = " ";
                                 first_valid = *int_ptr;
                                 last_valid = *int_ptr;
                             }
@@ -4751,14 +5387,20 @@ static void output_scan_vla_details( const char prefix, const cls_t* cls, const
                     {
                         if ( first_valid == last_valid )
                         {
-                            msg << first_valid << " ";
+                            msg << sep << first_valid;
                         }
                         else
                         {
-                            msg << first_valid << "-" << last_valid << " ";
+                            msg << sep << first_valid << "-" << last_valid;
                         }
                     }
 
+                    // The category is only known for the attribute that was scanned, not its parallel VLAs.
+                    if ( prefix == VSR_DATA_LINE )
+                    {
+                        msg << "," << get_vla_cat_name( att->uids[i].vla_cat );
+                    }
+
                     cons_out( msg.str( ) );
                     first_valid = -1;
                     last_valid = -1;
@@ -4822,7 +5464,7 @@ static int get_inconsistent_vlas( cls_t* cls, const cls_t* flat, att_t* att )
 {
     int ifail = OK;
     logical trans_was_active = true;
-    EIM_select_var_t vars[1];
+    EIM_select_var_t vars[4];
     EIM_value_p_t headers = NULL;
     EIM_row_p_t report = NULL;
     EIM_row_p_t row;
@@ -4836,116 +5478,53 @@ static int get_inconsistent_vlas( cls_t* cls, const cls_t* flat, att_t* att )
         EIM_start_transaction();
     }
 
+    // The VLA table is aggregated once per puid and outer joined to the class table, so every
+    // inconsistency category is found by a single scan of each table.
+    std::string cnt_col = "t1." + get_vla_count_column( cls, att );
+    std::string seq_col = get_vla_seq_column( att );
+    char* uid_where = ( args->uid_flag ? create_uid_specific_where_clause( " AND t1.puid", args->uid_vec ) : NULL );
+    char* vla_uid_where = ( args->uid_flag ? create_uid_specific_where_clause( " WHERE puid", args->uid_vec ) : NULL );
+
     std::stringstream sql;
+    sql << "SELECT ";
 
-    switch ( EIM_dbplat() )
+    if ( args->threads > 0 && !args->noparallel_flag && EIM_dbplat() == EIM_dbplat_oracle )
     {
-    case EIM_dbplat_mssql:
-        sql << "SELECT puid FROM " << get_vla_class_table( cls, flat ) << " t1 WHERE t1." << get_vla_count_column( cls, att );
-        sql << " != (SELECT ISNULL(COUNT(t2.puid), 0) FROM " << get_vla_table( att ) << " t2 WHERE t1.puid = t2.puid)";
-        break;
-
-    case EIM_dbplat_oracle:
-        sql << "SELECT puid FROM " << get_vla_class_table( cls, flat ) << " t1 WHERE t1." << get_vla_count_column( cls, att );
-        sql << " != (SELECT NVL(COUNT(t2.puid), 0) FROM " << get_vla_table( att ) << " t2 WHERE t1.puid = t2.puid)";
-        break;
-
-    case EIM_dbplat_postgres:
-        sql << "SELECT puid FROM " << get_vla_class_table( cls, flat ) << " t1 WHERE t1." << get_vla_count_column( cls, att );
-        sql << " != (SELECT COUNT(t2.puid) FROM " << get_vla_table( att ) << " t2 WHERE t1.puid = t2.puid)";
-        break;
-
-    default:
-        ERROR_raise( ERROR_line, POM_internal_error, "Unsupported database platform." );
-        break;
+        sql << "/*+ parallel(" << args->threads << ") */ ";
     }
 
-    if ( args->uid_flag )
-    {
-        std::vector< std::string >* uid_vec_lcl = args->uid_vec;
-        int uid_cnt = (*uid_vec_lcl).size( );
-
-        if ( uid_cnt == 1 )
-        {
-            sql << " AND t1.puid = '" << (*uid_vec_lcl)[0] << "'";
-        }
-        else if ( uid_cnt > 1 )
-        {
-            for ( int i = 0; i < uid_cnt; i++ )
-            {
-                if ( i == 0 )
-                {
-                    sql << " AND t1.puid IN (";
-                }
-                else
-                {
-                    sql << ",";
-                }
+    sql << "t1.puid, CASE";
+    sql << " WHEN " << cnt_col << " > COALESCE(t2.row_cnt, 0) THEN " << VLA_CAT_MISSING_ROWS;
+    sql << " WHEN " << cnt_col << " < t2.row_cnt THEN " << VLA_CAT_EXTRA_ROWS;
+    sql << " WHEN t2.min_seq <> 0 OR t2.max_seq <> t2.row_cnt - 1 THEN " << VLA_CAT_SEQ_RANGE;
+    sql << " ELSE " << VLA_CAT_SEQ_DUP << " END AS cat, " << cnt_col << " AS cls_cnt, COALESCE(t2.row_cnt, 0) AS row_cnt";
+    sql << " FROM " << get_vla_class_table( cls, flat ) << " t1 LEFT OUTER JOIN";
+    sql << " (SELECT puid, COUNT(*) AS row_cnt, COUNT(DISTINCT " << seq_col << ") AS distinct_cnt, MIN(" << seq_col << ") AS min_seq, MAX(" << seq_col << ") AS max_seq";
+    sql << " FROM " << get_vla_table( att ) << ( vla_uid_where != NULL ? vla_uid_where : "" ) << " GROUP BY puid) t2 ON t1.puid = t2.puid";
+    sql << " WHERE (" << cnt_col << " <> COALESCE(t2.row_cnt, 0) OR (" << cnt_col << " > 0 AND (t2.min_seq <> 0 OR t2.max_seq <> t2.row_cnt - 1";
+    sql << " OR t2.distinct_cnt <> t2.row_cnt)))";
 
-                sql << "'" << (*uid_vec_lcl)[i] << "'";
-            }
-            sql << ")";
-        }
+    if ( uid_where != NULL )
+    {
+        sql << uid_where;
+        SM_free( uid_where );
     }
 
-    switch ( EIM_dbplat( ) )
+    if ( args->threads > 0 && !args->noparallel_flag && EIM_dbplat() == EIM_dbplat_mssql )
     {
-    case EIM_dbplat_mssql:
-        sql << " UNION";
-        sql << " SELECT puid FROM " << get_vla_class_table( cls, flat ) << " t1 WHERE t1." << get_vla_count_column( cls, att );
-        sql << " > 0 AND (((CAST(" << get_vla_count_column( cls, att ) << " AS bigint))*(CAST(" << get_vla_count_column( cls, att ) << " AS bigint) - 1))/2) !=";
-        sql << " (SELECT ISNULL(SUM(CAST(t2." << get_vla_seq_column( att ) << " as bigint)), 0) FROM " << get_vla_table( att ) << " t2 WHERE t1.puid = t2.puid)";
-        break;
-
-    case EIM_dbplat_oracle:
-        sql << " UNION";
-        sql << " SELECT puid FROM " << get_vla_class_table( cls, flat ) << " t1 WHERE t1." << get_vla_count_column( cls, att );
-        sql << " > 0 AND ((" << get_vla_count_column( cls, att ) << " * (" << get_vla_count_column( cls, att ) << " - 1))/2) !=";
-        sql << " (SELECT NVL(SUM(t2." << get_vla_seq_column( att ) << "), 0) FROM " << get_vla_table( att ) << " t2 WHERE t1.puid = t2.puid)";
-        break;
-
-    case EIM_dbplat_postgres:
-        sql << " UNION";
-        sql << " SELECT puid FROM " << get_vla_class_table( cls, flat ) << " t1 WHERE t1." << get_vla_count_column( cls, att );
-        sql << " > 0 AND ((t1." << get_vla_count_column( cls, att ) << " * (t1." << get_vla_count_column( cls, att ) << " - 1))/2) !=";
-        sql << " (SELECT COALESCE(SUM(t2." << get_vla_seq_column( att ) << "), 0) FROM " << get_vla_table( att ) << " t2 WHERE t1.puid = t2.puid)";
-        break;
-
-    default:
-        ERROR_raise( ERROR_line, POM_internal_error, "Unsupported database platform." );
-        break;
+        sql << " OPTION (MAXDOP " << args->threads << ")";
     }
 
-    if ( args->uid_flag )
+    if ( vla_uid_where != NULL )
     {
-        std::vector< std::string >* uid_vec_lcl = args->uid_vec;
-        int uid_cnt = (*uid_vec_lcl).size( );
-
-        if ( uid_cnt == 1 )
-        {
-            sql << " AND t1.puid = '" << (*uid_vec_lcl)[0] << "'";
-        }
-        else if ( uid_cnt > 1 )
-        {
-            for ( int i = 0; i < uid_cnt; i++ )
-            {
-                if ( i == 0 )
-                {
-                    sql << " AND t1.puid IN (";
-                }
-                else
-                {
-                    sql << ",";
-                }
-
-                sql << "'" << (*uid_vec_lcl)[i] << "'";
-            }
-            sql << ")";
-        }
+        SM_free( vla_uid_where );
     }
 
     EIM_select_col( &( vars[0] ), EIM_varchar, "puid", MAX_UID_SIZE, false );
-    ifail = EIM_exec_sql_bind( sql.str().c_str(), &headers, &report, 0, 1, vars, 0, NULL );
+    EIM_select_col( &( vars[1] ), EIM_integer, "cat", sizeof( int ), false );
+    EIM_select_col( &( vars[2] ), EIM_integer, "cls_cnt", sizeof( int ), true );
+    EIM_select_col( &( vars[3] ), EIM_integer, "row_cnt", sizeof( int ), false );
+    ifail = EIM_exec_sql_bind( sql.str().c_str(), &headers, &report, 0, 4, vars, 0, NULL );
 
     if ( !args->ignore_errors_flag )
     {
@@ -4990,6 +5569,17 @@ static int get_inconsistent_vlas( cls_t* cls, const cls_t* flat, att_t* att )
             EIM_find_value( headers, row->line, "puid", EIM_varchar, &tmp );
             strncpy( alloc_uids[i].uid, tmp, MAX_UID_SIZE );
             alloc_uids[i].uid[MAX_UID_SIZE] = '\0';
+
+            int* cat = NULL;
+            EIM_find_value( headers, row->line, "cat", EIM_integer, &cat );
+            alloc_uids[i].vla_cat = *cat;
+
+            int* cnt = NULL;
+            EIM_find_value( headers, row->line, "cls_cnt", EIM_integer, &cnt );
+            alloc_uids[i].vla_cnt = ( cnt != NULL ? *cnt : 0 );
+
+            EIM_find_value( headers, row->line, "row_cnt", EIM_integer, &cnt );
+            alloc_uids[i].vla_rows = *cnt;
             i++;
         }
 
@@ -5031,9 +5621,145 @@ static int get_inconsistent_vlas( cls_t* cls, const cls_t* flat, att_t* att )
 }
 
 /*------------------------------------------------------------------------
-** Searches flattened VLA attributes for inconsistent VLAs.
+** -commit: Repairs the inconsistent VLAs found by get_inconsistent_vlas().
+** The rows of each object are renumbered 0..n-1 in sequence order with
+** ROW_NUMBER() and the count column is set to the real number of rows.
+** The objects are repaired VLA_REPAIR_CHUNK_SIZE (or -chunk=) at a time,
+** each chunk in its own working transaction. Lowering the count of a
+** MISSING_ROWS object drops the entries that had no row, each such object
+** is logged to the syslog with the number of entries lost.
 ** ----------------------------------------------------------------------- */
-static int output_flattened_vlas( const std::vector<hier_t>& hier, std::vector<cls_t>& meta, cls_t* flat, int* accum_cnt, int* attr_cnt )
+static int repair_vlas( cls_t* cls, const cls_t* flat, att_t* att, int* repaired )
+{
+    int ifail = OK;
+    int chunk_size = ( args->chunk_size > 0 ? args->chunk_size : VLA_REPAIR_CHUNK_SIZE );
+    std::string cls_tbl = get_vla_class_table( cls, flat );
+    std::string vla_tbl = get_vla_table( att );
+    std::string cnt_col = get_vla_count_column( cls, att );
+    std::string seq_col = get_vla_seq_column( att );
+    std::stringstream number_sql;
+    std::stringstream count_sql;
+    *repaired = 0;
+
+    // The rows are first numbered -1..-n and then flipped to 0..n-1, so that no intermediate
+    // value collides with a sequence value that has not been renumbered yet.
+    switch ( EIM_dbplat() )
+    {
+    case EIM_dbplat_oracle:
+        number_sql << "MERGE INTO " << vla_tbl << " t USING (SELECT rowid AS rid, ROW_NUMBER() OVER (ORDER BY " << seq_col << ") AS rn FROM " << vla_tbl;
+        number_sql << " WHERE puid = :1) s ON (t.rowid = s.rid) WHEN MATCHED THEN UPDATE SET t." << seq_col << " = -s.rn";
+        count_sql << "UPDATE " << cls_tbl << " t1 SET t1." << cnt_col << " = (SELECT COUNT(*) FROM " << vla_tbl << " t2 WHERE t2.puid = t1.puid) WHERE t1.puid = :1";
+        break;
+
+    case EIM_dbplat_mssql:
+        number_sql << "UPDATE s SET " << seq_col << " = -s.rn FROM (SELECT " << seq_col << ", ROW_NUMBER() OVER (ORDER BY " << seq_col << ") AS rn FROM " << vla_tbl;
+        number_sql << " WHERE puid = :1) s";
+        count_sql << "UPDATE t1 SET " << cnt_col << " = (SELECT COUNT(*) FROM " << vla_tbl << " t2 WHERE t2.puid = t1.puid) FROM " << cls_tbl << " t1 WHERE t1.puid = :1";
+        break;
+
+    case EIM_dbplat_postgres:
+        number_sql << "UPDATE " << vla_tbl << " t SET " << seq_col << " = -s.rn FROM (SELECT ctid AS rid, ROW_NUMBER() OVER (ORDER BY " << seq_col << ") AS rn FROM " << vla_tbl;
+        number_sql << " WHERE puid = :1) s WHERE t.ctid = s.rid";
+        count_sql << "UPDATE " << cls_tbl << " t1 SET " << cnt_col << " = (SELECT COUNT(*) FROM " << vla_tbl << " t2 WHERE t2.puid = t1.puid) WHERE t1.puid = :1";
+        break;
+
+    default:
+        ERROR_internal( ERROR_line, "Unrecognized EIM_dbplat value" );
+    }
+
+    char* flip_sql = SM_sprintf( "UPDATE %s SET %s = -%s - 1 WHERE puid = :1 AND %s < 0", vla_tbl.c_str(), seq_col.c_str(), seq_col.c_str(), seq_col.c_str() );
+    EIM_uid_t* keys = static_cast<EIM_uid_t*>( SM_alloc( sizeof( EIM_uid_t ) * ( chunk_size + 1 ) ) );
+
+    logical trans_was_active = EIM_is_transaction_active();
+
+    if ( trans_was_active )
+    {
+        EIM_commit_transaction( "" );
+    }
+
+    for ( int first = 0; first < att->uid_cnt && ifail == OK; first += chunk_size )
+    {
+        int key_cnt = ( att->uid_cnt - first < chunk_size ? att->uid_cnt - first : chunk_size );
+        int chunk_repaired = 0;
+
+        for ( int i = 0; i < key_cnt; i++ )
+        {
+            strcpy( keys[i], att->uids[first + i].uid );
+        }
+
+        START_WORKING_TX( vla_repair_tx, "vla_repair_tx" );
+
+        ERROR_PROTECT
+
+        exec_uid_array_dml( number_sql.str().c_str(), "repair_vlas() - numbering VLA rows", keys, key_cnt );
+        exec_uid_array_dml( flip_sql, "repair_vlas() - resequencing VLA rows", keys, key_cnt );
+        chunk_repaired = exec_uid_array_dml( count_sql.str().c_str(), "repair_vlas() - setting VLA counts", keys, key_cnt );
+
+        ERROR_RECOVER
+
+        if ( ifail == OK )
+        {
+            ifail = ERROR_ask_failure_code();
+
+            if ( !ifail )
+            {
+                ifail = POM_internal_error;
+            }
+        }
+        ERROR_END
+
+        if ( ifail )
+        {
+            ROLLBACK_WORKING_TX( vla_repair_tx, "vla_repair_tx" );
+            std::stringstream msg;
+            msg << "\nRepair of " << vla_tbl << " has been rolled back. (ifail=" << ifail << ") See syslog for details.";
+            msg << "\n" << *repaired << " VLAs of " << cls->name << ":" << att->name << " were repaired by previously committed chunks.";
+            cons_out( msg.str() );
+            break;
+        }
+
+        COMMIT_WORKING_TX( vla_repair_tx, "vla_repair_tx" );
+        *repaired += chunk_repaired;
+
+        for ( int i = first; i < first + key_cnt; i++ )
+        {
+            const ref_t* ref = &att->uids[i];
+
+            if ( ref->vla_cat == VLA_CAT_MISSING_ROWS )
+            {
+                vla_refs_lost_cnt += ref->vla_cnt - ref->vla_rows;
+                logger()->printf( "repair_vlas(): %s.%s of %s lowered from %d to %d, %d VLA entries lost\n",
+                                  cls_tbl.c_str(), cnt_col.c_str(), ref->uid, ref->vla_cnt, ref->vla_rows, ref->vla_cnt - ref->vla_rows );
+            }
+        }
+
+        if ( args->verbose_flag )
+        {
+            std::stringstream msg;
+            msg << "    Chunk committed: " << chunk_repaired << " VLAs repaired in " << vla_tbl;
+            cons_out( msg.str() );
+        }
+    }
+
+    if ( trans_was_active )
+    {
+        EIM_start_transaction();
+    }
+
+    SM_free( flip_sql );
+    SM_free( keys );
+
+    std::stringstream msg;
+    msg << *repaired << " of " << att->uid_cnt << " inconsistent VLAs repaired";
+    output_scan_vla_msg( cls, flat, att, msg.str().c_str() );
+
+    return ifail;
+}
+
+/*------------------------------------------------------------------------
+** Searches flattened VLA attributes for inconsistent VLAs.
+** ----------------------------------------------------------------------- */
+static int output_flattened_vlas( const std::vector<hier_t>& hier, std::vector<cls_t>& meta, cls_t* flat, int* accum_cnt, int* attr_cnt )
 {
     int ifail = OK;
 
@@ -5082,6 +5808,9 @@ static int output_flattened_vlas( const std::vector<hier_t>& hier, std::vector<c
                     {
                         ifail = lcl_ifail;
                     }
+
+                    // The table still counts towards the progress total.
+                    output_scan_vla_progress( *accum_cnt );
                     continue;
                 }
 
@@ -5098,6 +5827,18 @@ static int output_flattened_vlas( const std::vector<hier_t>& hier, std::vector<c
                         output_scan_vla_parallel_data( cur_cls, flat, &cur_cls->atts[j] );
                     }
 
+                    if ( args->commit_flag )
+                    {
+                        int repaired = 0;
+                        lcl_ifail = repair_vlas( cur_cls, flat, &cur_cls->atts[j], &repaired );
+                        vla_repaired_cnt += repaired;
+
+                        if ( ifail == OK )
+                        {
+                            ifail = lcl_ifail;
+                        }
+                    }
+
                     // Free up memory used to temporary hold UIDs.
                     SM_free( cur_cls->atts[j].uids );
                     cur_cls->atts[j].uids = NULL;
@@ -5107,6 +5848,8 @@ static int output_flattened_vlas( const std::vector<hier_t>& hier, std::vector<c
                 {
                     output_scan_vla_msg( cur_cls, flat, &cur_cls->atts[j], "0 inconsistent VLAs found" );
                 }
+
+                output_scan_vla_progress( *accum_cnt );
             }
         }
     }
@@ -5142,6 +5885,9 @@ static int output_vlas( cls_t* cls, int* accum_cnt, int* attr_cnt, char** last_a
             {
                 ifail = lcl_ifail;
             }
+
+            // The table still counts towards the progress total.
+            output_scan_vla_progress( *accum_cnt );
             continue;
         }
 
@@ -5158,6 +5904,18 @@ static int output_vlas( cls_t* cls, int* accum_cnt, int* attr_cnt, char** last_a
                 output_scan_vla_parallel_data( cls, NULL, &cls->atts[j] );
             }
 
+            if ( args->commit_flag )
+            {
+                int repaired = 0;
+                lcl_ifail = repair_vlas( cls, NULL, &cls->atts[j], &repaired );
+                vla_repaired_cnt += repaired;
+
+                if ( ifail == OK )
+                {
+                    ifail = lcl_ifail;
+                }
+            }
+
             // Free up memory used to temporary hold UIDs.
             SM_free( cls->atts[j].uids );
             cls->atts[j].uids = NULL;
@@ -5169,18 +5927,82 @@ static int output_vlas( cls_t* cls, int* accum_cnt, int* attr_cnt, char** last_a
         }
 
         ( *attr_cnt )++;
+        output_scan_vla_progress( *accum_cnt );
+    }
+
+    return ifail;
+}
+
+/*------------------------------------------------------------------------
+** Counts the VLA tables that output_vlas() and output_flattened_vlas()
+** will scan with the current -c= and -a= filters.
+** ----------------------------------------------------------------------- */
+static int count_vla_tables( const std::vector<hier_t>& hier, const std::vector<cls_t>& meta )
+{
+    int total = 0;
 
-        int remainder = ( *attr_cnt ) % 100;
+    for ( size_t i = 0; i < meta.size(); i++ )
+    {
+        const cls_t* cls = &meta[i];
 
-        if ( remainder == 0 )
+        if ( args->class_flag && strcmp( cls->name, args->class_n ) != 0 )
         {
-            std::stringstream msg;
-            msg << "Attributes processed = " << *attr_cnt << " of " << args->att_cnt << ". Inconsistent VLAs found = " << *accum_cnt;
-            cons_out( msg.str() );
+            continue;
+        }
+
+        for ( int j = 0; j < cls->att_cnt; j++ )
+        {
+            if ( !args->attribute_flag || strcmp( cls->atts[j].name, args->attribute ) == 0 )
+            {
+                total++;
+            }
+        }
+
+        if ( !isFlat( cls ) )
+        {
+            continue;
+        }
+
+        int par_cpid = hier[cls->cls_id].par_id;
+
+        while ( par_cpid > 0 && hier[par_cpid].cls_pos >= 0 )
+        {
+            const cls_t* cur_cls = &meta[hier[par_cpid].cls_pos];
+            par_cpid = hier[par_cpid].par_id;
+
+            for ( int j = 0; j < cur_cls->att_cnt; j++ )
+            {
+                if ( isVLA( &cur_cls->atts[j] ) && ( !args->attribute_flag || strcasecmp( cur_cls->atts[j].name, args->attribute ) == 0 ) )
+                {
+                    total++;
+                }
+            }
         }
     }
 
-    return ifail;
+    return total;
+}
+
+/*------------------------------------------------------------------------
+** Counts a scanned VLA table and reports the progress every 10 tables
+** (every table with -v) and when the last table has been scanned.
+** ----------------------------------------------------------------------- */
+static void output_scan_vla_progress( int accum_cnt )
+{
+    vla_tables_scanned++;
+
+    std::stringstream msg;
+    msg << "VLA tables scanned = " << vla_tables_scanned << " of " << vla_tables_total << " (" << ( vla_tables_total - vla_tables_scanned ) << " remaining)";
+    msg << ". Inconsistent VLAs found = " << accum_cnt;
+
+    if ( args->verbose_flag || vla_tables_scanned % 10 == 0 || vla_tables_scanned >= vla_tables_total )
+    {
+        cons_out( msg.str() );
+    }
+    else
+    {
+        logger()->printf( "%s\n", msg.str().c_str() );
+    }
 }
 
 /*-----------------------------------------------------------------*/
@@ -6636,6 +7458,113 @@ static int get_refs( cls_t *cls, const cls_t *flat, att_t *att )
     return( ifail );
 }
 
+/*------------------------------------------------------------------------
+** -out: Writes every object that references -uid= through the attribute
+** to the -out file. The query runs once into the staging table, which is
+** then read OUT_PAGE_ROWS rows at a time. att->uid_cnt is set to the number
+** of rows written, att->uids is not allocated.
+** ----------------------------------------------------------------------- */
+static int stream_refs( cls_t *cls, const cls_t *flat, att_t *att )
+{
+    int ifail = OK;
+    logical trans_was_active = true;
+
+    att->uids = NULL;
+    att->uid_cnt = 0;
+
+    ERROR_PROTECT
+    if( !EIM_is_transaction_active() )
+    {
+         trans_was_active = false;
+         EIM_start_transaction();
+    }
+
+    std::string ref_tbl = get_ref_table( cls, flat, att );
+
+    std::stringstream sel;
+    sel << "select ";
+
+    if( !args->noparallel_flag && EIM_dbplat() == EIM_dbplat_oracle )
+    {
+        sel << "/*+ parallel */ ";
+    }
+
+    if( isVLA( att ) || isLA( att ) )
+    {
+        sel << "distinct ";
+    }
+
+    sel << "puid from " << ref_tbl << " where (";
+
+    if( isSA( att ) )
+    {
+        sel << get_sa_where_clause( att );
+    }
+    else
+    {
+        sel << get_ref_col_where_expr( att, -1, args->uid );
+    }
+
+    sel << ")";
+
+    // Number the puids once into the staging table, then read it back a page at a time.
+    int staged = OUT_stage( "SELECT d.puid puid, 0 ref_cid, 0 tar_cid, 0 slot, 0 vcx FROM (" + sel.str() + ") d" );
+
+    std::string class_name = ( flat == NULL ? std::string( cls->name ) : std::string( flat->name ) + "\\" + cls->name );
+    std::string ref_col = get_ref_column( att, -1, true );
+    std::vector< ref_cpid_t > page;
+    int written = 0;
+
+    for( int rn = 0; rn < staged; rn += OUT_PAGE_ROWS )
+    {
+        OUT_fetch_page( rn, page );
+
+        for( const ref_cpid_t& ref : page )
+        {
+            OUT_printf( "%s,%s,%s,%s,%s\n", class_name.c_str(), att->name, ref_tbl.c_str(), ref_col.c_str(), ref.uid );
+        }
+
+        written += (int)page.size();
+    }
+
+    OUT_clear_stage();
+
+    att->uid_cnt = written;
+
+    if( flat == NULL )
+    {
+        cls->ref_cnt += written;
+    }
+    else
+    {
+        cls->flt_cnt += written;
+    }
+
+    if( !trans_was_active )
+    {
+        EIM_commit_transaction( "stream_refs()" );
+    }
+
+    ERROR_RECOVER
+    ifail = ERROR_ask_failure_code();
+
+    if( !trans_was_active )
+    {
+        EIM__clear_transaction( ifail );
+    }
+
+    if( !args->ignore_errors_flag )
+    {
+        const std::string msg("EXCEPTION: See syslog for additional details. (See -i option to ignore this error.)");
+        cons_out( msg );
+        ERROR_reraise();
+    }
+    EIM_clear_error();
+    ERROR_END
+
+    return( ifail );
+}
+
 /*------------------------------------------------------------------------
 ** Searches (non-flattened) reference attributes for objects (UIDs) that  
 ** reference the object (UID) specified on the command line (-uid=).
@@ -6652,7 +7581,7 @@ static int output_refs( cls_t *cls, int *accum_cnt, int *attr_cnt, char **last_a
 
         for( int j = 0; j < att_cnt && *accum_cnt <= args->max_ref_cnt; j++) 
         {
-            int lcl_ifail = get_refs( cls, NULL, &cls->atts[j] );
+            int lcl_ifail = ( args->out_file != NULL ? stream_refs( cls, NULL, &cls->atts[j] ) : get_refs( cls, NULL, &cls->atts[j] ) );
 
             if( lcl_ifail != OK )
             {
@@ -6667,7 +7596,15 @@ static int output_refs( cls_t *cls, int *accum_cnt, int *attr_cnt, char **last_a
 
             (*last_attr_name) = cls->atts[j].name;
                 
-            if( cls->atts[j].uid_cnt > 0 )
+            if( cls->atts[j].uid_cnt > 0 && args->out_file != NULL )
+            {
+                std::stringstream msg;
+                msg << cls->atts[j].uid_cnt << " references written to " << args->out_file;
+                output_att_msg( cls, NULL, &cls->atts[j], msg.str().c_str() );
+                *accum_cnt += cls->atts[j].uid_cnt;
+                cls->atts[j].uid_cnt = 0;
+            }
+            else if( cls->atts[j].uid_cnt > 0 )
             {
                 output_att_data( VSR_DATA_LINE, cls, NULL, &cls->atts[j] );
                 *accum_cnt += cls->atts[j].uid_cnt;
@@ -6735,7 +7672,7 @@ static int output_flattened_refs( const std::vector< hier_t > &hier, std::vector
                         continue;
                     }
 
-                    int lcl_ifail = get_refs( cur_cls, flat, &cur_cls->atts[j] );
+                    int lcl_ifail = ( args->out_file != NULL ? stream_refs( cur_cls, flat, &cur_cls->atts[j] ) : get_refs( cur_cls, flat, &cur_cls->atts[j] ) );
 
                     if( lcl_ifail != OK )
                     {
@@ -6750,7 +7687,15 @@ static int output_flattened_refs( const std::vector< hier_t > &hier, std::vector
 
                     ( *attr_cnt )++;
                 
-                    if( cur_cls->atts[j].uid_cnt > 0 )
+                    if( cur_cls->atts[j].uid_cnt > 0 && args->out_file != NULL )
+                    {
+                        std::stringstream msg;
+                        msg << cur_cls->atts[j].uid_cnt << " references written to " << args->out_file;
+                        output_att_msg( cur_cls, flat, &cur_cls->atts[j], msg.str().c_str() );
+                        *accum_cnt += cur_cls->atts[j].uid_cnt;
+                        cur_cls->atts[j].uid_cnt = 0;
+                    }
+                    else if( cur_cls->atts[j].uid_cnt > 0 )
                     {
                         output_att_data( VSR_DATA_LINE, cur_cls, flat, &cur_cls->atts[j] );
                         *accum_cnt += cur_cls->atts[j].uid_cnt;
@@ -7293,8 +8238,18 @@ static int getCmdLineArgs( int argc, char** argv, args_t *args )
         else if (strcmp(argv[i],"-keep_system_log") == 0) {args->keep_system_log     = TRUE;                                   }
         else if (strcmp(argv[i],"-keep_logs" )      == 0) {args->keep_system_log     = TRUE;                                   }
         else if (strcmp(argv[i],"-alt")             == 0) {args->alt                 = TRUE;                                   }  /* true = alternate processing I.e. to_uid instead of from_uid */
+        else if (strcmp(argv[i],"-both")            == 0) {args->both_flag           = TRUE;                                   }  /* true = process from_uids and to_uids in the same run */
+        else if (strcmp(argv[i],"-seq")             == 0) {args->seq_flag            = TRUE;                                   }  /* true = one statement per flattened class */
         else if (strcmp(argv[i],"-log_details")     == 0) {args->log_details         = TRUE;                                   }  /* true = log additional details and keep syslog */       
         else if (strncmp(argv[i],"-f=", 3)          == 0) {args->file_name           = argv[i] + 3;                            }  /* File name from command line.*/
+        else if (strncmp(argv[i],"-chunk=", 7)      == 0) {args->chunk_size = atoi(argv[i]+7);                                 }  /* Number of keys processed per working transaction. */
+        else if (strncmp(argv[i],"-rps=", 5)        == 0) {args->max_rows_per_sec = atoi(argv[i]+5);                           }  /* Maximum number of rows processed per second with -chunk=. */
+        else if (strcmp(argv[i],"-estimate")        == 0) {args->estimate_flag       = TRUE;                                   }  /* true = extrapolate counts from a block sample */
+        else if (strncmp(argv[i],"-sample=", 8)     == 0) {args->sample_pct = atof(argv[i]+8);                                 }  /* Percentage of blocks sampled with -estimate. (default = 1) */
+        else if (strncmp(argv[i],"-out=", 5)        == 0) {args->out_file = argv[i]+5;                                         }  /* CSV file that receives every matching row. */
+        else if (strncmp(argv[i],"-threads=", 9)    == 0) {args->threads = atoi(argv[i]+9);                                    }  /* Parallel workers per VLA table scan. */
+        else if (strncmp(argv[i],"-bench=", 7)      == 0) {args->bench = argv[i]+7;                                            }  /* Micro-benchmark to run. */
+        else if (strncmp(argv[i],"-resume=", 8)     == 0) {args->resume_line = atoi(argv[i]+8);                                }  /* -edit_array: CSV data lines to skip. */
         else                                              {args->not_supported_flag  = TRUE; args->not_supported = argv[i]+0;   ret = FAIL; }
 
         if (no_disp != NULL)
@@ -7314,6 +8269,33 @@ static int getCmdLineArgs( int argc, char** argv, args_t *args )
         args->max_ref_cnt = 100;
     }
 
+    // Negative chunk sizes and throttles are treated as "not specified".
+    if ( args->chunk_size < 0 )
+    {
+        args->chunk_size = 0;
+    }
+
+    if ( args->resume_line < 0 )
+    {
+        args->resume_line = 0;
+    }
+
+    if ( args->max_rows_per_sec < 0 )
+    {
+        args->max_rows_per_sec = 0;
+    }
+
+    if ( args->threads < 0 )
+    {
+        args->threads = 0;
+    }
+
+    // Block sampling accepts a percentage greater than 0 and less than 100, 100 reads the whole table.
+    if ( args->sample_pct <= 0.0 || args->sample_pct > 100.0 )
+    {
+        args->sample_pct = 1.0;
+    }
+
     logger()->printf("\n");
 
 #ifdef PRE_TC11_PLATFORM
@@ -7346,7 +8328,7 @@ static int isValidOptionArgument(const args_t& args)
 
     if( (args.user_flag          == FALSE) ||
         (args.group_flag         == FALSE) ||
-         ( args.uid_flag == FALSE && ( args.op != add_ref && args.op != remove_ref && args.op != validate_bp && args.op != correct_bp && args.op != check_ref && args.op != str_len_val 
+         ( args.uid_flag == FALSE && !( args.file_name != NULL && ( args.op == find_class || args.op == find_stub || args.op == where_ref ) ) && ( args.op != add_ref && args.op != remove_ref && args.op != validate_bp && args.op != correct_bp && args.op != check_ref && args.op != str_len_val 
              && args.op != str_len_meta && args.op != scan_vla && args.op != remove_unneeded_bp && args.op != validate_bp2 && args.op != edit_array && args.op != validate_cids ) ) ||
         (args.class_obj_flag     == TRUE && (args.class_flag == TRUE || args.attribute_flag == TRUE)) ||
         (args.not_supported_flag == TRUE)
@@ -7453,10 +8435,11 @@ static void dspUsage( const char* exe )
 
     msg << "\n";
     msg << "\n       " << exe << " -h (for detailed help)";
-    msg << "\n  OR   " << exe << " -find_ref     -u=user -p=pwd | -pf=pwdfile -g=group -uid=uid [-c=class] [-a=attribute] [-i] [-n] [-o=class] [-v] [-max=nnn]";
+    msg << "\n  OR   " << exe << " -find_ref     -u=user -p=pwd | -pf=pwdfile -g=group -uid=uid [-c=class] [-a=attribute] [-i] [-n] [-o=class] [-v] [-max=nnn | -out=file]";
     msg << "\n  OR   " << exe << " -find_ext_ref -u=user -p=pwd | -pf=pwdfile -g=group -uid=uid [-c=class] [-a=attribute] [-i] [-n] [-o=class] [-v] [-max=nnn]";
     msg << "\n  OR   " << exe << " -find_class   -u=user -p=pwd | -pf=pwdfile -g=group -uid=uid [-uid=uid [...]]] [-c=class]";
-    msg << "\n  OR   " << exe << " -find_stub    -u=user -p=pwd | -pf=pwdfile -g=group -uid=uid [-uid=uid [...]]]";
+    msg << "\n  OR   " << exe << " -find_class   -u=user -p=pwd | -pf=pwdfile -g=group -f=uid_file | -uid=uid [...] -out=file";
+    msg << "\n  OR   " << exe << " -find_stub    -u=user -p=pwd | -pf=pwdfile -g=group -uid=uid [-uid=uid [...]]] | -f=uid_file [-out=file]";
 
     if ( args->help > 0 )
     {
@@ -7470,17 +8453,18 @@ static void dspUsage( const char* exe )
     msg << "\n  OR   " << exe << " -add_ref      -u=user -p=pwd | -pf=pwdfile -g=group -from=class:attribute:uid[:pos] -to=class:uid [-commit]";
     msg << "\n  OR   " << exe << " -remove_ref   -u=user -p=pwd | -pf=pwdfile -g=group -from=class:attribute:uid[:pos] -to=class:uid [-null-ref] [-all] [-commit]";
     msg << "\n  OR   " << exe << " -validate_bp  -u=user -p=pwd | -pf=pwdfile -g=group -from=class:uid -to=class:uid";
-    msg << "\n  OR   " << exe << " -validate_bp2 -u=user -p=pwd | -pf=pwdfile -g=group [-c=class] [-log_details]";
+    msg << "\n  OR   " << exe << " -validate_bp2 -u=user -p=pwd | -pf=pwdfile -g=group [-c=class] [-log_details | -estimate [-sample=pct]]";
     msg << "\n  OR   " << exe << " -correct_bp   -u=user -p=pwd | -pf=pwdfile -g=group -from=class:uid -to=class:uid [-commit]";
     msg << "\n  OR   " << exe << " -delete_obj   -u=user -p=pwd | -pf=pwdfile -g=group [-c=class] -uid=uid [-uid=uid [-uid=uid [...]]] [-commit]";
-    msg << "\n  OR   " << exe << " -where_ref    -u=user -p=pwd | -pf=pwdfile -g=group -uid=uid";
-    msg << "\n  OR   " << exe << " -where_ref2   -u=user -p=pwd | -pf=pwdfile -g=group -uid=uid";
-    msg << "\n  OR   " << exe << " -str_len_val  -u=user -p=pwd | -pf=pwdfile -g=group -from=class:attribute [-uid=uid [-uid=uid [...]]] [-commit]";
+    msg << "\n  OR   " << exe << " -where_ref    -u=user -p=pwd | -pf=pwdfile -g=group -uid=uid [-uid=uid [...]] | -f=uid_file";
+    msg << "\n  OR   " << exe << " -where_ref2   -u=user -p=pwd | -pf=pwdfile -g=group -uid=uid [-uid=uid [...]] | -f=uid_file";
+    msg << "\n  OR   " << exe << " -str_len_val  -u=user -p=pwd | -pf=pwdfile -g=group -from=class:attribute [-uid=uid [-uid=uid [...]] | -f=uid_file] [-commit]";
+    msg << "\n  OR   " << exe << " -str_len_val  -u=user -p=pwd | -pf=pwdfile -g=group -all [-uid=uid [-uid=uid [...]] | -f=uid_file] [-commit] [-threads=n]";
     msg << "\n  OR   " << exe << " -str_len_meta -u=user -p=pwd | -pf=pwdfile -g=group -c=class";
-    msg << "\n  OR   " << exe << " -scan_vla     -u=user -p=pwd | -pf=pwdfile -g=group  [-c=class] [-a=attribute] [-uid=uid [-uid=uid [...]]] [-m]";
-    msg << "\n  OR   " << exe << " -remove_unneeded_bp -u=user -p=pwd | -pf=pwdfile -g=group [-v] [-commit] [-uid=uid [-uid=uid [...]]]";
-    msg << "\n  OR   " << exe << " -edit_array         -u=user -p=pwd | -pf=pwdfile -g=group -f=<csv_file> [-commit]";
-    msg << "\n  OR   " << exe << " -validate_cids      -u=user -p=pwd | -pf=pwdfile -g=group -vc=<validation_class_name> [-m] [-max=nnn]";
+    msg << "\n  OR   " << exe << " -scan_vla     -u=user -p=pwd | -pf=pwdfile -g=group  [-c=class] [-a=attribute] [-uid=uid [-uid=uid [...]] | -f=uid_file] [-m] [-commit [-chunk=nnn]] [-threads=n]";
+    msg << "\n  OR   " << exe << " -remove_unneeded_bp -u=user -p=pwd | -pf=pwdfile -g=group [-v] [-alt | -both] [-seq] [-estimate [-sample=pct] | -commit [-chunk=nnn [-rps=nnn]]] [-uid=uid [-uid=uid [...]] | -f=uid_file]";
+    msg << "\n  OR   " << exe << " -edit_array         -u=user -p=pwd | -pf=pwdfile -g=group -f=<csv_file> [-commit [-chunk=nnn [-out=reject_file]]] [-resume=nnn]";
+    msg << "\n  OR   " << exe << " -validate_cids      -u=user -p=pwd | -pf=pwdfile -g=group -vc=<validation_class_name> | -vc=ALL [-m] [-max=nnn | -out=file] [-commit [-chunk=nnn]]";
 
     if ( args->help > 0 )
     {
@@ -7494,6 +8478,7 @@ static void dspUsage( const char* exe )
         msg << "\n   -n         Remove parallel hint when querying reference attributes";
         msg << "\n   -v         Verbose output";
         msg << "\n   -max=      Maximum number of finds after which the utility terminates (default=100)";
+        msg << "\n   -out=      Writes every reference found to this CSV file (class,attribute,table,column,puid) - -max does not apply";
 
         msg << "\n";
         msg << "\n -find_ext_ref: search for external references to the specified UID (Max output is 101)";
@@ -7510,10 +8495,14 @@ static void dspUsage( const char* exe )
         msg << "\n -find_class: find the defining class for the specified UIDs";
         msg << "\n   -c=        First class to search, if not found then POM_object and all flattened classes are searched";
         msg << "\n   -uid=      UID to search for in reference attributes";
+        msg << "\n   -f=        File of UIDs to search for, one UID per line - with -out= the file is read a page at a time";
+        msg << "\n   -out=      Write one uid,class CSV line per UID to this file";
 
         msg << "\n";
         msg << "\n -find_stub: find the stub object that represents the specified UID";
         msg << "\n   -uid=      UID to search for in the POM_stub:object_uid attribute";
+        msg << "\n   -f=        File of UIDs to search for, one UID per line";
+        msg << "\n   -out=      Write one CSV line per stub to this file instead of the verbose console layout";
 
         msg << "\n";
         msg << "\n -load_obj: Test if the object can be loaded, read-locked, modify-locked and delete-locked";
@@ -7550,6 +8539,8 @@ static void dspUsage( const char* exe )
         msg << "\n                                        3) Missing backpointers 4) Unneeded backpointers";
         msg << "\n   -c=class_name    Class to be validated, by default all classes are validated which can take hours";
         msg << "\n   -log_details     Identifies every problem backpointer in the syslog (Search for BPV:)";
+        msg << "\n   -estimate        Validates a block sample of each class table and extrapolates the counts, with 95% bounds";
+        msg << "\n   -sample=pct      Percentage of table blocks sampled by -estimate (default = 1, 100 = whole table)";
 
         msg << "\n";
         msg << "\n -correct_bp: Adjusts the POM_BACKPOINTER entry to match actual object references";
@@ -7567,18 +8558,28 @@ static void dspUsage( const char* exe )
         msg << "\n";
         msg << "\n -where_ref:  Find the records (in POM_BACKPOINTER & PIMANRELATION) referencing the target UID";
         msg << "\n   -uid=uid   UID to seach for in POM_BACKPOINTER & PIMANRELATION tables";
+        msg << "\n   -f=file    File of UIDs to search for, one UID per line (-uid= may also be repeated)";
 
         msg << "\n";
         msg << "\n -where_ref2: Find the records (in all_backpointer_references view) referencing the target UID";
         msg << "\n   -uid=uid   UID to seach for in all_backpointer_references view";
+        msg << "\n   -f=file    File of UIDs to search for, one UID per line (-uid= may also be repeated)";
 
         msg << "\n";
         msg << "\n -str_len_val: Validate or correct string-data or string-lengths associated with POM_string and POM_long_string attributes";
         msg << "\n   -from=class:attribute String attribute for which its data or string length is validated or corrected.";
         msg << "\n   -commit               For POM_long_strings update the string length, for POM_strings truncate an appropriate amount of data";
         msg << "\n   -uid=UID              Object for which the attributes length is validated, or corrected when -commit is specified";
+        msg << "\n   -f=<file>             File of object UIDs, one per line, to be processed in place of -uid=";
+        msg << "\n   -all                  Validate every string and long-string attribute in place of -from=. The attributes are grouped";
+        msg << "\n                         by table, the string columns of a class table are read together, and each table is";
+        msg << "\n                         committed (with -commit) or rolled back on its own. A failing table does not stop the run.";
+        msg << "\n   -threads=n            With -all, degree of parallelism of the class table reads (Oracle parallel hint, MS SQL Server MAXDOP)";
         msg << "\n   Notes:     1. This option does NOT do object locking - do not use the \"-commit\" option with active users on the system.";
         msg << "\n              2. The -commit option can be used on an active system if a UID is specified for an object that will not load. (See -load_obj option)";
+        msg << "\n              3. On Postgres, and on Oracle configured for UTF-8, the strings are fetched and measured on the client.";
+        msg << "\n                 Data that is not well formed UTF-8 is reported as unknown, logged in the syslog, and never truncated.";
+        msg << "\n              4. -bench=utf8 (no other options) times the client-side UTF-8 kernel without connecting to the database.";
 
         msg << "\n";
         msg << "\n -str_len_meta: Display the reference_manager commands to validate attributes of a specified class and associated parent classes";
@@ -7589,21 +8590,46 @@ static void dspUsage( const char* exe )
         msg << "\n   -c=class     The class name containing the VLAs to be scanned";
         msg << "\n   -a=attribute The attribute name of the VLA to be scanned";
         msg << "\n   -uid=UID     The object UID of the VLAs to be scanned";
+        msg << "\n   -f=<file>    File of object UIDs, one per line, to be scanned in place of -uid=";
         msg << "\n   -m           Minimum functionality eliminates the output of parallel VLA data.";
+        msg << "\n                Each inconsistent VLA is reported with its category: MISSING_ROWS or EXTRA_ROWS (the class-table";
+        msg << "\n                count differs from the VLA rows), SEQ_RANGE (sequences not 0..count-1) or SEQ_DUP (duplicate sequences)";
+        msg << "\n   -commit      Repairs the inconsistent VLAs: renumbers the sequences 0..n-1 in their current order and sets";
+        msg << "\n                the class-table count to the number of VLA rows. Missing VLA entries are NOT restored";
+        msg << "\n   -chunk=      With -commit, the number of objects repaired per transaction (default=1000)";
+        msg << "\n   -threads=n   Scans each VLA table with n parallel database workers (Oracle parallel hint, SQL Server";
+        msg << "\n                MAXDOP, Postgres max_parallel_workers_per_gather). Ignored with -n";
 
         msg << "\n";
         msg << "\n -remove_unneeded_bp: Removes backpointers where the from_uid value does not exist in the local database";
         msg << "\n   -v           Dumps backpointers that will be removed to the console. They are always logged to the system log";
         msg << "\n   -commit      Actually removes unneeded backpointers";
         msg << "\n   -uid=UID     Limits processing to the specified UID";
+        msg << "\n   -f=<file>    Limits processing to the UIDs in the file, one per line";
         msg << "\n   -alt         Process to_uids rather than from_uids - use only if instructed to do so by Siemens support";
+        msg << "\n   -both        Process from_uids and to_uids in the same run, sharing the metadata and flattened class scans";
+        msg << "\n   -seq         Check flattened classes with one statement per class rather than combined statements (see syslog for timing)";
+        msg << "\n   -chunk=      With -commit, delete the backpointers of this many unneeded UIDs per transaction (default is one transaction)";
+        msg << "\n   -rps=        With -chunk=, limit deletion to this many backpointers per second (default is no limit)";
+        msg << "\n   -estimate    Runs the same checks over a block sample of POM_BACKPOINTER and extrapolates the count, nothing is removed";
+        msg << "\n   -sample=pct  Percentage of POM_BACKPOINTER blocks sampled by -estimate (default = 1, 100 = whole table)";
         msg << "\n   Notes:       1. Always keep the syslog so you have documentation as to what was done";
         msg << "\n                2. Do NOT run in parallel sessions at the same time";
         msg << "\n                3. MUST be run with exclusive use of the database when running with the -commit option and without any -uid option";
+        msg << "\n                4. Chunks that have been committed stay committed. If a chunked run is interrupted, run the same";
+        msg << "\n                   command again and only the remaining unneeded backpointers are identified and removed";
 
         msg << "\n";
         msg << "\n -edit_array: Edits one or more array attributes based on contents of the input CSV file";
         msg << "\n   -commit      Commits edits - default behavior is rollback array edits";
+        msg << "\n   -chunk=      With -commit, commit every nnn CSV data lines - lines that fail or are malformed are written to";
+        msg << "\n                the reject file and do not stop the run (default is one transaction that is rolled back on any";
+        msg << "\n                failure). Rejected lines count towards the nnn lines of a chunk";
+        msg << "\n   -out=        With -chunk=, the reject file (default=<csv_file>.reject), itself a valid -edit_array input file.";
+        msg << "\n                The last committed line is kept in <reject_file>.resume";
+        msg << "\n   -resume=     Skip this many CSV data lines, I.e. the last committed line of an interrupted -chunk= run.";
+        msg << "\n                The rejects of the resumed run are appended to the reject file";
+        msg << "\n   -cnt=        With -chunk=, the expected number of rejected lines, which then do not fail the run";
         msg << "\n   -f=<file>    CSV file that directs edits to array attributes - file must be formatted as follows";
         msg << "\n                Header:  action,class,uid,pos,<attr1>,<attr2>,...<attrn>";
         msg << "\n                Data:    <action>,<class>,<uid>,<pos>,<attr_data1>,<attr_data2>,...<attr_datan>";
@@ -7612,6 +8638,11 @@ static void dspUsage( const char* exe )
         msg << "\n                3. Supported array types: VLA (length = -1)";
         msg << "\n                4. Supported attribute types: POM_string, POM_int, POM_untyped_reference, POM_typed_reference";
         msg << "\n                5. Supported character sets: Single byte ASCII based and UTF-8";
+        msg << "\n                6. Lines are read as the file is processed and applied in windows of 100000 lines, grouped";
+        msg << "\n                   by class and object - all edits to an object within a window are saved together";
+        msg << "\n                7. There is no limit on the length of a line";
+        msg << "\n                8. -bench=csv (no other options) times the CSV reader over a generated 10M line file";
+        msg << "\n                   (about 800MB) written to TC_TMP_DIR, TEMP or TMPDIR and removed afterwards";
 
         msg << "\n";
         msg << "\n -validate_cids: Validates class-ID values within reference attributes - logs corrective UPDATE SQL";
@@ -7619,8 +8650,13 @@ static void dspUsage( const char* exe )
         msg << "\n   -vc=<class>  Validation class - used as the definitive source of object metadata. This must be POM_object";
         msg << "\n                or any flattened class. Running the utility without the -vc parameter will display a list of";
         msg << "\n                all acceptable classes. For complete coverage the utility must be run with all listed classes.";
+        msg << "\n   -vc=ALL      Validates against POM_object and all flattened classes in a single pass over the references";
         msg << "\n   -max=        Maximum number of finds after which the utility terminates (default=100)";
+        msg << "\n   -out=        Writes every bad class ID found to this CSV file instead of the console - -max does not apply";
+        msg << "\n                (table,uid_column,cid_column,puid,bad_cid,correct_cid,validation_class)";
         msg << "\n   -m           Minimum functionality - don't log corrective UPDATE statements to console";
+        msg << "\n   -commit      Corrects the class IDs of every attribute with a problem and reports before/after counts";
+        msg << "\n   -chunk=      With -commit, the number of class IDs corrected per transaction (default=10000)";
 
         msg << "\n";
         msg << "\n standard options:";
@@ -7641,6 +8677,9 @@ static void dspUsage( const char* exe )
         msg << "\n   -find_class:   Identifies the defining class by first searching the target class (-c option)";
         msg << "\n                  and then continuing to search the POM_object class and all flattened classes,";
         msg << "\n                  assuming the defining class has not been identified";
+        msg << "\n                  With -out=file the UIDs (typically millions, from a -f= file) are resolved";
+        msg << "\n                  in pages against POM_object and the flattened classes and uid,class rows";
+        msg << "\n                  are written to the file";
         msg << "\n   -check_ref:    Loads both the referenecing and referenced objects and also validates the contents of";
         msg << "\n                  the POM_BACKPOINTER table associated with references between the two objects";
         msg << "\n   -load_obj:     Attempts to load the specified UID, read-lock, modify-lock, delete-lock and unload the object";
@@ -8006,27 +9045,205 @@ static int get_flattened_class_names( std::vector< std::string > &flattened_clas
     return ret_val;
 }
 
-/* 
-Find the original strings which are not keys in the map. 
-The map is expected to contain the results from some operation (such as a query)
-that answers a request for a given input set (original_vec). This routine
-identifies the set of original strings that are not keys in the map.
+static const int FIND_CLASS_FLAT_CLASSES_PER_STMT = 100;   // Maximum number of flattened classes searched by one statement.
+
+/*
+Search every flattened class for the specified UIDs. The flattened class tables are
+combined with UNION ALL and joined to PPOM_CLASS for the class name, so one statement
+searches up to FIND_CLASS_FLAT_CLASSES_PER_STMT classes for all of the UIDs. More than
+one UID is matched against the staged UID set table. POM_object may be included in the
+list as its table has the same puid and ppid columns.
 */
-static int find_unresolved( std::vector< std::string > &original_vec, std::map< std::string, std::string > &result_map, std::vector< std::string > &unresolved_vec )
+static int query_flattened_classes_to_find_class_of_uids( std::vector< std::string > &uids, std::vector< std::string > &flattened_classes, std::map< std::string, std::string > &found_classes )
 {
     int ifail = POM_ok;
+    char* uid_where = create_uid_specific_where_clause( " WHERE t.puid", &uids );
 
-    std::map< std::string, std::string >::iterator it;
+    if( uid_where == NULL )
+    {
+        return ifail;
+    }
 
-    for( int i = 0; i < original_vec.size(); i++ )
+    for( int i = 0; i < flattened_classes.size() && ifail == POM_ok; i += FIND_CLASS_FLAT_CLASSES_PER_STMT )
     {
-        it = result_map.find( original_vec[i] );
+        std::stringstream sql;
+        sql << "SELECT x.puid puid, c.pname pname FROM (";
 
-        if( it == result_map.end() )
+        for( int j = i; j < flattened_classes.size() && j < i + FIND_CLASS_FLAT_CLASSES_PER_STMT; j++ )
         {
-            unresolved_vec.push_back( original_vec[i] );
-        }
-    }
+            const char* cls_tbl = NULL;
+            ifail = get_class_table_name( flattened_classes[j].c_str(), &cls_tbl );
+
+            if( ifail || !cls_tbl )
+            {
+                std::stringstream msg;
+                msg << "\nError " << ifail << " Unable to identify class table for class " << flattened_classes[j];
+                cons_out( msg.str() );
+                ifail = ( ifail ? ifail : POM_invalid_string );
+                break;
+            }
+
+            sql << ( j > i ? " UNION ALL " : "" ) << "SELECT t.puid puid, t.ppid ppid FROM " << cls_tbl << " t" << uid_where;
+            SM_free( (void*)cls_tbl );
+        }
+
+        if( ifail != POM_ok )
+        {
+            break;
+        }
+
+        sql << ") x, PPOM_CLASS c WHERE x.ppid = c.pcpid";
+
+        EIM_select_var_t vars[2];
+        EIM_value_p_t headers = NULL;
+        EIM_row_p_t report = NULL;
+        EIM_row_p_t row;
+
+        EIM_select_col( &(vars[0]), EIM_puid, "puid", EIM_uid_length + 1, false );
+        EIM_select_col( &(vars[1]), EIM_varchar, "pname", 35, false );
+        EIM_exec_sql_bind( sql.str().c_str(), &headers, &report, 0, 2, vars, 0, NULL );
+        EIM_check_error( "query_flattened_classes_to_find_class_of_uids" );
+
+        for( row = report; row != NULL; row = row->next )
+        {
+            char *puid = NULL;
+            char *pname = NULL;
+
+            EIM_find_value( headers, row->line, "puid", EIM_puid, &puid );
+            EIM_find_value( headers, row->line, "pname", EIM_varchar, &pname );
+
+            if( puid != NULL && pname != NULL )
+            {
+                found_classes[puid] = pname;
+            }
+        }
+
+        EIM_free_result( headers, report );
+    }
+
+    SM_free( uid_where );
+    return ifail;
+}
+
+static const int FIND_CLASS_BULK_PAGE_UIDS = 10000;   // UIDs staged and resolved per page in bulk mode.
+
+/*
+Bulk -find_class (-out=). The UIDs are read from the -f= file (or taken from -uid=) a page
+at a time, each page is array-inserted into the UID set table and resolved by joining it
+against POM_object and the flattened class tables in as few statements as possible. The
+uid,class rows are streamed to the -out file in input order, so neither the UID list nor
+the results are ever held in memory in full. The -c= class is not searched, every object
+is either in POM_object or in a flattened class table. found_count receives the number of
+UIDs whose class was found.
+*/
+static int find_class_bulk( int* found_count )
+{
+    int ifail = OK;
+    FILE* fp = NULL;
+    int line_no = 0;
+    long long uid_cnt = 0;
+    long long not_found_cnt = 0;
+    size_t vec_pos = 0;
+
+    if ( args->file_name != NULL )
+    {
+        fp = fnd_fopen( args->file_name, "r" );
+
+        if ( 0 == fp )
+        {
+            std::stringstream msg;
+            msg << "ERROR: Unable to open UID file " << args->file_name;
+            cons_out( msg.str() );
+            return POM_invalid_value;
+        }
+    }
+
+    std::vector< std::string > classes;
+    classes.push_back( "POM_object" );
+    ifail = get_flattened_class_names( classes );
+
+    if ( ifail == OK )
+    {
+        ifail = OUT_open( "uid,class" );
+    }
+
+    while ( ifail == OK )
+    {
+        std::vector< std::string > page;
+
+        if ( fp != NULL )
+        {
+            ifail = read_uid_file( fp, args->file_name, &line_no, FIND_CLASS_BULK_PAGE_UIDS, &page );
+        }
+        else
+        {
+            for ( ; vec_pos < args->uid_vec->size() && page.size() < FIND_CLASS_BULK_PAGE_UIDS; vec_pos++ )
+            {
+                page.push_back( (*args->uid_vec)[vec_pos] );
+            }
+        }
+
+        if ( ifail != OK || page.size() == 0 )
+        {
+            break;
+        }
+
+        std::map< std::string, std::string > found_classes;
+        ifail = query_flattened_classes_to_find_class_of_uids( page, classes, found_classes );
+
+        for ( int i = 0; i < page.size() && ifail == OK; i++ )
+        {
+            std::map< std::string, std::string >::const_iterator it = found_classes.find( page[i] );
+
+            if ( it == found_classes.end() )
+            {
+                not_found_cnt++;
+            }
+
+            OUT_printf( "%s,%s\n", page[i].c_str(), ( it != found_classes.end() ? it->second.c_str() : "<not found>" ) );
+        }
+
+        uid_cnt += page.size();
+    }
+
+    if ( fp != NULL )
+    {
+        fclose( fp );
+    }
+
+    int lcl_ifail = OUT_close();
+    ifail = ( ifail != OK ? ifail : lcl_ifail );
+
+    *found_count = (int)( uid_cnt - not_found_cnt );
+
+    std::stringstream msg;
+    msg << "\n" << uid_cnt << " UIDs processed, " << not_found_cnt << " not found";
+    cons_out( msg.str() );
+
+    return ifail;
+}
+
+/* 
+Find the original strings which are not keys in the map. 
+The map is expected to contain the results from some operation (such as a query)
+that answers a request for a given input set (original_vec). This routine
+identifies the set of original strings that are not keys in the map.
+*/
+static int find_unresolved( std::vector< std::string > &original_vec, std::map< std::string, std::string > &result_map, std::vector< std::string > &unresolved_vec )
+{
+    int ifail = POM_ok;
+
+    std::map< std::string, std::string >::iterator it;
+
+    for( int i = 0; i < original_vec.size(); i++ )
+    {
+        it = result_map.find( original_vec[i] );
+
+        if( it == result_map.end() )
+        {
+            unresolved_vec.push_back( original_vec[i] );
+        }
+    }
 
     return( ifail );
 }
@@ -9017,7 +10234,7 @@ static const void PrintErrors( const char *file, const int line, const char *met
 
 /* ********************************************************************************
 ** This sections contains routines for validating string lengths 
-** on MS SQL Server and Oracle, primarily with Teamcenter running in UTF-8 mode.
+** on MS SQL Server, Oracle and Postgres, primarily with Teamcenter running in UTF-8 mode.
 **
 ** START OF: str_len_val_op() routines.
 ** *******************************************************************************/
@@ -9035,7 +10252,7 @@ static const char* db_char_len_fun()
     }
     else if ( EIM_dbplat() == EIM_dbplat_postgres )
     {
-        ERROR_raise( ERROR_line, POM_op_not_supported, "Postgres is not currently supported with the -str_len_val option" );
+        ret = "LENGTH";
     }
     return ret;
 }
@@ -9054,7 +10271,7 @@ static const char* db_byte_len_fun()
     }
     else if ( EIM_dbplat() == EIM_dbplat_postgres )
     {
-        ERROR_raise( ERROR_line, POM_op_not_supported, "Postgres is not currently supported with the -str_len_val option" );
+        ERROR_raise( ERROR_line, POM_op_not_supported, "Postgres string sizes are measured on the client, see get_client_string_sizes()" );
     }
     return ret;
 }
@@ -9073,131 +10290,624 @@ static const char* db_substr_fun()
     }
     else if ( EIM_dbplat() == EIM_dbplat_postgres )
     {
-        ERROR_raise( ERROR_line, POM_op_not_supported, "Postgres is not currently supported with the -str_len_val option" );
+        ret = "SUBSTR";
     }
     return ret;
 }
 
 /*------------------------------------------------------------------------
-** Given a class name and attribute name return the storage location
-** of associated columns on the class table and on the attribute table.
+** Client-side UTF-8 measurement.
+** Postgres and Oracle configured for UTF-8 do not have a usable server-side
+** byte length for -str_len_val, so on those platforms the candidate strings are
+** fetched and measured here. The kernel returns the byte length, the character
+** count and whether the data is well formed UTF-8. Blocks of 32 (AVX2) or 16 (SSE2)
+** bytes are counted with vector compares. The blocks that contain non-ASCII bytes
+** are validated with byte shuffles (AVX2, SSSE3), on plain SSE2 by the scalar
+** validation state machine.
 ** ----------------------------------------------------------------------- */
-static int get_tables_and_columns(const char *cls_name, const char* att_name, const char** cls_tbl, const char** cls_col, const char** att_tbl, const char** att_col)
+typedef struct slv_utf8_len_s
 {
-    int ifail = POM_ok;
-    OM_class_t  cls_id = OM_null_c;
-    DDS_class_p_t dclass = NULL;
-    const char* c_tbl = NULL;
-    int class_cpid = 0;
+    size_t  bytes;          /**< Data length in bytes */
+    size_t  chars;          /**< Number of characters (bytes that are not continuation bytes) */
+    logical valid;          /**< true = the data is well formed UTF-8 */
+} slv_utf8_len_t;
 
-    OM_attribute_t att_id = OM_null_attribute;
-    DDS_attribute_p_t datt = NULL;
-    int a_dds_type = -1;
-    int a_dds_len = -1;
-    int att_apid = 0;
+typedef struct slv_utf8_state_s
+{
+    int           need;     /**< Continuation bytes still expected for the current character */
+    unsigned char lo;       /**< Lowest value allowed for the next continuation byte */
+    unsigned char hi;       /**< Highest value allowed for the next continuation byte */
+} slv_utf8_state_t;
 
-    if (cls_name == NULL) { return(POM_invalid_class_id); }
-    if (att_name == NULL) { return(POM_invalid_attr_id); }
+static logical slv_client_side()
+{
+    return ( EIM_dbplat() == EIM_dbplat_postgres || ( EIM_dbplat() == EIM_dbplat_oracle && EIM_get_db_cs() == TEXT_CODESET_UTF8 ) );
+}
 
-    cls_id = OM_lookup_class(cls_name);
-    if (cls_id <= OM_invalid_c) { return(POM_invalid_class_id); }
-    if (!OM_has_class_property(cls_id, OM_class_prop_pom_stored)) { return(POM_invalid_class_id); }
+/*
+** Advances the validation state over n bytes, returns false at the first malformed byte.
+** Overlong forms, surrogates and code points above U+10FFFF are rejected.
+*/
+static logical slv_utf8_step( slv_utf8_state_t* st, const unsigned char* p, size_t n )
+{
+    for ( size_t i = 0; i < n; i++ )
+    {
+        unsigned char c = p[i];
 
-    c_tbl = DDS_table_name(cls_id);
-    if (c_tbl == NULL || strlen(c_tbl) < 1) { return(POM_invalid_class_id); }
+        if ( st->need > 0 )
+        {
+            if ( c < st->lo || c > st->hi )
+            {
+                return false;
+            }
 
-    dclass = (DDS_class_p_t)OM_ask_class_of_class_id(cls_id);
-    if (dclass == NULL) { return(POM_invalid_class_id); }
-    class_cpid = dclass->pid;
+            st->lo = 0x80;
+            st->hi = 0xBF;
+            st->need--;
+        }
+        else if ( c < 0x80 )
+        {
+            continue;
+        }
+        else if ( c >= 0xC2 && c <= 0xDF ) { st->need = 1; st->lo = 0x80; st->hi = 0xBF; }
+        else if ( c == 0xE0 )              { st->need = 2; st->lo = 0xA0; st->hi = 0xBF; }
+        else if ( c == 0xED )              { st->need = 2; st->lo = 0x80; st->hi = 0x9F; }
+        else if ( c >= 0xE1 && c <= 0xEF ) { st->need = 2; st->lo = 0x80; st->hi = 0xBF; }
+        else if ( c == 0xF0 )              { st->need = 3; st->lo = 0x90; st->hi = 0xBF; }
+        else if ( c >= 0xF1 && c <= 0xF3 ) { st->need = 3; st->lo = 0x80; st->hi = 0xBF; }
+        else if ( c == 0xF4 )              { st->need = 3; st->lo = 0x80; st->hi = 0x8F; }
+        else
+        {
+            return false;
+        }
+    }
 
-    att_id = OM_lookup_attribute(att_name);
-    if (att_id == OM_null_attribute) { return(POM_invalid_attr_id); }
+    return true;
+}
 
-    datt = (DDS_attribute_p_t)OM_ask_attribute_p_ne((cls_id), (att_id));
-    if (datt == NULL) { return(POM_invalid_attr_id); }
-    if (!(datt->isa == DDS_attribute_c || OM_is_subclass(datt->isa, DDS_attribute_c))) { return(POM_invalid_attr_id); }
-    if (OM_has_attribute_property(dclass->id, datt->id, OM_attr_prop_transient) || OM_has_attribute_property(dclass->id, datt->id, OM_attr_prop_classvar)) { return(POM_invalid_attr_id); }
-    att_apid = datt->pid;
+static size_t slv_utf8_chars_scalar( const unsigned char* p, size_t n )
+{
+    size_t chars = 0;
 
-    // Currently only support long strings.
-    a_dds_type = datt->ptype;
-    if (a_dds_type != DDS_long_string && a_dds_type != DDS_string) { return(POM_op_not_supported); }
+    for ( size_t i = 0; i < n; i++ )
+    {
+        chars += ( ( p[i] & 0xC0 ) != 0x80 );
+    }
 
-    // Currently only support scalars.
-    a_dds_len = DDS_att_len(datt);
-    // if (a_dds_len != 1 && a_dds_len != -1 && (a_dds_len <= 6 && a_dds_type != DDS_long_string)) { return(POM_op_not_supported); }
+    return chars;
+}
 
-    // Ok, let's figure out the table and column names.
-    switch (a_dds_type)
-    {
-    case DDS_long_string:
-        if (a_dds_len == 1)
-        {
-            // POM_long_string scalar
-            if (cls_tbl != NULL)
-            {
-                *cls_tbl = SM_sprintf("%s", c_tbl);
-            }
+#if defined( SLV_UTF8_AVX2 ) || defined( SLV_UTF8_SSE2 )
+static int slv_popcount( unsigned int x )
+{
+    x = x - ( ( x >> 1 ) & 0x55555555u );
+    x = ( x & 0x33333333u ) + ( ( x >> 2 ) & 0x33333333u );
+    return (int)( ( ( ( x + ( x >> 4 ) ) & 0x0F0F0F0Fu ) * 0x01010101u ) >> 24 );
+}
+#endif
 
-            if (cls_col != NULL)
-            {
-                *cls_col = SM_sprintf("%s_%d_%d", DDS_long_string_base, dclass->pid, datt->pid);
-            }
+/*
+** Scalar reference implementation, also used for the tail of the vector kernel.
+*/
+static void slv_utf8_measure_scalar( const char* data, size_t len, slv_utf8_len_t* m )
+{
+    const unsigned char* p = (const unsigned char*)data;
+    slv_utf8_state_t st = { 0, 0x80, 0xBF };
 
-            if (att_tbl != NULL)
-            {
-                *att_tbl = SM_sprintf("%s", DDS_ask_dbname((DDS_attribute_p_t)OM_ask_attribute_p(cls_id, att_id)));
-            }
+    m->bytes = len;
+    m->chars = slv_utf8_chars_scalar( p, len );
+    m->valid = ( slv_utf8_step( &st, p, len ) && st.need == 0 );
+}
 
-            if (att_col != NULL)
-            {
-                *att_col = SM_sprintf("%s", "pval");
-            }
-        }
-        else if (a_dds_len == -1)
-        {
-            // POM_long_string VLA
-            if (cls_tbl != NULL)
-            {
-                *cls_tbl = SM_sprintf("%s", c_tbl);
-            }
+#if defined( SLV_UTF8_AVX2 ) || defined( SLV_UTF8_SSSE3 )
+/*
+** Vector validation of the blocks that contain non-ASCII bytes (lookup algorithm of
+** Keiser and Lemire). The high and low nibble of the previous byte and the high
+** nibble of the current byte each select a set of error bits from a 16 byte table,
+** a byte pair is malformed where all three sets have a bit in common. Bytes that
+** must be the second or third continuation byte of a character flip the "two
+** continuation bytes" bit. Needs a byte shuffle, so it is not built for plain SSE2.
+*/
+#define SLV_UTF8_VALIDATE
+
+#if defined( SLV_UTF8_AVX2 )
+typedef __m256i slv_vec_t;
+#define SLV_VEC_BYTES               32
+#define SLV_VEC_LOAD( p )           _mm256_loadu_si256( (const __m256i*)( p ) )
+#define SLV_VEC_ZERO( )             _mm256_setzero_si256( )
+#define SLV_VEC_SET1( c )           _mm256_set1_epi8( (char)( c ) )
+#define SLV_VEC_TABLE( t )          _mm256_broadcastsi128_si256( _mm_loadu_si128( (const __m128i*)( t ) ) )
+#define SLV_VEC_LOOKUP( t, v )      _mm256_shuffle_epi8( SLV_VEC_TABLE( t ), v )
+#define SLV_VEC_AND( a, b )         _mm256_and_si256( a, b )
+#define SLV_VEC_OR( a, b )          _mm256_or_si256( a, b )
+#define SLV_VEC_XOR( a, b )         _mm256_xor_si256( a, b )
+#define SLV_VEC_SUBS( a, b )        _mm256_subs_epu8( a, b )
+#define SLV_VEC_HIGH_NIBBLE( v )    _mm256_and_si256( _mm256_srli_epi16( v, 4 ), SLV_VEC_SET1( 0x0F ) )
+#define SLV_VEC_PREV( v, prev, n )  _mm256_alignr_epi8( v, _mm256_permute2x128_si256( prev, v, 0x21 ), 16 - ( n ) )
+#define SLV_VEC_IS_ZERO( v )        _mm256_testz_si256( v, v )
+#else
+typedef __m128i slv_vec_t;
+#define SLV_VEC_BYTES               16
+#define SLV_VEC_LOAD( p )           _mm_loadu_si128( (const __m128i*)( p ) )
+#define SLV_VEC_ZERO( )             _mm_setzero_si128( )
+#define SLV_VEC_SET1( c )           _mm_set1_epi8( (char)( c ) )
+#define SLV_VEC_TABLE( t )          _mm_loadu_si128( (const __m128i*)( t ) )
+#define SLV_VEC_LOOKUP( t, v )      _mm_shuffle_epi8( SLV_VEC_TABLE( t ), v )
+#define SLV_VEC_AND( a, b )         _mm_and_si128( a, b )
+#define SLV_VEC_OR( a, b )          _mm_or_si128( a, b )
+#define SLV_VEC_XOR( a, b )         _mm_xor_si128( a, b )
+#define SLV_VEC_SUBS( a, b )        _mm_subs_epu8( a, b )
+#define SLV_VEC_HIGH_NIBBLE( v )    _mm_and_si128( _mm_srli_epi16( v, 4 ), SLV_VEC_SET1( 0x0F ) )
+#define SLV_VEC_PREV( v, prev, n )  _mm_alignr_epi8( v, prev, 16 - ( n ) )
+#define SLV_VEC_IS_ZERO( v )        ( _mm_movemask_epi8( _mm_cmpeq_epi8( v, _mm_setzero_si128( ) ) ) == 0xFFFF )
+#endif
 
-            if (cls_col != NULL)
-            {
-                *cls_col = SM_sprintf("%s_%d_%d", DDS_long_string_base, dclass->pid, datt->pid);
-            }
+// Error bits of a byte pair, the previous byte first.
+#define SLV_U8_TOO_SHORT       0x01     // 11______ 0_______ or 11______ 11______
+#define SLV_U8_TOO_LONG        0x02     // 0_______ 10______
+#define SLV_U8_OVERLONG_3      0x04     // 11100000 100_____
+#define SLV_U8_TOO_LARGE       0x08     // 11110100 1001____ and above
+#define SLV_U8_SURROGATE       0x10     // 11101101 101_____
+#define SLV_U8_OVERLONG_2      0x20     // 1100000_ 10______
+#define SLV_U8_TOO_LARGE_1000  0x40     // 11110101 1000____ and above
+#define SLV_U8_OVERLONG_4      0x40     // 11110000 1000____
+#define SLV_U8_TWO_CONTS       0x80     // 10______ 10______
+#define SLV_U8_CARRY           ( SLV_U8_TOO_SHORT | SLV_U8_TOO_LONG | SLV_U8_TWO_CONTS )
+
+static const unsigned char slv_u8_byte_1_high[16] =
+{
+    SLV_U8_TOO_LONG, SLV_U8_TOO_LONG, SLV_U8_TOO_LONG, SLV_U8_TOO_LONG,
+    SLV_U8_TOO_LONG, SLV_U8_TOO_LONG, SLV_U8_TOO_LONG, SLV_U8_TOO_LONG,
+    SLV_U8_TWO_CONTS, SLV_U8_TWO_CONTS, SLV_U8_TWO_CONTS, SLV_U8_TWO_CONTS,
+    SLV_U8_TOO_SHORT | SLV_U8_OVERLONG_2,
+    SLV_U8_TOO_SHORT,
+    SLV_U8_TOO_SHORT | SLV_U8_OVERLONG_3 | SLV_U8_SURROGATE,
+    SLV_U8_TOO_SHORT | SLV_U8_TOO_LARGE | SLV_U8_TOO_LARGE_1000 | SLV_U8_OVERLONG_4
+};
 
-            if (att_tbl != NULL)
-            {
-                *att_tbl = SM_sprintf("%s", DDS_ask_dbname((DDS_attribute_p_t)OM_ask_attribute_p(cls_id, att_id)));
-            }
+static const unsigned char slv_u8_byte_1_low[16] =
+{
+    SLV_U8_CARRY | SLV_U8_OVERLONG_3 | SLV_U8_OVERLONG_2 | SLV_U8_OVERLONG_4,
+    SLV_U8_CARRY | SLV_U8_OVERLONG_2,
+    SLV_U8_CARRY,
+    SLV_U8_CARRY,
+    SLV_U8_CARRY | SLV_U8_TOO_LARGE,
+    SLV_U8_CARRY | SLV_U8_TOO_LARGE | SLV_U8_TOO_LARGE_1000,
+    SLV_U8_CARRY | SLV_U8_TOO_LARGE | SLV_U8_TOO_LARGE_1000,
+    SLV_U8_CARRY | SLV_U8_TOO_LARGE | SLV_U8_TOO_LARGE_1000,
+    SLV_U8_CARRY | SLV_U8_TOO_LARGE | SLV_U8_TOO_LARGE_1000,
+    SLV_U8_CARRY | SLV_U8_TOO_LARGE | SLV_U8_TOO_LARGE_1000,
+    SLV_U8_CARRY | SLV_U8_TOO_LARGE | SLV_U8_TOO_LARGE_1000,
+    SLV_U8_CARRY | SLV_U8_TOO_LARGE | SLV_U8_TOO_LARGE_1000,
+    SLV_U8_CARRY | SLV_U8_TOO_LARGE | SLV_U8_TOO_LARGE_1000,
+    SLV_U8_CARRY | SLV_U8_TOO_LARGE | SLV_U8_TOO_LARGE_1000 | SLV_U8_SURROGATE,
+    SLV_U8_CARRY | SLV_U8_TOO_LARGE | SLV_U8_TOO_LARGE_1000,
+    SLV_U8_CARRY | SLV_U8_TOO_LARGE | SLV_U8_TOO_LARGE_1000
+};
 
-            if (att_col != NULL)
-            {
-                *att_col = SM_sprintf("%s", "pval");
-            }
-        }
-        else if (a_dds_len > 6)
-        {
-            // POM_long_string LA (large array)
-            if (cls_tbl != NULL)
-            {
-                *cls_tbl = SM_sprintf("%s", c_tbl);
-            }
+static const unsigned char slv_u8_byte_2_high[16] =
+{
+    SLV_U8_TOO_SHORT, SLV_U8_TOO_SHORT, SLV_U8_TOO_SHORT, SLV_U8_TOO_SHORT,
+    SLV_U8_TOO_SHORT, SLV_U8_TOO_SHORT, SLV_U8_TOO_SHORT, SLV_U8_TOO_SHORT,
+    SLV_U8_TOO_LONG | SLV_U8_OVERLONG_2 | SLV_U8_TWO_CONTS | SLV_U8_OVERLONG_3 | SLV_U8_TOO_LARGE_1000 | SLV_U8_OVERLONG_4,
+    SLV_U8_TOO_LONG | SLV_U8_OVERLONG_2 | SLV_U8_TWO_CONTS | SLV_U8_OVERLONG_3 | SLV_U8_TOO_LARGE,
+    SLV_U8_TOO_LONG | SLV_U8_OVERLONG_2 | SLV_U8_TWO_CONTS | SLV_U8_SURROGATE | SLV_U8_TOO_LARGE,
+    SLV_U8_TOO_LONG | SLV_U8_OVERLONG_2 | SLV_U8_TWO_CONTS | SLV_U8_SURROGATE | SLV_U8_TOO_LARGE,
+    SLV_U8_TOO_SHORT, SLV_U8_TOO_SHORT, SLV_U8_TOO_SHORT, SLV_U8_TOO_SHORT
+};
 
-            if (cls_col != NULL)
-            {
-                *cls_col = NULL;
-            }
+// The last three bytes of a block may start a character that continues in the next one.
+static const unsigned char slv_u8_max_last[32] =
+{
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1
+};
 
-            if (att_tbl != NULL)
-            {
-                *att_tbl = SM_sprintf("%s", DDS_ask_dbname((DDS_attribute_p_t)OM_ask_attribute_p(cls_id, att_id)));
-            }
+typedef struct slv_utf8_vstate_s
+{
+    slv_vec_t prev;         /**< Previous block */
+    slv_vec_t incomplete;   /**< Non-zero where the previous block ends inside a character */
+    slv_vec_t error;        /**< Non-zero once a malformed byte pair has been seen */
+} slv_utf8_vstate_t;
 
-            if (att_col != NULL)
-            {
-                *att_col = SM_sprintf("%s", "pval");
+/*
+** Validates the next block v, given as ASCII when none of its bytes has the high bit set.
+*/
+static inline void slv_utf8_vcheck( slv_utf8_vstate_t* vs, slv_vec_t v, logical ascii )
+{
+    if ( ascii )
+    {
+        vs->error = SLV_VEC_OR( vs->error, vs->incomplete );
+    }
+    else
+    {
+        slv_vec_t prev1 = SLV_VEC_PREV( v, vs->prev, 1 );
+        slv_vec_t special = SLV_VEC_AND( SLV_VEC_AND( SLV_VEC_LOOKUP( slv_u8_byte_1_high, SLV_VEC_HIGH_NIBBLE( prev1 ) ),
+                                                      SLV_VEC_LOOKUP( slv_u8_byte_1_low, SLV_VEC_AND( prev1, SLV_VEC_SET1( 0x0F ) ) ) ),
+                                         SLV_VEC_LOOKUP( slv_u8_byte_2_high, SLV_VEC_HIGH_NIBBLE( v ) ) );
+
+        // Only 111_____ two bytes back and 1111____ three bytes back reach 0x80.
+        slv_vec_t must23 = SLV_VEC_OR( SLV_VEC_SUBS( SLV_VEC_PREV( v, vs->prev, 2 ), SLV_VEC_SET1( 0xE0 - 0x80 ) ),
+                                       SLV_VEC_SUBS( SLV_VEC_PREV( v, vs->prev, 3 ), SLV_VEC_SET1( 0xF0 - 0x80 ) ) );
+
+        vs->error = SLV_VEC_OR( vs->error, SLV_VEC_XOR( SLV_VEC_AND( must23, SLV_VEC_SET1( 0x80 ) ), special ) );
+    }
+
+    vs->incomplete = SLV_VEC_SUBS( v, SLV_VEC_LOAD( slv_u8_max_last + sizeof( slv_u8_max_last ) - SLV_VEC_BYTES ) );
+    vs->prev = v;
+}
+#endif
+
+/*
+** Measures len bytes of data with the widest kernel this binary was built for.
+*/
+static void slv_utf8_measure( const char* data, size_t len, slv_utf8_len_t* m )
+{
+#if defined( SLV_UTF8_AVX2 ) || defined( SLV_UTF8_SSE2 )
+    const unsigned char* p = (const unsigned char*)data;
+    size_t  chars = 0;
+    size_t  i = 0;
+#if defined( SLV_UTF8_VALIDATE )
+    slv_utf8_vstate_t vs = { SLV_VEC_ZERO( ), SLV_VEC_ZERO( ), SLV_VEC_ZERO( ) };
+#else
+    slv_utf8_state_t st = { 0, 0x80, 0xBF };
+    logical valid = true;
+#endif
+
+#if defined( SLV_UTF8_AVX2 )
+    const size_t block = 32;
+    const __m256i cont_limit = _mm256_set1_epi8( (char)0xC0 );
+
+    for ( ; i + block <= len; i += block )
+    {
+        __m256i v = _mm256_loadu_si256( (const __m256i*)( p + i ) );
+        unsigned int high = (unsigned int)_mm256_movemask_epi8( v );
+
+        // Continuation bytes (0x80-0xBF) are the signed values below (char)0xC0.
+        unsigned int cont = (unsigned int)_mm256_movemask_epi8( _mm256_cmpgt_epi8( cont_limit, v ) );
+        chars += block - slv_popcount( cont );
+#else
+    const size_t block = 16;
+    const __m128i cont_limit = _mm_set1_epi8( (char)0xC0 );
+
+    for ( ; i + block <= len; i += block )
+    {
+        __m128i v = _mm_loadu_si128( (const __m128i*)( p + i ) );
+        unsigned int high = (unsigned int)_mm_movemask_epi8( v );
+
+        // Continuation bytes (0x80-0xBF) are the signed values below (char)0xC0.
+        unsigned int cont = (unsigned int)_mm_movemask_epi8( _mm_cmplt_epi8( v, cont_limit ) );
+        chars += block - slv_popcount( cont );
+#endif
+#if defined( SLV_UTF8_VALIDATE )
+        slv_utf8_vcheck( &vs, v, high == 0 );
+#else
+        // Pure ASCII blocks with no character in progress need no validation.
+        if ( valid && ( high != 0 || st.need > 0 ) )
+        {
+            valid = slv_utf8_step( &st, p + i, block );
+        }
+#endif
+    }
+
+    chars += slv_utf8_chars_scalar( p + i, len - i );
+
+#if defined( SLV_UTF8_VALIDATE )
+    // The tail is validated as one more block padded with NUL bytes, which also
+    // rejects a character left incomplete at the end of the data.
+    unsigned char tail[SLV_VEC_BYTES] = { 0 };
+    memcpy( tail, p + i, len - i );
+    slv_utf8_vcheck( &vs, SLV_VEC_LOAD( tail ), false );
+
+    logical valid = SLV_VEC_IS_ZERO( vs.error );
+#else
+    if ( valid )
+    {
+        valid = ( slv_utf8_step( &st, p + i, len - i ) && st.need == 0 );
+    }
+#endif
+
+    m->bytes = len;
+    m->chars = chars;
+    m->valid = valid;
+#else
+    slv_utf8_measure_scalar( data, len, m );
+#endif
+}
+
+/*
+** Sets *str_len to the byte length of data. On the client-side platforms the data is also
+** checked for well formed UTF-8, malformed data is logged and false is returned.
+*/
+static logical slv_data_len( const char* data, const char* puid, int* str_len )
+{
+    size_t len = strlen( data );
+    *str_len = (int)len;
+
+    if ( !slv_client_side() )
+    {
+        return true;
+    }
+
+    slv_utf8_len_t m;
+    slv_utf8_measure( data, len, &m );
+
+    if ( !m.valid )
+    {
+        logger()->printf( "\nInvalid UTF-8 data: puid=%s bytes=%d chars=%d", ( puid != NULL ? puid : "null" ), (int)m.bytes, (int)m.chars );
+    }
+
+    return m.valid;
+}
+
+/*
+** SQL expression giving an upper bound of the byte length of a long-string column on the
+** client-side platforms, in the storage units used by LENGTHB/DATALENGTH on the others.
+** Oracle counts CLOB characters, UTF-8 needs at most four bytes for each of them.
+*/
+static std::string slv_client_byte_len_expr( const std::string& col )
+{
+    std::stringstream expr;
+
+    if ( EIM_dbplat() == EIM_dbplat_oracle )
+    {
+        expr << "(DBMS_LOB.GETLENGTH(" << col << ") * 4)";
+    }
+    else
+    {
+        expr << "OCTET_LENGTH(" << col << ")";
+    }
+
+    if ( EIM_unicode_enabled() )
+    {
+        return "(" + expr.str() + " * 2)";
+    }
+
+    return expr.str();
+}
+
+/*
+** Server-side prefilter of the client-side sizing: the strings of at least min_bytes
+** bytes. Postgres only stores well formed UTF-8. Oracle does not check the data, so
+** there any string with a non-ASCII byte is kept as well and validated on the client.
+*/
+static std::string slv_client_prefilter( const std::string& col, int min_bytes )
+{
+    std::stringstream expr;
+
+    if ( EIM_dbplat() == EIM_dbplat_oracle )
+    {
+        expr << "(LENGTHB(" << col << ") >= " << min_bytes << " OR CONVERT(" << col << ", 'US7ASCII') <> " << col << ")";
+    }
+    else
+    {
+        expr << "OCTET_LENGTH(" << col << ") >= " << min_bytes;
+    }
+
+    return expr.str();
+}
+
+/*
+** Micro-benchmark of the UTF-8 kernel (-bench=utf8), no database connection is required.
+** Times the scalar and vector kernels over the same ASCII and mixed buffers and
+** fails if they disagree.
+*/
+static int slv_bench_utf8()
+{
+    const size_t buf_len = 64 * 1024 * 1024;
+    const int    passes = 10;
+    int          ret = OK;
+
+    // Mixed data repeats "Teamcenter " followed by 2, 3 and 4 byte characters.
+    static const char mixed_seed[] = "Teamcenter \xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80 ";
+    const size_t seed_len = sizeof( mixed_seed ) - 1;
+
+    std::vector< char > ascii( buf_len, 'a' );
+    std::vector< char > mixed( buf_len );
+
+    for ( size_t i = 0; i < buf_len; i++ )
+    {
+        mixed[i] = mixed_seed[i % seed_len];
+    }
+
+    // Trim the mixed buffer to a whole number of seeds so that it remains well formed.
+    size_t mixed_len = buf_len - ( buf_len % seed_len );
+
+    struct { const char* name; const char* data; size_t len; } inputs[] =
+    {
+        { "ascii", &ascii[0], buf_len },
+        { "mixed", &mixed[0], mixed_len }
+    };
+
+#if defined( SLV_UTF8_AVX2 )
+    const char* vec_name = "avx2";
+#elif defined( SLV_UTF8_SSSE3 )
+    const char* vec_name = "ssse3";
+#elif defined( SLV_UTF8_SSE2 )
+    const char* vec_name = "sse2";
+#else
+    const char* vec_name = "scalar";
+#endif
+
+    for ( int k = 0; k < 2; k++ )
+    {
+        slv_utf8_len_t ms = { 0, 0, false };
+        slv_utf8_len_t mv = { 0, 0, false };
+
+        auto t0 = std::chrono::steady_clock::now();
+        for ( int n = 0; n < passes; n++ )
+        {
+            slv_utf8_measure_scalar( inputs[k].data, inputs[k].len, &ms );
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        for ( int n = 0; n < passes; n++ )
+        {
+            slv_utf8_measure( inputs[k].data, inputs[k].len, &mv );
+        }
+        auto t2 = std::chrono::steady_clock::now();
+
+        double mb = (double)inputs[k].len * passes / ( 1024.0 * 1024.0 );
+        double scalar_s = std::chrono::duration< double >( t1 - t0 ).count();
+        double vector_s = std::chrono::duration< double >( t2 - t1 ).count();
+
+        std::stringstream msg;
+        msg << "utf8 " << inputs[k].name << ": bytes=" << ms.bytes << " chars=" << ms.chars << " valid=" << ( ms.valid ? "true" : "false" );
+        msg << "\n   scalar " << (long)( mb / ( scalar_s > 0.0 ? scalar_s : 1e-9 ) ) << " MB/s";
+        msg << "\n   " << vec_name << " " << (long)( mb / ( vector_s > 0.0 ? vector_s : 1e-9 ) ) << " MB/s";
+
+        if ( ms.bytes != mv.bytes || ms.chars != mv.chars || ms.valid != mv.valid )
+        {
+            msg << "\n   ERROR: " << vec_name << " result (chars=" << mv.chars << " valid=" << ( mv.valid ? "true" : "false" ) << ") does not match the scalar result";
+            ret = FAIL;
+        }
+
+        cons_out_no_log( msg.str() );
+    }
+
+    return ret;
+}
+
+/*
+** Runs the micro-benchmark named by -bench=.
+*/
+static int run_bench( const char* name )
+{
+    if ( strcmp( name, "utf8" ) == 0 )
+    {
+        return slv_bench_utf8();
+    }
+
+    if ( strcmp( name, "csv" ) == 0 )
+    {
+        return EV_bench_csv();
+    }
+
+    std::stringstream msg;
+    msg << "ERROR: Unknown benchmark (" << name << ") - supported benchmarks: utf8, csv";
+    cons_out_no_log( msg.str() );
+    return FAIL;
+}
+
+/*------------------------------------------------------------------------
+** Given a class name and attribute name return the storage location
+** of associated columns on the class table and on the attribute table.
+** ----------------------------------------------------------------------- */
+static int get_tables_and_columns(const char *cls_name, const char* att_name, const char** cls_tbl, const char** cls_col, const char** att_tbl, const char** att_col)
+{
+    int ifail = POM_ok;
+    OM_class_t  cls_id = OM_null_c;
+    DDS_class_p_t dclass = NULL;
+    const char* c_tbl = NULL;
+    int class_cpid = 0;
+
+    OM_attribute_t att_id = OM_null_attribute;
+    DDS_attribute_p_t datt = NULL;
+    int a_dds_type = -1;
+    int a_dds_len = -1;
+    int att_apid = 0;
+
+    if (cls_name == NULL) { return(POM_invalid_class_id); }
+    if (att_name == NULL) { return(POM_invalid_attr_id); }
+
+    cls_id = OM_lookup_class(cls_name);
+    if (cls_id <= OM_invalid_c) { return(POM_invalid_class_id); }
+    if (!OM_has_class_property(cls_id, OM_class_prop_pom_stored)) { return(POM_invalid_class_id); }
+
+    c_tbl = DDS_table_name(cls_id);
+    if (c_tbl == NULL || strlen(c_tbl) < 1) { return(POM_invalid_class_id); }
+
+    dclass = (DDS_class_p_t)OM_ask_class_of_class_id(cls_id);
+    if (dclass == NULL) { return(POM_invalid_class_id); }
+    class_cpid = dclass->pid;
+
+    att_id = OM_lookup_attribute(att_name);
+    if (att_id == OM_null_attribute) { return(POM_invalid_attr_id); }
+
+    datt = (DDS_attribute_p_t)OM_ask_attribute_p_ne((cls_id), (att_id));
+    if (datt == NULL) { return(POM_invalid_attr_id); }
+    if (!(datt->isa == DDS_attribute_c || OM_is_subclass(datt->isa, DDS_attribute_c))) { return(POM_invalid_attr_id); }
+    if (OM_has_attribute_property(dclass->id, datt->id, OM_attr_prop_transient) || OM_has_attribute_property(dclass->id, datt->id, OM_attr_prop_classvar)) { return(POM_invalid_attr_id); }
+    att_apid = datt->pid;
+
+    // Currently only support long strings.
+    a_dds_type = datt->ptype;
+    if (a_dds_type != DDS_long_string && a_dds_type != DDS_string) { return(POM_op_not_supported); }
+
+    // Currently only support scalars.
+    a_dds_len = DDS_att_len(datt);
+    // if (a_dds_len != 1 && a_dds_len != -1 && (a_dds_len <= 6 && a_dds_type != DDS_long_string)) { return(POM_op_not_supported); }
+
+    // Ok, let's figure out the table and column names.
+    switch (a_dds_type)
+    {
+    case DDS_long_string:
+        if (a_dds_len == 1)
+        {
+            // POM_long_string scalar
+            if (cls_tbl != NULL)
+            {
+                *cls_tbl = SM_sprintf("%s", c_tbl);
+            }
+
+            if (cls_col != NULL)
+            {
+                *cls_col = SM_sprintf("%s_%d_%d", DDS_long_string_base, dclass->pid, datt->pid);
+            }
+
+            if (att_tbl != NULL)
+            {
+                *att_tbl = SM_sprintf("%s", DDS_ask_dbname((DDS_attribute_p_t)OM_ask_attribute_p(cls_id, att_id)));
+            }
+
+            if (att_col != NULL)
+            {
+                *att_col = SM_sprintf("%s", "pval");
+            }
+        }
+        else if (a_dds_len == -1)
+        {
+            // POM_long_string VLA
+            if (cls_tbl != NULL)
+            {
+                *cls_tbl = SM_sprintf("%s", c_tbl);
+            }
+
+            if (cls_col != NULL)
+            {
+                *cls_col = SM_sprintf("%s_%d_%d", DDS_long_string_base, dclass->pid, datt->pid);
+            }
+
+            if (att_tbl != NULL)
+            {
+                *att_tbl = SM_sprintf("%s", DDS_ask_dbname((DDS_attribute_p_t)OM_ask_attribute_p(cls_id, att_id)));
+            }
+
+            if (att_col != NULL)
+            {
+                *att_col = SM_sprintf("%s", "pval");
+            }
+        }
+        else if (a_dds_len > 6)
+        {
+            // POM_long_string LA (large array)
+            if (cls_tbl != NULL)
+            {
+                *cls_tbl = SM_sprintf("%s", c_tbl);
+            }
+
+            if (cls_col != NULL)
+            {
+                *cls_col = NULL;
+            }
+
+            if (att_tbl != NULL)
+            {
+                *att_tbl = SM_sprintf("%s", DDS_ask_dbname((DDS_attribute_p_t)OM_ask_attribute_p(cls_id, att_id)));
+            }
+
+            if (att_col != NULL)
+            {
+                *att_col = SM_sprintf("%s", "pval");
             }
         }
         else if (a_dds_len <= 6)
@@ -9579,17 +11289,11 @@ static int get_string_meta(const char* cls, const char** super)
                 if (arry != NULL) { msg << " array=" << *arry << ","; }
                 else { msg << " array=null,"; }
                
-                //
-                // Do NOT output the -str_len_val commands when it is not supported.
-                //
-                if (EIM_dbplat() == EIM_dbplat_mssql || (EIM_dbplat() == EIM_dbplat_oracle && EIM_get_db_cs() != TEXT_CODESET_UTF8 ))
+                if ( cname != NULL && aname != NULL && pptype != NULL && arry != NULL )
                 {
-                    if ( cname != NULL && aname != NULL && pptype != NULL && arry != NULL )
+                    if ( ( *arry == 1 || *arry == -1 || *arry > 6 || *arry <= 6 ) && ( *pptype == 112 || *pptype == 117 ) )
                     {
-                        if ( ( *arry == 1 || *arry == -1 || *arry > 6 || *arry <= 6 ) && ( *pptype == 112 || *pptype == 117 ) )
-                        {
-                            msg << "\nreference_manager -str_len_val -u=user -p=password -g=dba -from=" << cname << ":" << aname;
-                        }
+                        msg << "\nreference_manager -str_len_val -u=user -p=password -g=dba -from=" << cname << ":" << aname;
                     }
                 }
 
@@ -9660,6 +11364,39 @@ static void str_len_val_status(logical force, const char* state, const char* pre
     }
 }
 
+/*------------------------------------------------------------------------
+** Append a filter restricting sql to the specified UID and set of UIDs.
+** More than one UID is matched against the staged UID set table.
+** ----------------------------------------------------------------------- */
+static void append_uid_filter(std::stringstream &sql, const char* sql_prefix, const char* uid, std::vector< std::string > *uid_vec)
+{
+    std::vector< std::string > uids;
+
+    if (uid != NULL)
+    {
+        uids.push_back(uid);
+    }
+
+    if (uid_vec != NULL)
+    {
+        for (int i = 0; i < uid_vec->size(); i++)
+        {
+            if (uid == NULL || (*uid_vec)[i] != uid)
+            {
+                uids.push_back((*uid_vec)[i]);
+            }
+        }
+    }
+
+    char* where = create_uid_specific_where_clause(sql_prefix, &uids);
+
+    if (where != NULL)
+    {
+        sql << where;
+        SM_free(where);
+    }
+}
+
 /*------------------------------------------------------------------------
 ** Retrieves the calcualted sizes for POM_string attributes.
 ** ----------------------------------------------------------------------- */
@@ -9667,6 +11404,11 @@ static int get_string_sizes(const char *cls_tbl, const char *cls_col, int max_si
 {
     int ifail = OK;
 
+    if ( slv_client_side() )
+    {
+        return get_client_string_sizes(cls_tbl, cls_col, false, max_size, uid, uid_vec, puids, NULL, calc_sizes);
+    }
+
     if ( EIM_dbplat() != EIM_dbplat_mssql && EIM_dbplat() != EIM_dbplat_oracle )
     {
         ERROR_raise(ERROR_line, POM_internal_error, "Functionality is not supported for RDBMSs other than MS SQL Server and Oracle.");
@@ -9711,41 +11453,7 @@ static int get_string_sizes(const char *cls_tbl, const char *cls_col, int max_si
         where_added = true;
     }
 
-    if (uid != NULL || (uid_vec != NULL && uid_vec->size() > 0))
-    {
-        if (!where_added)
-        {
-            sql << " WHERE a.puid IN (";
-            where_added = true;
-        }
-        else
-        {
-            sql << " AND a.puid IN (";
-        }
-
-        int inc_cnt = 0;
-
-        if (uid != NULL)
-        {
-            sql << "'" << uid << "'";
-            inc_cnt++;
-        }
-
-        if (uid_vec != NULL && uid_vec->size() > 0)
-        {
-            for (int i = 0; i < uid_vec->size(); i++)
-            {
-                if (inc_cnt > 0)
-                {
-                    sql << ",";
-                }
-
-                sql << "'" << (*uid_vec)[i] << "'";
-                inc_cnt++;
-            }
-        }
-        sql << ")";
-    }
+    append_uid_filter(sql, (where_added ? " AND a.puid" : " WHERE a.puid"), uid, uid_vec);
 
     sql << " ORDER BY calc_size ASC";
 
@@ -9805,495 +11513,775 @@ static int get_string_sizes(const char *cls_tbl, const char *cls_col, int max_si
 }
 
 /*------------------------------------------------------------------------
-** Validate the size of data in a POM_string attribute against
-** the maximum size of the field.
-** We'll assume that if the stored data length is less than 1/4 of the max data length
-** that it will happily fit within the max buffer size when read from the database.
+** Retrieves the calculated sizes of several POM_string columns of one class table
+** with a single read of the table. puids[k] and calc_sizes[k] receive the rows of
+** cols[k] that reach the same threshold as get_string_sizes() uses for that column.
+** The qualifying rows are fetched SLV_TABLE_PAGE_ROWS at a time, each page
+** starting after the last puid of the previous one.
 ** ----------------------------------------------------------------------- */
-static int validate_string_sizes(const char* func, const char* cls, const char* attr, const char *cls_tbl, const char *cls_col, int max_size, std::vector< std::string > &puids, std::vector< int > &calc_sizes, int* bad_count)
+static int get_table_string_sizes(const char *cls_tbl, std::vector< std::string > &cols, std::vector< int > &max_sizes, std::vector< std::string > *uid_vec, std::vector< std::vector< std::string > > &puids, std::vector< std::vector< int > > &calc_sizes)
 {
     int ifail = OK;
-    // RM_SLV_ stands for Reference Manager String Length Validation
-    int rm_slv_batch_size = 65500;       // Number of records processed per batch
-    int rm_slv_max_len = 100000;         // Maximum length of records within the batch
-    int rm_slv_percent_exp = 30;         // Percentage of expected expansion due to none single byte characters
-    int rm_slv_fixed_exp = 100;          // Additional fixed byte expansion to provide additional memory for unforseen expansions...
-    int rm_slv_max_mem_m = 6000;         // Maximum memory to be used within each batch... unit single record processing kicks in.
-    int64_t rm_slv_meg = 1024 * 1024;    // Megabyte
-
-    int rpt_worked_cnt = 0;              // Number of records that were processed
-    int rpt_success_cnt = 0;             // Number of records where data length matches the stored length
-    int rpt_under_cnt = 0;               // Number of records where the stored count under represents the data length
-    int rpt_over_cnt = 0;                // Number of records where the stored count over represents the data length
-    int rpt_unknown_cnt = 0;             // Number of records that we don't know about (NULL for size returned etc...)
-    int rpt_eligible_cnt = 0;            // Number of records that are eligible for correction
-    int rpt_corrected_cnt = 0;           // Number of records where the stored count was actually corrected
+    int cnt = (int)cols.size();
 
-    int wrk_start_pos = 0;               // UID to start with.
-    int wrk_max_len = 0;                 // Maximum size of a buffer that is expected to retrieve data
-    int wrk_batch_size = 0;              // Batch size for the current batch. 
+    if ( slv_client_side() )
+    {
+        return get_client_table_string_sizes(cls_tbl, cols, max_sizes, uid_vec, puids, calc_sizes);
+    }
 
-                                         // Check configuration values. 
-    rm_slv_batch_size = DDS_ask_pom_parameter_int("rm_slv_batch_size", rm_slv_batch_size);
-    rm_slv_max_len = DDS_ask_pom_parameter_int("rm_slv_max_len", rm_slv_max_len);
-    rm_slv_percent_exp = DDS_ask_pom_parameter_int("rm_slv_percent_exp", rm_slv_percent_exp);
-    rm_slv_fixed_exp = DDS_ask_pom_parameter_int("rm_slv_fixed_exp", rm_slv_fixed_exp);
-    rm_slv_max_mem_m = DDS_ask_pom_parameter_int("rm_slv_max_mem_m", rm_slv_max_mem_m);
-    EIM_uid_t* cor_puids = NULL;
-    int*       cor_lens = NULL;
+    int  rm_slv_max_bytes_per_char = 4;      // UTF-8 we use 4. Used to calculate minimum length before we consider it a possible problem. 
+    rm_slv_max_bytes_per_char = DDS_ask_pom_parameter_int("rm_slv_max_bytes_per_char", rm_slv_max_bytes_per_char);
 
+    int storge_bytes_per_ascii_char = 2;    // For unicode there are two bytes for every ascii character
 
-    // As we are currently not using ENQ or temporary tables we will limit the batch size to 400 to limit the length of the SQL statement.
-    if (rm_slv_batch_size > 400)
+    if (!EIM_unicode_enabled())
     {
-        rm_slv_batch_size = 400;
+        storge_bytes_per_ascii_char = 1;    // If not unicode we assume UTF-8, in which case we have 1 storage byte per ascii character
     }
 
-    wrk_max_len = max_size + ((max_size * rm_slv_percent_exp) / 100) + rm_slv_fixed_exp;
+    std::vector< int > min_sizes(cnt, 0);
+    std::vector< std::string > names(cnt);
 
-    if (rm_slv_max_len < wrk_max_len)
+    for (int k = 0; k < cnt; k++)
     {
-        rm_slv_batch_size = 1;          // If we exceeded the size then process the batch one at a time. 
-    }
+        std::stringstream name;
+        name << "s" << k;
+        names[k] = name.str();
 
-    // Make sure we limit the batch size so that we don't use significantly more memory than the maximum configured.
-    int64_t temp_cnt = rm_slv_meg * rm_slv_max_mem_m / wrk_max_len;
-    if (temp_cnt < rm_slv_batch_size)
-    {
-        rm_slv_batch_size = (int)temp_cnt;
+        if (rm_slv_max_bytes_per_char > 0)
+        {
+            min_sizes[k] = (int)((max_sizes[k] * storge_bytes_per_ascii_char) / rm_slv_max_bytes_per_char);
+        }
     }
 
-    if (calc_sizes.size() < rm_slv_batch_size)
+    std::stringstream select;
+    select << "a.puid puid";
+
+    for (int k = 0; k < cnt; k++)
     {
-        rm_slv_batch_size = calc_sizes.size();
+        select << ", " << db_byte_len_fun() << "(a." << cols[k] << ") " << names[k];
     }
 
-    if (rm_slv_batch_size < 1)
+    select << " FROM " << cls_tbl << " a";
+
+    logical where_added = false;
+
+    if (rm_slv_max_bytes_per_char > 0)
     {
-        rm_slv_batch_size = 1;
+        select << " WHERE (";
+
+        for (int k = 0; k < cnt; k++)
+        {
+            select << (k > 0 ? " OR " : "") << db_byte_len_fun() << "(a." << cols[k] << ") >= " << min_sizes[k];
+        }
+
+        select << ")";
+        where_added = true;
     }
 
-    cor_puids = (EIM_uid_t*)SM_alloc(sizeof(EIM_uid_t) * (rm_slv_batch_size + 1));
-    cor_lens = (int*)SM_alloc(sizeof(int) * (rm_slv_batch_size + 1));
+    append_uid_filter(select, (where_added ? " AND a.puid" : " WHERE a.puid"), NULL, uid_vec);
 
-    logical trans_was_active = true;
-    EIM_select_var_t vars[4];
-    EIM_value_p_t headers = NULL;
-    EIM_row_p_t report = NULL;
-    EIM_row_p_t row;
+    // append_uid_filter() starts the WHERE clause when there is no size predicate.
+    where_added = (select.str().find(" WHERE ") != std::string::npos);
 
-    ERROR_PROTECT
+    std::vector< EIM_select_var_t > vars(cnt + 1);
+    EIM_select_col(&(vars[0]), EIM_puid, "puid", EIM_uid_length + 1, false);
 
-    str_len_val_status(true, "Start ", func, puids.size(), rpt_worked_cnt, rpt_under_cnt, rpt_over_cnt, rpt_success_cnt, rpt_unknown_cnt, rpt_eligible_cnt, rpt_corrected_cnt);
+    for (int k = 0; k < cnt; k++)
+    {
+        EIM_select_col(&(vars[k + 1]), EIM_integer, names[k].c_str(), sizeof(int), false);
+    }
 
-    while (wrk_start_pos < puids.size())
+    EIM_uid_t last_puid = "";
+    int rows = SLV_TABLE_PAGE_ROWS;
+
+    while (rows == SLV_TABLE_PAGE_ROWS)
     {
-        trans_was_active = true;
+        // Key predicate of the pages after the first one.
+        std::string after = "";
+        int nbinds = 0;
+        EIM_bind_var_t bind_vars[1];
 
-        if (!EIM_is_transaction_active())
+        if (last_puid[0] != '\0')
         {
-            trans_was_active = false;
-            EIM_start_transaction();
+            after = (where_added ? " AND a.puid > :1" : " WHERE a.puid > :1");
+            EIM_bind_val(&bind_vars[0], EIM_puid, sizeof(EIM_uid_t), last_puid);
+            nbinds = 1;
         }
 
-        int cor_offset = 0;
-
-        // Calculate the batch size for this sql statement by
-        wrk_batch_size = puids.size() - wrk_start_pos;
+        std::stringstream sql;
 
-        if (wrk_batch_size > rm_slv_batch_size)
+        switch (EIM_dbplat())
         {
-            wrk_batch_size = rm_slv_batch_size;
-        }
+        case EIM_dbplat_oracle:
+            sql << "SELECT * FROM (SELECT ";
 
-        if (wrk_batch_size < 1)
-        {
-            if (wrk_start_pos < puids.size())
+            if ( args->threads > 0 && !args->noparallel_flag )
             {
-                wrk_batch_size = 1;
+                sql << "/*+ parallel(" << args->threads << ") */ ";
             }
-            else
+
+            sql << select.str() << after << " ORDER BY a.puid) WHERE ROWNUM <= " << SLV_TABLE_PAGE_ROWS;
+            break;
+
+        case EIM_dbplat_mssql:
+            sql << "SELECT TOP " << SLV_TABLE_PAGE_ROWS << " " << select.str() << after << " ORDER BY a.puid";
+
+            if ( args->threads > 0 && !args->noparallel_flag )
             {
-                wrk_batch_size = 0;
+                sql << " OPTION (MAXDOP " << args->threads << ")";
             }
+            break;
+
+        default:
+            sql << "SELECT " << select.str() << after << " ORDER BY a.puid FETCH FIRST " << SLV_TABLE_PAGE_ROWS << " ROWS ONLY";
+            break;
         }
 
-        if (wrk_batch_size > 0)
+        EIM_value_p_t headers = NULL;
+        EIM_row_p_t report = NULL;
+
+        ifail = EIM_exec_sql_bind(sql.str().c_str(), &headers, &report, 0, cnt + 1, &vars[0], nbinds, bind_vars);
+        EIM_check_error("Retrieving table string sizes\n");
+
+        rows = 0;
+
+        for (EIM_row_p_t row = report; row != NULL; row = row->next)
         {
-            // Build SQL to retrieve actual data from the database
-            std::stringstream sql;
+            char* tmp_puid = NULL;
+            EIM_find_value(headers, row->line, "puid", EIM_puid, &tmp_puid);
+            rows++;
 
-            sql << "SELECT a.puid puid, a." << cls_col << " data";
-            sql << " FROM " << cls_tbl << " a WHERE a.puid IN (";
+            if (tmp_puid == NULL)
+            {
+                continue;
+            }
+
+            strncpy(last_puid, tmp_puid, EIM_uid_length);
+            last_puid[EIM_uid_length] = '\0';
 
-            for (int i = 0; i < wrk_batch_size; i++)
+            for (int k = 0; k < cnt; k++)
             {
-                if (i > 0)
+                int* tmp_size = NULL;
+                EIM_find_value(headers, row->line, names[k].c_str(), EIM_integer, &tmp_size);
+
+                // The row qualified through another column when this one is below its own threshold.
+                if (tmp_size != NULL && *tmp_size >= min_sizes[k])
                 {
-                    sql << ",";
+                    puids[k].push_back(tmp_puid);
+                    calc_sizes[k].push_back(*tmp_size);
                 }
-
-                sql << "'" << puids[wrk_start_pos++] << "'";
             }
+        }
 
-            sql << ")";
-
-            EIM_select_col(&(vars[0]), EIM_puid, "puid", EIM_uid_length + 1, false);
-            EIM_select_col(&(vars[1]), EIM_varchar, "data", wrk_max_len + 1, false);
+        EIM_free_result(headers, report);
+    }
 
-            ifail = EIM_exec_sql_bind(sql.str().c_str(), &headers, &report, 0, 2, vars, 0, NULL);
-            EIM_check_error("Retrieving string data\n");
+    return(ifail);
+}
 
-            if (report != NULL)
-            {
-                for (row = report; row != NULL; row = row->next)
-                {
-                    rpt_worked_cnt++;
+/*------------------------------------------------------------------------
+** String length validation key staging.
+** The candidate keys of an attribute are numbered 1..n into RM1_SLV_KEYS so that
+** each batch is read with the same statement text, bound to a range of rn values,
+** rather than with a literal IN list. This way the batch size is limited only by memory.
+** ----------------------------------------------------------------------- */
+static char* tbl_slv_keys = NULL;
+static const char* idx_slv_keys = "RM1_I_SLV_KEYS";
 
-                    char* tmp_puid = NULL;
-                    EIM_find_value(headers, row->line, "puid", EIM_puid, &tmp_puid);
+/*
+** Creates RM1_SLV_KEYS on first use, otherwise empties it.
+*/
+static void SLV_create_keys()
+{
+    if (tbl_slv_keys == NULL)
+    {
+        int num_cols = 3;
+        const char* col_names[] = { "rn", "puid", "pseq" };
+        int col_types[]         = { POM_int, POM_string, POM_int };
+        int col_widths[]        = { sizeof(int), EIM_uid_length, sizeof(int) };
 
-                    if (tmp_puid == NULL)
-                    {
-                        rpt_unknown_cnt++;
-                        continue;
-                    }
+        int lfail = POM_create_table(POM_TEMPORARY_TABLE, "RM1_", "SLV_KEYS", num_cols, col_names, col_types, col_widths, POM_TT_CLEAR_ROWS_EOS, &tbl_slv_keys);
 
-                    char* tmp_data = NULL;
-                    int str_len = 0;
-                    logical correction_required = false;
+        if (lfail != OK)
+        {
+            tbl_slv_keys = NULL;
+            ERROR_raise(ERROR_line, lfail, "Unable to create temporary table for RM1_SLV_KEYS (ifail = %d)", lfail);
+        }
 
-                    EIM_find_value(headers, row->line, "data", EIM_varchar, &tmp_data);
+        RUB_create_temporary_table_index(idx_slv_keys, tbl_slv_keys, "rn");
+    }
+    else
+    {
+        POM_clear_table(tbl_slv_keys);
+    }
+}
 
-                    if (tmp_data != NULL)
-                    {
-                        str_len = strlen(tmp_data);
+/*
+** Drops the index of RM1_SLV_KEYS and leaves the table to the session drop list.
+*/
+static void SLV_release_keys()
+{
+    if (tbl_slv_keys == NULL)
+    {
+        return;
+    }
 
-                        if (max_size < str_len)
-                        {
-                            correction_required = true;
-                            rpt_eligible_cnt++;
-                            rpt_under_cnt++;
-                        }
-                        else if (max_size > str_len)
-                        {
-                            correction_required = false;
-                            rpt_over_cnt++;
-                        }
-                        else
-                        {
-                            correction_required = false;
-                            rpt_success_cnt++;
-                        }
-                    }
-                    else
-                    {
-                        correction_required = false;
-                        rpt_unknown_cnt++;
-                    }
+    RUB_drop_temporary_table_index(idx_slv_keys, tbl_slv_keys);
 
-                    if (correction_required)
-                    {
-                        // resolves coverity defect 506006 : String Overflow
-                        if (sizeof(cor_puids[cor_offset]) > strlen(tmp_puid))
-                        {
-                            strcpy(cor_puids[cor_offset], tmp_puid);
-                        }
-                        else
-                        {
-                            ERROR_internal(ERROR_line, "Size not enough to copy '%s' ", tmp_puid);
-                        }
+    POM_add_table_name_to_session_drop_table_list(POM_TEMPORARY_TABLE, tbl_slv_keys);
+    tbl_slv_keys = NULL;
+}
 
-                        cor_lens[cor_offset] = str_len;
-                        cor_offset++;
-                    }
-                }
-                EIM_free_result(headers, report);
-                report = NULL;
-                headers = NULL;
-            }
+/*
+** Replaces the staged keys with puids (and seqs when not NULL), rn follows the vector order.
+*/
+static void SLV_stage_keys(std::vector< std::string > &puids, std::vector< int > *seqs)
+{
+    SLV_create_keys();
 
-            if (cor_offset > 0 && DDS_is_pom_parameter_enabled("RM_STR_LEN_LOG_BAD_UIDS", true))
-            {
-                int counter = 0;
+    int size = (int)puids.size();
 
-                do
-                {
-                    {
-                        std::stringstream msg;
-                        msg << "\nreference_manager -str_len_val -u=user -p=password -g=dba -from=" << cls << ":" << attr << " -commit";
+    if (size < 1)
+    {
+        return;
+    }
 
-                        for (int i = 0; i < 20 && counter < cor_offset; i++, counter++)
-                        {
-                            msg << " -uid=" << (const char*)(cor_puids[counter]);
-                        }
-                        msg << "\n";
+    int batch_size = EIM_get_max_insert_size();
 
-                        logger()->printf(msg.str().c_str());
-                    }
-                } while (counter < cor_offset);
-            }
+    if (batch_size < 1)
+    {
+        batch_size = EIM_ARRAY_MAX_SIZE;
+    }
 
-            if (cor_offset > 0 && args->commit_flag)
-            {
-                // Truncate strings ... remove a few characters... most of the time one (1) character. 
-                ifail = truncate_strings(cls_tbl, cls_col, max_size, cor_puids, cor_lens, cor_offset);
-                rpt_corrected_cnt += cor_offset;
-            }
-        }
+    if (batch_size > size)
+    {
+        batch_size = size;
+    }
 
-        str_len_val_status(false, NULL, func, puids.size(), rpt_worked_cnt, rpt_under_cnt, rpt_over_cnt, rpt_success_cnt, rpt_unknown_cnt, rpt_eligible_cnt, rpt_corrected_cnt);
+    int*       bnd_rns = (int*)SM_alloc(sizeof(int) * batch_size);
+    EIM_uid_t* bnd_uids = (EIM_uid_t*)SM_alloc(sizeof(EIM_uid_t) * batch_size);
+    int*       bnd_seqs = (int*)SM_alloc(sizeof(int) * batch_size);
 
-        if (!trans_was_active)
+    EIM_bind_array_value_p_t bvs[3];
+    for (int b = 0; b < 3; b++)
+    {
+        bvs[b] = static_cast<EIM_bind_array_value_p_t>(SM_alloc(sizeof(EIM_bind_array_value_t)));
+        bvs[b]->array_size = 0;
+        bvs[b]->ind = (short *)SM_calloc(batch_size, sizeof(short));
+    }
+
+    bvs[0]->type = EIM_integer;
+    bvs[0]->len = sizeof(int);
+    bvs[0]->value = bnd_rns;
+
+    bvs[1]->type = EIM_puid;
+    bvs[1]->len = sizeof(EIM_uid_t);
+    bvs[1]->value = bnd_uids;
+
+    bvs[2]->type = EIM_integer;
+    bvs[2]->len = sizeof(int);
+    bvs[2]->value = bnd_seqs;
+
+    char* sql = SM_sprintf("INSERT INTO %s (rn, puid, pseq) VALUES (:1, :2, :3)", tbl_slv_keys);
+
+    logical trans_was_active = EIM_is_transaction_active();
+
+    if (!trans_was_active)
+    {
+        EIM_start_transaction();
+    }
+
+    int i = 0;
+
+    while (i < size)
+    {
+        int this_batch = (size - i < batch_size ? size - i : batch_size);
+
+        for (int k = 0; k < this_batch; k++)
         {
-            EIM_commit_transaction("validate_long_string_sizes()");
+            bnd_rns[k] = i + k + 1;
+            strncpy(bnd_uids[k], puids[i + k].c_str(), sizeof(EIM_uid_t) - 1);
+            bnd_uids[k][sizeof(EIM_uid_t) - 1] = '\0';
+            bnd_seqs[k] = (seqs == NULL ? 0 : (*seqs)[i + k]);
         }
-    }
 
-    ERROR_RECOVER
+        for (int b = 0; b < 3; b++)
+        {
+            bvs[b]->array_size = this_batch;
+        }
 
-    const std::string msg("EXCEPTION: See syslog for additional details.");
-    cons_out(msg);
+        EIM_exec_imm_array_bind(sql, "SLV_stage_keys(): staging keys", this_batch, 3, bvs);
+        EIM_check_error("SLV_stage_keys(): staging keys");
+
+        i = i + this_batch;
+    }
 
     if (!trans_was_active)
     {
-        EIM__clear_transaction(ERROR_ask_failure_code());
-        ERROR_raise(ERROR_line, EIM_ask_abort_code(), "Failed to execute the query\n");
+        EIM_commit_transaction("SLV_stage_keys()");
     }
-    else
+
+    SM_free(sql);
+
+    for (int b = 0; b < 3; b++)
     {
-        ERROR_reraise();
+        SM_free(bvs[b]->ind);
+        SM_free(bvs[b]);
     }
-    ERROR_END
 
-    *bad_count += rpt_eligible_cnt;
-    str_len_val_status(true, "Final ", func, puids.size(), rpt_worked_cnt, rpt_under_cnt, rpt_over_cnt, rpt_success_cnt, rpt_unknown_cnt, rpt_eligible_cnt, rpt_corrected_cnt);
-    return(ifail);
+    SM_free(bnd_seqs);
+    SM_free(bnd_uids);
+    SM_free(bnd_rns);
+}
+
+/*
+** Replaces the staged keys with the puid and pseq columns of select_sql, numbered in
+** key order, and returns the number of keys staged.
+*/
+static int SLV_stage_select(const std::string &select_sql)
+{
+    SLV_create_keys();
+
+    std::stringstream sql;
+    sql << "INSERT INTO " << tbl_slv_keys << " (rn, puid, pseq) ";
+    sql << "SELECT ROW_NUMBER() OVER (ORDER BY x.puid, x.pseq), x.puid, x.pseq FROM (" << select_sql << ") x";
+
+    return RUB_dml_or_ddl(sql.str().c_str());
+}
+
+/*
+** Binds the rn range of the batch that starts at the zero based key position start_pos.
+*/
+static void SLV_bind_key_range(EIM_bind_var_t *bind_vars, int *first_rn, int *last_rn, int start_pos, int batch_size)
+{
+    *first_rn = start_pos;
+    *last_rn = start_pos + batch_size;
+
+    EIM_bind_val(&bind_vars[0], EIM_integer, sizeof(int), first_rn);
+    EIM_bind_val(&bind_vars[1], EIM_integer, sizeof(int), last_rn);
+}
+
+/*
+** Number of characters read per piece by SLV_piece_lens(). A piece of up to rm_slv_max_len
+** bytes is a quarter of that in characters, allowing for four byte UTF-8 characters.
+** SUBSTR() of a CLOB is a CLOB on Oracle, so the piece is not held to the 4000 bytes
+** of a VARCHAR2.
+*/
+static int SLV_piece_chars(int max_len)
+{
+    int chars = max_len / 4;
+
+    if (chars < 1)
+    {
+        chars = 1;
+    }
+
+    return chars;
 }
 
+static const int SLV_PIECE_RNS_PER_STMT = 1000;  // Maximum number of keys in the IN list of one piece statement (Oracle limit).
+
 /*------------------------------------------------------------------------
-** Truncate strings to fit within max size.
+** Measures the long strings of the keys numbered first_rn + 1 to last_rn in
+** RM1_SLV_KEYS without fetching any of them whole. Each pass reads the next
+** piece_chars characters of the strings that are still unfinished, listed by rn,
+** so the fetch buffer is fixed at one piece per key no matter how long the strings
+** are. A piece of fewer bytes than piece_chars ends its string.
+** The byte length of the pieces is summed into lens, indexed by rn - first_rn - 1;
+** a string with a piece that is not well formed UTF-8 gets the length -1.
 ** ----------------------------------------------------------------------- */
-static int truncate_strings(const char *tbl, const char *col, int max_size, EIM_uid_t *uids, int* ints, int size)
+static int SLV_piece_lens(const char *att_tbl, const char *att_col, logical is_vla, int first_rn, int last_rn, int piece_chars, int piece_len, std::vector< int > &lens)
 {
     int ifail = OK;
+    int offset = 1;
+    EIM_select_var_t vars[3];
+    EIM_bind_var_t bind_vars[2];
+    EIM_value_p_t headers = NULL;
+    EIM_row_p_t report = NULL;
+    EIM_row_p_t row;
+    std::vector< int > unfinished;
 
-    if (size < 1)
+    lens.assign(last_rn - first_rn, 0);
+
+    for (int rn = first_rn + 1; rn <= last_rn; rn++)
     {
-        return(ifail);
+        unfinished.push_back(rn);
     }
 
-    const int maxUpdateSize = EIM_get_max_insert_size();
-    int*        adj = (int*)SM_alloc(sizeof(int) * (size + 1));
-    int         batch_size = 0;
-    EIM_uid_t*  uid_ptr = uids;
-    int*        int_ptr = adj;
+    EIM_bind_val(&bind_vars[0], EIM_integer, sizeof(int), &offset);
+    EIM_bind_val(&bind_vars[1], EIM_integer, sizeof(int), &piece_chars);
 
-    if (maxUpdateSize < size)
-    {
-        batch_size = maxUpdateSize;
-        if (batch_size < 1)
-            batch_size = EIM_ARRAY_MAX_SIZE;
-    }
-    else
-    {
-        batch_size = size;
-    }
+    EIM_select_col(&(vars[0]), EIM_integer, "rn", sizeof(int), false);
+    EIM_select_col(&(vars[1]), EIM_puid, "puid", EIM_uid_length + 1, false);
+    EIM_select_col(&(vars[2]), EIM_varchar, "data", piece_len, false);
 
-    // Calculate the number of characters we want to truncate. 
+    while (!unfinished.empty())
     {
-        int  rm_slv_max_bytes_per_char = 4;             // UTF-8 we use 4. The divisor value for calculation of additional characters to be removed. 
-        rm_slv_max_bytes_per_char = DDS_ask_pom_parameter_int("rm_slv_max_bytes_per_char", rm_slv_max_bytes_per_char);
-        int adjval = 0;
+        std::vector< int > next;
 
-        for (int i = 0; i < size; i++)
+        for (size_t first = 0; first < unfinished.size(); first += SLV_PIECE_RNS_PER_STMT)
         {
-            if (ints[i] <= max_size)
+            size_t last = std::min(unfinished.size(), first + SLV_PIECE_RNS_PER_STMT);
+            std::stringstream sql;
+
+            sql << "SELECT k.rn rn, k.puid puid, " << db_substr_fun() << "(a." << att_col << ", :1, :2) data";
+            sql << " FROM " << att_tbl << " a, " << tbl_slv_keys << " k WHERE a.puid = k.puid";
+            if (is_vla)
             {
-                adj[i] = 0;
-                continue;
+                sql << " AND a.pseq = k.pseq";
             }
-
-            adj[i] = 1;
-
-            if (rm_slv_max_bytes_per_char > 0)
+            sql << " AND k.rn IN (";
+            for (size_t i = first; i < last; i++)
             {
-                adjval = ints[i] - max_size;
-                adjval--;
-
-                adjval = adjval / rm_slv_max_bytes_per_char;
-                adj[i] = adjval + 1;
+                sql << (i > first ? "," : "") << unfinished[i];
             }
-        }
-    }
+            sql << ")";
 
-    int i = 0;
-    int this_batch = size;
-    this_batch = this_batch % batch_size;
+            ifail = EIM_exec_sql_bind(sql.str().c_str(), &headers, &report, 0, 3, vars, 2, bind_vars);
+            EIM_check_error("Retrieving long-string pieces\n");
 
-    if (this_batch == 0)
-    {
-        this_batch = batch_size;
-    }
+            for (row = report; row != NULL; row = row->next)
+            {
+                int* tmp_rn = NULL;
+                char* tmp_puid = NULL;
+                char* tmp_data = NULL;
 
-    while (i < size)
-    {
+                EIM_find_value(headers, row->line, "rn", EIM_integer, &tmp_rn);
+                EIM_find_value(headers, row->line, "puid", EIM_puid, &tmp_puid);
+                EIM_find_value(headers, row->line, "data", EIM_varchar, &tmp_data);
 
-        for (int j = 0; j < this_batch; j++)
-        {
-            char* sql = NULL;
+                if (tmp_rn != NULL && tmp_data != NULL && *tmp_rn > first_rn && *tmp_rn <= last_rn)
+                {
+                    int str_len = 0;
+                    int* len = &lens[*tmp_rn - first_rn - 1];
 
-            sql = SM_sprintf( "UPDATE %s SET %s = %s(%s,1,(%s(%s) - %d)) WHERE puid = '%s'", tbl, col, db_substr_fun(), col, db_char_len_fun(), col, *( int_ptr + i + j ), ( uid_ptr + i + j ) );
-    
-            // Do update
-            ifail = EIM_exec_imm_array_bind(sql, "truncate_strings(): truncating strings", 1, 0, NULL);
-            EIM_check_error("truncate_strings(): truncating strings");
+                    // A string with a malformed piece keeps the length -1 (unknown).
+                    if (!slv_data_len(tmp_data, tmp_puid, &str_len))
+                    {
+                        *len = -1;
+                    }
+                    else if (*len >= 0)
+                    {
+                        *len += str_len;
 
-            SM_free(sql);
-        }
+                        // Every character takes at least one byte, a shorter piece is the last one.
+                        if (str_len >= piece_chars)
+                        {
+                            next.push_back(*tmp_rn);
+                        }
+                    }
+                }
+            }
 
-        i = i + this_batch;
-        this_batch = batch_size;
-    }
+            EIM_free_result(headers, report);
+            report = NULL;
+            headers = NULL;
+        }
 
-    if (i != size)
-    {
-        ERROR_raise(ERROR_line, POM_internal_error, "validate_long_string_sizes(): Not all data written to %s table, missing at least %d records. (%d)", tbl, size - i, ifail);
+        unfinished.swap(next);
+        offset += piece_chars;
     }
 
-    SM_free(adj);
     return(ifail);
 }
 
 /*------------------------------------------------------------------------
-** Retrieves the calcualted sizes for VLA POM_string attributes.
+** Client-side counterpart of get_string_sizes() and get_vla_string_sizes().
+** The keys that pass slv_client_prefilter() are numbered into RM1_SLV_KEYS, the
+** strings are then fetched a page of keys at a time and measured with
+** slv_utf8_measure(). Keys whose byte length reaches the same threshold as the
+** server-side query, or whose data is not well formed UTF-8, are returned as candidates.
 ** ----------------------------------------------------------------------- */
-static int get_vla_string_sizes(const char *att_tbl, const char *att_col, int max_size, const char* uid, std::vector< std::string >  *uid_vec, std::vector< std::string > &puids, std::vector< int > &seqs, std::vector< int > &calc_sizes)
+static int get_client_string_sizes(const char *tbl, const char *col, logical is_vla, int max_size, const char* uid, std::vector< std::string >  *uid_vec, std::vector< std::string > &puids, std::vector< int > *seqs, std::vector< int > &calc_sizes)
 {
     int ifail = OK;
+    int rm_slv_batch_size = 65500;           // Number of records fetched per page
+    int rm_slv_max_bytes_per_char = 4;       // UTF-8 we use 4.
+    int rm_slv_fixed_exp = 100;              // Additional fixed byte expansion
+    int rm_slv_max_mem_m = 6000;             // Maximum memory to be used within each page
+    int64_t rm_slv_meg = 1024 * 1024;        // Megabyte
 
-    if ( EIM_dbplat() != EIM_dbplat_mssql && EIM_dbplat() != EIM_dbplat_oracle )
-    {
-        ERROR_raise(ERROR_line, POM_internal_error, "Functionality is not supported for RDBMSs other than MS SQL Server and Oracle.");
-    }
-
-    int  rm_slv_max_bytes_per_char = 4;     // UTF-8 we use 4. Used to calculate minimum length before we consider it a possible problem. 
+    rm_slv_batch_size = DDS_ask_pom_parameter_int("rm_slv_batch_size", rm_slv_batch_size);
     rm_slv_max_bytes_per_char = DDS_ask_pom_parameter_int("rm_slv_max_bytes_per_char", rm_slv_max_bytes_per_char);
+    rm_slv_fixed_exp = DDS_ask_pom_parameter_int("rm_slv_fixed_exp", rm_slv_fixed_exp);
+    rm_slv_max_mem_m = DDS_ask_pom_parameter_int("rm_slv_max_mem_m", rm_slv_max_mem_m);
 
-    int storge_bytes_per_ascii_char = 2;    // For unicode there are two bytes for every ascii character
+    // The client-side platforms store one byte per ASCII character.
+    int min_bytes = ( rm_slv_max_bytes_per_char > 0 ? max_size / rm_slv_max_bytes_per_char : 0 );
 
-    if (!EIM_unicode_enabled())
+    // A column of max_size characters holds at most four bytes per character.
+    int buf_len = ( max_size * 4 ) + rm_slv_fixed_exp + 1;
+
+    int64_t temp_cnt = rm_slv_meg * rm_slv_max_mem_m / buf_len;
+
+    if (temp_cnt < rm_slv_batch_size)
     {
-        storge_bytes_per_ascii_char = 1;    // If not unicode we assume UTF-8, in which case we have 1 storage byte per ascii character
+        rm_slv_batch_size = (int)temp_cnt;
+    }
+
+    if (rm_slv_batch_size < 1)
+    {
+        rm_slv_batch_size = 1;
     }
 
     puids.clear();
-    seqs.clear();
     calc_sizes.clear();
 
+    if (seqs != NULL)
+    {
+        seqs->clear();
+    }
+
     logical trans_was_active = true;
     EIM_select_var_t vars[3];
+    EIM_bind_var_t bind_vars[2];
+    int first_rn = 0;
+    int last_rn = 0;
     EIM_value_p_t headers = NULL;
     EIM_row_p_t report = NULL;
     EIM_row_p_t row;
 
     ERROR_PROTECT
 
-        if (!EIM_is_transaction_active())
-        {
-            trans_was_active = false;
-            EIM_start_transaction();
-        }
+    if (!EIM_is_transaction_active())
+    {
+        trans_was_active = false;
+        EIM_start_transaction();
+    }
 
-    std::stringstream sql;
-    logical where_added = false;
+    std::stringstream keys;
+    keys << "SELECT a.puid puid, " << (is_vla ? "a.pseq" : "0") << " pseq FROM " << tbl << " a";
+    keys << " WHERE " << slv_client_prefilter(std::string("a.") + col, min_bytes);
+    append_uid_filter(keys, " AND a.puid", uid, uid_vec);
 
-    sql << "SELECT a.puid puid, a.pseq pseq, " << db_byte_len_fun() << "(a." << att_col << ") calc_size";
-    sql << " FROM " << att_tbl << " a";
+    int key_cnt = SLV_stage_select(keys.str());
 
-    if ( rm_slv_max_bytes_per_char > 0 )
+    std::stringstream sql;
+    sql << "SELECT a.puid puid, " << (is_vla ? "a.pseq" : "0") << " pseq, a." << col << " data";
+    sql << " FROM " << tbl << " a, " << tbl_slv_keys << " k WHERE a.puid = k.puid";
+
+    if (is_vla)
     {
-        sql << " WHERE " << db_byte_len_fun() << "(a." << att_col << ") >= " << (int)( ( max_size * storge_bytes_per_ascii_char ) / rm_slv_max_bytes_per_char );
-        where_added = true;
+        sql << " AND a.pseq = k.pseq";
     }
 
-    if (uid != NULL || (uid_vec != NULL && uid_vec->size() > 0))
+    sql << " AND k.rn > :1 AND k.rn <= :2";
+
+    for (int pos = 0; pos < key_cnt; pos += rm_slv_batch_size)
     {
-        if (!where_added)
-        {
-            sql << " WHERE a.puid IN (";
-            where_added = true;
-        }
-        else
-        {
-            sql << " AND a.puid IN (";
-        }
+        SLV_bind_key_range(bind_vars, &first_rn, &last_rn, pos, rm_slv_batch_size);
 
-        int inc_cnt = 0;
+        EIM_select_col(&(vars[0]), EIM_puid, "puid", EIM_uid_length + 1, false);
+        EIM_select_col(&(vars[1]), EIM_integer, "pseq", sizeof(int), false);
+        EIM_select_col(&(vars[2]), EIM_varchar, "data", buf_len, false);
 
-        if (uid != NULL)
-        {
-            sql << "'" << uid << "'";
-            inc_cnt++;
-        }
+        ifail = EIM_exec_sql_bind(sql.str().c_str(), &headers, &report, 0, 3, vars, 2, bind_vars);
+        EIM_check_error("Retrieving string data for client-side sizing\n");
 
-        if (uid_vec != NULL && uid_vec->size() > 0)
+        for (row = report; row != NULL; row = row->next)
         {
-            for (int i = 0; i < uid_vec->size(); i++)
+            char* tmp_puid = NULL;
+            char* tmp_data = NULL;
+            int*  tmp_seq = NULL;
+
+            EIM_find_value(headers, row->line, "puid", EIM_puid, &tmp_puid);
+            EIM_find_value(headers, row->line, "pseq", EIM_integer, &tmp_seq);
+            EIM_find_value(headers, row->line, "data", EIM_varchar, &tmp_data);
+
+            if (tmp_puid == NULL || tmp_data == NULL)
+            {
+                continue;
+            }
+
+            slv_utf8_len_t m;
+            slv_utf8_measure(tmp_data, strlen(tmp_data), &m);
+
+            if ((int)m.bytes >= min_bytes || !m.valid)
             {
-                if (inc_cnt > 0)
+                puids.push_back(tmp_puid);
+                calc_sizes.push_back((int)m.bytes);
+
+                if (seqs != NULL)
                 {
-                    sql << ",";
+                    seqs->push_back(tmp_seq != NULL ? *tmp_seq : 0);
                 }
-
-                sql << "'" << (*uid_vec)[i] << "'";
-                inc_cnt++;
             }
         }
-        sql << ")";
-    }
 
-    sql << " ORDER BY puid, pseq, calc_size ASC";
+        EIM_free_result(headers, report);
+        report = NULL;
+        headers = NULL;
+    }
 
-    EIM_select_col(&(vars[0]), EIM_puid, "puid", EIM_uid_length + 1, false);
-    EIM_select_col(&(vars[1]), EIM_integer, "pseq", sizeof(int), false);
-    EIM_select_col(&(vars[2]), EIM_integer, "calc_size", sizeof(int), false);
+    if (!trans_was_active)
+    {
+        EIM_commit_transaction("get_client_string_sizes()");
+    }
 
-    ifail = EIM_exec_sql_bind(sql.str().c_str(), &headers, &report, 0, 3, vars, 0, NULL);
-    EIM_check_error("Retrieving string sizes\n");
+    ERROR_RECOVER
 
-    if (report != NULL)
+    const std::string msg("EXCEPTION: See syslog for additional details.");
+    cons_out(msg);
+
+    if (!trans_was_active)
     {
-        for (row = report; row != NULL; row = row->next)
+        EIM__clear_transaction(ERROR_ask_failure_code());
+        ERROR_raise(ERROR_line, EIM_ask_abort_code(), "Failed to execute the query\n");
+    }
+    else
+    {
+        ERROR_reraise();
+    }
+    ERROR_END
+
+    return(ifail);
+}
+
+/*------------------------------------------------------------------------
+** Client-side counterpart of get_table_string_sizes(). The keys of the class table
+** with a column that passes slv_client_prefilter() are numbered into RM1_SLV_KEYS
+** once, then every column is fetched with the same
+** page of keys and measured with slv_utf8_measure(), so the table is staged and
+** read once for all of its string columns rather than once per column.
+** ----------------------------------------------------------------------- */
+static int get_client_table_string_sizes(const char *cls_tbl, std::vector< std::string > &cols, std::vector< int > &max_sizes, std::vector< std::string > *uid_vec, std::vector< std::vector< std::string > > &puids, std::vector< std::vector< int > > &calc_sizes)
+{
+    int ifail = OK;
+    int cnt = (int)cols.size();
+    int rm_slv_batch_size = 65500;           // Number of records fetched per page
+    int rm_slv_max_bytes_per_char = 4;       // UTF-8 we use 4.
+    int rm_slv_fixed_exp = 100;              // Additional fixed byte expansion
+    int rm_slv_max_mem_m = 6000;             // Maximum memory to be used within each page
+    int64_t rm_slv_meg = 1024 * 1024;        // Megabyte
+
+    rm_slv_batch_size = DDS_ask_pom_parameter_int("rm_slv_batch_size", rm_slv_batch_size);
+    rm_slv_max_bytes_per_char = DDS_ask_pom_parameter_int("rm_slv_max_bytes_per_char", rm_slv_max_bytes_per_char);
+    rm_slv_fixed_exp = DDS_ask_pom_parameter_int("rm_slv_fixed_exp", rm_slv_fixed_exp);
+    rm_slv_max_mem_m = DDS_ask_pom_parameter_int("rm_slv_max_mem_m", rm_slv_max_mem_m);
+
+    std::vector< int > min_bytes(cnt, 0);
+    std::vector< int > buf_lens(cnt, 0);
+    std::vector< std::string > names(cnt);
+    int64_t row_len = EIM_uid_length + 1;
+
+    for (int k = 0; k < cnt; k++)
+    {
+        std::stringstream name;
+        name << "s" << k;
+        names[k] = name.str();
+
+        // The client-side platforms store one byte per ASCII character, and a
+        // column of max_size characters holds at most four bytes per character.
+        min_bytes[k] = ( rm_slv_max_bytes_per_char > 0 ? max_sizes[k] / rm_slv_max_bytes_per_char : 0 );
+        buf_lens[k] = ( max_sizes[k] * 4 ) + rm_slv_fixed_exp + 1;
+        row_len += buf_lens[k];
+    }
+
+    int64_t temp_cnt = rm_slv_meg * rm_slv_max_mem_m / row_len;
+
+    if (temp_cnt < rm_slv_batch_size)
+    {
+        rm_slv_batch_size = (int)temp_cnt;
+    }
+
+    if (rm_slv_batch_size < 1)
+    {
+        rm_slv_batch_size = 1;
+    }
+
+    logical trans_was_active = true;
+    std::vector< EIM_select_var_t > vars(cnt + 1);
+    EIM_bind_var_t bind_vars[2];
+    int first_rn = 0;
+    int last_rn = 0;
+    EIM_value_p_t headers = NULL;
+    EIM_row_p_t report = NULL;
+
+    ERROR_PROTECT
+
+    if (!EIM_is_transaction_active())
+    {
+        trans_was_active = false;
+        EIM_start_transaction();
+    }
+
+    std::stringstream keys;
+    keys << "SELECT a.puid puid, 0 pseq FROM " << cls_tbl << " a WHERE (";
+
+    for (int k = 0; k < cnt; k++)
+    {
+        keys << (k > 0 ? " OR " : "") << slv_client_prefilter(std::string("a.") + cols[k], min_bytes[k]);
+    }
+
+    keys << ")";
+    append_uid_filter(keys, " AND a.puid", NULL, uid_vec);
+
+    int key_cnt = SLV_stage_select(keys.str());
+
+    std::stringstream sql;
+    sql << "SELECT a.puid puid";
+
+    for (int k = 0; k < cnt; k++)
+    {
+        sql << ", a." << cols[k] << " " << names[k];
+    }
+
+    sql << " FROM " << cls_tbl << " a, " << tbl_slv_keys << " k WHERE a.puid = k.puid AND k.rn > :1 AND k.rn <= :2";
+
+    for (int pos = 0; pos < key_cnt; pos += rm_slv_batch_size)
+    {
+        SLV_bind_key_range(bind_vars, &first_rn, &last_rn, pos, rm_slv_batch_size);
+
+        EIM_select_col(&(vars[0]), EIM_puid, "puid", EIM_uid_length + 1, false);
+
+        for (int k = 0; k < cnt; k++)
         {
-            char* tmp_puid = NULL;
-            EIM_find_value(headers, row->line, "puid", EIM_puid, &tmp_puid);
-            puids.push_back(tmp_puid);
+            EIM_select_col(&(vars[k + 1]), EIM_varchar, names[k].c_str(), buf_lens[k], true);
+        }
 
-            int* tmp_seq = NULL;
-            EIM_find_value(headers, row->line, "pseq", EIM_integer, &tmp_seq);
-            seqs.push_back(*tmp_seq);
+        ifail = EIM_exec_sql_bind(sql.str().c_str(), &headers, &report, 0, cnt + 1, &vars[0], 2, bind_vars);
+        EIM_check_error("Retrieving table string data for client-side sizing\n");
 
-            int* tmp_size = NULL;
-            EIM_find_value(headers, row->line, "calc_size", EIM_integer, &tmp_size);
+        for (EIM_row_p_t row = report; row != NULL; row = row->next)
+        {
+            char* tmp_puid = NULL;
+            EIM_find_value(headers, row->line, "puid", EIM_puid, &tmp_puid);
 
-            if (tmp_size != NULL)
+            if (tmp_puid == NULL)
             {
-                calc_sizes.push_back(*tmp_size);
+                continue;
             }
-            else
+
+            for (int k = 0; k < cnt; k++)
             {
-                calc_sizes.push_back(0);
+                char* tmp_data = NULL;
+                EIM_find_value(headers, row->line, names[k].c_str(), EIM_varchar, &tmp_data);
+
+                if (tmp_data == NULL)
+                {
+                    continue;
+                }
+
+                slv_utf8_len_t m;
+                slv_utf8_measure(tmp_data, strlen(tmp_data), &m);
+
+                if ((int)m.bytes >= min_bytes[k] || !m.valid)
+                {
+                    puids[k].push_back(tmp_puid);
+                    calc_sizes[k].push_back((int)m.bytes);
+                }
             }
         }
+
+        EIM_free_result(headers, report);
+        report = NULL;
+        headers = NULL;
     }
-    EIM_free_result(headers, report);
-    report = NULL;
-    headers = NULL;
 
     if (!trans_was_active)
     {
-        EIM_commit_transaction("get_vla_string_sizes()");
+        EIM_commit_transaction("get_client_table_string_sizes()");
     }
 
     ERROR_RECOVER
@@ -10316,21 +12304,20 @@ static int get_vla_string_sizes(const char *att_tbl, const char *att_col, int ma
 }
 
 /*------------------------------------------------------------------------
-** Validate the size of data in a VLA POM_string attribute against
+** Validate the size of data in a POM_string attribute against
 ** the maximum size of the field.
 ** We'll assume that if the stored data length is less than 1/4 of the max data length
 ** that it will happily fit within the max buffer size when read from the database.
 ** ----------------------------------------------------------------------- */
-static int validate_vla_string_sizes(const char* func, const char* cls, const char* attr, const char *cls_tbl, const char *cls_col, int max_size, std::vector< std::string > &puids, std::vector< int > &seqs, std::vector< int > &calc_sizes, int* bad_count)
+static int validate_string_sizes(const char* func, const char* cls, const char* attr, const char *cls_tbl, const char *cls_col, int max_size, std::vector< std::string > &puids, std::vector< int > &calc_sizes, int* bad_count)
 {
     int ifail = OK;
     // RM_SLV_ stands for Reference Manager String Length Validation
     int rm_slv_batch_size = 65500;       // Number of records processed per batch
-    int rm_slv_max_len = 100000;         // Maximum length of records within the batch, otherwise one at a time.
     int rm_slv_percent_exp = 30;         // Percentage of expected expansion due to none single byte characters
     int rm_slv_fixed_exp = 100;          // Additional fixed byte expansion to provide additional memory for unforseen expansions...
-    int rm_slv_max_mem_m = 6000;         // Maximum memory to be used within each batch... unit single record processing kicks in.
-    int64_t rm_slv_meg = 1024 * 1024;       // Megabyte
+    int rm_slv_max_mem_m = 6000;         // Maximum memory to be used within each batch... before the batch is shrunk.
+    int64_t rm_slv_meg = 1024 * 1024;    // Megabyte
 
     int rpt_worked_cnt = 0;              // Number of records that were processed
     int rpt_success_cnt = 0;             // Number of records where data length matches the stored length
@@ -10346,34 +12333,17 @@ static int validate_vla_string_sizes(const char* func, const char* cls, const ch
 
                                          // Check configuration values. 
     rm_slv_batch_size = DDS_ask_pom_parameter_int("rm_slv_batch_size", rm_slv_batch_size);
-    rm_slv_max_len = DDS_ask_pom_parameter_int("rm_slv_max_len", rm_slv_max_len);
     rm_slv_percent_exp = DDS_ask_pom_parameter_int("rm_slv_percent_exp", rm_slv_percent_exp);
     rm_slv_fixed_exp = DDS_ask_pom_parameter_int("rm_slv_fixed_exp", rm_slv_fixed_exp);
     rm_slv_max_mem_m = DDS_ask_pom_parameter_int("rm_slv_max_mem_m", rm_slv_max_mem_m);
     EIM_uid_t* cor_puids = NULL;
     int*       cor_lens = NULL;
-    int*       cor_seqs = NULL;
-
-    // Filter to ensure that we output bad uids only once into the syslog. 
-    std::map< std::string, int > dups;
-    std::map< std::string, int >::iterator it;
-
-    // As we are currently not using ENQ or temporary tables we will limit the batch size to 400 to limit the length of the SQL statement.
-    if (rm_slv_batch_size > 400)
-    {
-        rm_slv_batch_size = 400;
-    }
 
     wrk_max_len = max_size + ((max_size * rm_slv_percent_exp) / 100) + rm_slv_fixed_exp;
 
-    if (rm_slv_max_len < wrk_max_len)
-    {
-        rm_slv_batch_size = 1;
-    }
-
+    // Every row gets a buffer of the column width, so the batch is bounded by memory alone.
     // Make sure we limit the batch size so that we don't use significantly more memory than the maximum configured.
     int64_t temp_cnt = rm_slv_meg * rm_slv_max_mem_m / wrk_max_len;
-
     if (temp_cnt < rm_slv_batch_size)
     {
         rm_slv_batch_size = (int)temp_cnt;
@@ -10390,11 +12360,13 @@ static int validate_vla_string_sizes(const char* func, const char* cls, const ch
     }
 
     cor_puids = (EIM_uid_t*)SM_alloc(sizeof(EIM_uid_t) * (rm_slv_batch_size + 1));
-    cor_seqs = (int*)SM_alloc(sizeof(int) * (rm_slv_batch_size + 1));
     cor_lens = (int*)SM_alloc(sizeof(int) * (rm_slv_batch_size + 1));
 
     logical trans_was_active = true;
-    EIM_select_var_t vars[3];
+    EIM_select_var_t vars[4];
+    EIM_bind_var_t bind_vars[2];
+    int first_rn = 0;
+    int last_rn = 0;
     EIM_value_p_t headers = NULL;
     EIM_row_p_t report = NULL;
     EIM_row_p_t row;
@@ -10403,6 +12375,8 @@ static int validate_vla_string_sizes(const char* func, const char* cls, const ch
 
     str_len_val_status(true, "Start ", func, puids.size(), rpt_worked_cnt, rpt_under_cnt, rpt_over_cnt, rpt_success_cnt, rpt_unknown_cnt, rpt_eligible_cnt, rpt_corrected_cnt);
 
+    SLV_stage_keys(puids, NULL);
+
     while (wrk_start_pos < puids.size())
     {
         trans_was_active = true;
@@ -10440,25 +12414,16 @@ static int validate_vla_string_sizes(const char* func, const char* cls, const ch
             // Build SQL to retrieve actual data from the database
             std::stringstream sql;
 
-            sql << "SELECT a.puid puid, a.pseq pseq, a." << cls_col << " data";
-            sql << " FROM " << cls_tbl << " a WHERE";
-
-            for (int i = 0; i < wrk_batch_size; i++)
-            {
-                if (i > 0)
-                {
-                    sql << " OR";
-                }
+            sql << "SELECT a.puid puid, a." << cls_col << " data";
+            sql << " FROM " << cls_tbl << " a, " << tbl_slv_keys << " k WHERE a.puid = k.puid AND k.rn > :1 AND k.rn <= :2";
 
-                sql << " (a.puid = '" << puids[wrk_start_pos] << "' AND a.pseq = " << seqs[wrk_start_pos] << ")";
-                wrk_start_pos++;
-            }
+            SLV_bind_key_range(bind_vars, &first_rn, &last_rn, wrk_start_pos, wrk_batch_size);
+            wrk_start_pos += wrk_batch_size;
 
             EIM_select_col(&(vars[0]), EIM_puid, "puid", EIM_uid_length + 1, false);
-            EIM_select_col(&(vars[1]), EIM_integer, "pseq", sizeof(int), false);
-            EIM_select_col(&(vars[2]), EIM_varchar, "data", wrk_max_len + 1, false);
+            EIM_select_col(&(vars[1]), EIM_varchar, "data", wrk_max_len + 1, false);
 
-            ifail = EIM_exec_sql_bind(sql.str().c_str(), &headers, &report, 0, 3, vars, 0, NULL);
+            ifail = EIM_exec_sql_bind(sql.str().c_str(), &headers, &report, 0, 2, vars, 2, bind_vars);
             EIM_check_error("Retrieving string data\n");
 
             if (report != NULL)
@@ -10476,31 +12441,15 @@ static int validate_vla_string_sizes(const char* func, const char* cls, const ch
                         continue;
                     }
 
-                    int* tmp_seq = NULL;
-                    EIM_find_value(headers, row->line, "pseq", EIM_integer, &tmp_seq);
-
-                    if (tmp_seq == NULL)
-                    {
-                        rpt_unknown_cnt++;
-                        continue;
-                    }
-
-                    if (tmp_seq == NULL)
-                    {
-                        rpt_unknown_cnt++;
-                        continue;
-                    }
-
                     char* tmp_data = NULL;
                     int str_len = 0;
                     logical correction_required = false;
 
                     EIM_find_value(headers, row->line, "data", EIM_varchar, &tmp_data);
 
-                    if (tmp_data != NULL)
+                    // Data that is not well formed UTF-8 is reported as unknown and is not truncated.
+                    if (tmp_data != NULL && slv_data_len(tmp_data, tmp_puid, &str_len))
                     {
-                        str_len = strlen(tmp_data);
-
                         if (max_size < str_len)
                         {
                             correction_required = true;
@@ -10526,7 +12475,7 @@ static int validate_vla_string_sizes(const char* func, const char* cls, const ch
 
                     if (correction_required)
                     {
-                        // resolves coverity defect 506014 : String Overflow
+                        // resolves coverity defect 506006 : String Overflow
                         if (sizeof(cor_puids[cor_offset]) > strlen(tmp_puid))
                         {
                             strcpy(cor_puids[cor_offset], tmp_puid);
@@ -10536,7 +12485,6 @@ static int validate_vla_string_sizes(const char* func, const char* cls, const ch
                             ERROR_internal(ERROR_line, "Size not enough to copy '%s' ", tmp_puid);
                         }
 
-                        cor_seqs[cor_offset] = *tmp_seq;
                         cor_lens[cor_offset] = str_len;
                         cor_offset++;
                     }
@@ -10552,30 +12500,17 @@ static int validate_vla_string_sizes(const char* func, const char* cls, const ch
 
                 do
                 {
-                    logical valid_uids = false;
                     {
                         std::stringstream msg;
                         msg << "\nreference_manager -str_len_val -u=user -p=password -g=dba -from=" << cls << ":" << attr << " -commit";
 
                         for (int i = 0; i < 20 && counter < cor_offset; i++, counter++)
                         {
-                            std::string temp_uid = cor_puids[counter];
-                            it = dups.find(temp_uid);
-
-                            if (it == dups.end())
-                            {
-                                valid_uids = true;
-                                dups.insert(std::pair< std::string, int>(temp_uid, 0));
-                                msg << " -uid=" << (const char*)(cor_puids[counter]);
-                            }
+                            msg << " -uid=" << (const char*)(cor_puids[counter]);
                         }
                         msg << "\n";
 
-                        if (valid_uids)
-                        {
-                            valid_uids = false;
-                            logger()->printf(msg.str().c_str());
-                        }
+                        logger()->printf(msg.str().c_str());
                     }
                 } while (counter < cor_offset);
             }
@@ -10583,7 +12518,7 @@ static int validate_vla_string_sizes(const char* func, const char* cls, const ch
             if (cor_offset > 0 && args->commit_flag)
             {
                 // Truncate strings ... remove a few characters... most of the time one (1) character. 
-                ifail = truncate_vla_strings(cls_tbl, cls_col, max_size, cor_puids, cor_seqs, cor_lens, cor_offset);
+                ifail = truncate_strings(cls_tbl, cls_col, max_size, cor_puids, cor_lens, cor_offset);
                 rpt_corrected_cnt += cor_offset;
             }
         }
@@ -10592,13 +12527,13 @@ static int validate_vla_string_sizes(const char* func, const char* cls, const ch
 
         if (!trans_was_active)
         {
-            EIM_commit_transaction("validate_vla_string_sizes()");
+            EIM_commit_transaction("validate_long_string_sizes()");
         }
     }
 
     ERROR_RECOVER
 
-        const std::string msg("EXCEPTION: See syslog for additional details.");
+    const std::string msg("EXCEPTION: See syslog for additional details.");
     cons_out(msg);
 
     if (!trans_was_active)
@@ -10618,9 +12553,9 @@ static int validate_vla_string_sizes(const char* func, const char* cls, const ch
 }
 
 /*------------------------------------------------------------------------
-** Truncate vla strings to fit within max size.
+** Truncate strings to fit within max size.
 ** ----------------------------------------------------------------------- */
-static int truncate_vla_strings(const char *tbl, const char *col, int max_size, EIM_uid_t *uids, int* seqs, int* ints, int size)
+static int truncate_strings(const char *tbl, const char *col, int max_size, EIM_uid_t *uids, int* ints, int size)
 {
     int ifail = OK;
 
@@ -10629,14 +12564,26 @@ static int truncate_vla_strings(const char *tbl, const char *col, int max_size,
         return(ifail);
     }
 
+    const int maxUpdateSize = EIM_get_max_insert_size();
     int*        adj = (int*)SM_alloc(sizeof(int) * (size + 1));
+    int         batch_size = 0;
     EIM_uid_t*  uid_ptr = uids;
     int*        int_ptr = adj;
-    int*        seq_ptr = seqs;
+
+    if (maxUpdateSize < size)
+    {
+        batch_size = maxUpdateSize;
+        if (batch_size < 1)
+            batch_size = EIM_ARRAY_MAX_SIZE;
+    }
+    else
+    {
+        batch_size = size;
+    }
 
     // Calculate the number of characters we want to truncate. 
     {
-        int  rm_slv_max_bytes_per_char = 4;             // The divisor value for calculation of additional characters to be removed. 
+        int  rm_slv_max_bytes_per_char = 4;             // UTF-8 we use 4. The divisor value for calculation of additional characters to be removed. 
         rm_slv_max_bytes_per_char = DDS_ask_pom_parameter_int("rm_slv_max_bytes_per_char", rm_slv_max_bytes_per_char);
         int adjval = 0;
 
@@ -10661,58 +12608,110 @@ static int truncate_vla_strings(const char *tbl, const char *col, int max_size,
         }
     }
 
-    for (int i = 0; i < size; i++)
+    // Only the over-length rows are updated, compact them to the front of the bind arrays.
+    EIM_uid_t*  bnd_uids = (EIM_uid_t*)SM_alloc(sizeof(EIM_uid_t) * (size + 1));
+    int         bnd_cnt = 0;
+
+    for (int k = 0; k < size; k++)
     {
-        char* sql = SM_sprintf( "UPDATE %s SET %s = %s(%s,1,(%s(%s) - %d)) WHERE puid = '%s' AND pseq = %d", tbl, col, db_substr_fun(), col, db_char_len_fun(), col, *( int_ptr + i ), ( uid_ptr + i ), *( seq_ptr + i ) );
+        if (adj[k] > 0)
+        {
+            adj[bnd_cnt] = adj[k];
+            memcpy(bnd_uids[bnd_cnt], uid_ptr[k], sizeof(EIM_uid_t));
+            bnd_cnt++;
+        }
+    }
 
-        // Do update
-        ifail = EIM_exec_imm_array_bind(sql, "truncate_strings(): truncating vla strings", 1, 0, NULL);
-        EIM_check_error("truncate_strings(): truncating vla strings");
+    // Allocate an array of pointers to bind array value pointers.
+    EIM_bind_array_value_p_t bvs[2];
+    bvs[0] = static_cast<EIM_bind_array_value_p_t>(SM_alloc(sizeof(EIM_bind_array_value_t)));
+    bvs[1] = static_cast<EIM_bind_array_value_p_t>(SM_alloc(sizeof(EIM_bind_array_value_t)));
 
-        SM_free(sql);
-    }
+    bvs[0]->type = EIM_integer;
+    bvs[0]->len = sizeof(int);
+    bvs[0]->array_size = 0;
+    bvs[0]->ind = (short *)SM_calloc(batch_size, sizeof(short));
+    bvs[0]->value = NULL;
 
-    SM_free(adj);
+    bvs[1]->type = EIM_puid;
+    bvs[1]->len = sizeof(EIM_uid_t);
+    bvs[1]->array_size = 0;
+    bvs[1]->ind = (short *)SM_calloc(batch_size, sizeof(short));
+    bvs[1]->value = NULL;
 
-    return(ifail);
-}
+    // One statement text for every batch, the truncation amount of each row is bound.
+    char* sql = SM_sprintf("UPDATE %s SET %s = %s(%s,1,(%s(%s) - :1)) WHERE puid = :2", tbl, col, db_substr_fun(), col, db_char_len_fun(), col);
 
-/*------------------------------------------------------------------------
-** Retrieves the calcualted sizes for LA (large array) POM_string attributes.
-** ----------------------------------------------------------------------- */
-static int get_la_string_sizes(const char *att_tbl, const char *att_col, int max_size, const char* uid, std::vector< std::string >  *uid_vec, std::vector< std::string > &puids, std::vector< int > &seqs, std::vector< int > &calc_sizes)
-{
-    int ifail = get_vla_string_sizes(att_tbl, att_col, max_size, uid, uid_vec, puids, seqs, calc_sizes);
-    return(ifail);
-}
+    int i = 0;
 
-/*------------------------------------------------------------------------
-** Validate the size of data in a LA (large array) POM_string attribute against
-** the maximum size of the field.
-** We'll assume that if the stored data length is less than 1/4 of the max data length
-** that it will happily fit within the max buffer size when read from the database.
-** ----------------------------------------------------------------------- */
-static int validate_la_string_sizes(const char* cls, const char* attr, const char *cls_tbl, const char *cls_col, int max_size, std::vector< std::string > &puids, std::vector< int > &seqs, std::vector< int > &calc_sizes, int* bad_count)
-{
-    int ifail = validate_vla_string_sizes("Str(LA)", cls, attr, cls_tbl, cls_col, max_size, puids, seqs, calc_sizes, bad_count);
-    return(ifail);
-}
+    while (i < bnd_cnt)
+    {
+        int this_batch = (bnd_cnt - i < batch_size ? bnd_cnt - i : batch_size);
 
-/*------------------------------------------------------------------------
-** Retrieves the calcualted and stored sizes for long string data.
+        bvs[0]->array_size = this_batch;
+        bvs[0]->value = int_ptr + i;
+
+        bvs[1]->array_size = this_batch;
+        bvs[1]->value = bnd_uids + i;
+
+        // Do update
+        ifail = EIM_exec_imm_array_bind(sql, "truncate_strings(): truncating strings", this_batch, 2, bvs);
+        EIM_check_error("truncate_strings(): truncating strings");
+
+        i = i + this_batch;
+
+        bvs[0]->array_size = 0;
+        bvs[0]->value = NULL;
+
+        bvs[1]->array_size = 0;
+        bvs[1]->value = NULL;
+    }
+
+    if (i != bnd_cnt)
+    {
+        ERROR_raise(ERROR_line, POM_internal_error, "truncate_strings(): Not all data written to %s table, missing at least %d records. (%d)", tbl, bnd_cnt - i, ifail);
+    }
+
+    SM_free(sql);
+    SM_free(bvs[0]->ind);
+    SM_free(bvs[1]->ind);
+    SM_free(bvs[0]);
+    SM_free(bvs[1]);
+    SM_free(bnd_uids);
+    SM_free(adj);
+    return(ifail);
+}
+
+/*------------------------------------------------------------------------
+** Retrieves the calcualted sizes for VLA POM_string attributes.
 ** ----------------------------------------------------------------------- */
-static int get_long_string_sizes(const char *cls_tbl, const char *cls_col, const char *att_tbl, const char *att_col, const char* uid, std::vector< std::string >  *uid_vec, std::vector< std::string > &puids, std::vector< int > &calc_sizes, std::vector< int > &stored_sizes)
+static int get_vla_string_sizes(const char *att_tbl, const char *att_col, int max_size, const char* uid, std::vector< std::string >  *uid_vec, std::vector< std::string > &puids, std::vector< int > &seqs, std::vector< int > &calc_sizes)
 {
     int ifail = OK;
-    // onst char *potname = DDS_ask_tname((DDS_class_p_t) OM_ask_class_of_class_id (OM_lookup_class("POM_object")));
+
+    if ( slv_client_side() )
+    {
+        return get_client_string_sizes(att_tbl, att_col, true, max_size, uid, uid_vec, puids, &seqs, calc_sizes);
+    }
+
     if ( EIM_dbplat() != EIM_dbplat_mssql && EIM_dbplat() != EIM_dbplat_oracle )
     {
         ERROR_raise(ERROR_line, POM_internal_error, "Functionality is not supported for RDBMSs other than MS SQL Server and Oracle.");
     }
 
+    int  rm_slv_max_bytes_per_char = 4;     // UTF-8 we use 4. Used to calculate minimum length before we consider it a possible problem. 
+    rm_slv_max_bytes_per_char = DDS_ask_pom_parameter_int("rm_slv_max_bytes_per_char", rm_slv_max_bytes_per_char);
+
+    int storge_bytes_per_ascii_char = 2;    // For unicode there are two bytes for every ascii character
+
+    if (!EIM_unicode_enabled())
+    {
+        storge_bytes_per_ascii_char = 1;    // If not unicode we assume UTF-8, in which case we have 1 storage byte per ascii character
+    }
+
     puids.clear();
+    seqs.clear();
     calc_sizes.clear();
-    stored_sizes.clear();
 
     logical trans_was_active = true;
     EIM_select_var_t vars[3];
@@ -10722,52 +12721,34 @@ static int get_long_string_sizes(const char *cls_tbl, const char *cls_col, const
 
     ERROR_PROTECT
 
-    if (!EIM_is_transaction_active())
-    {
-        trans_was_active = false;
-        EIM_start_transaction();
-    }
+        if (!EIM_is_transaction_active())
+        {
+            trans_was_active = false;
+            EIM_start_transaction();
+        }
 
     std::stringstream sql;
+    logical where_added = false;
 
-    sql << "SELECT a.puid puid, " << db_byte_len_fun() << "(a." << att_col << ") calc_size, b." << cls_col << " stored_size";
-    sql << " FROM " << att_tbl << " a, " << cls_tbl << " b WHERE a.puid = b.puid";  
+    sql << "SELECT a.puid puid, a.pseq pseq, " << db_byte_len_fun() << "(a." << att_col << ") calc_size";
+    sql << " FROM " << att_tbl << " a";
 
-    if (uid != NULL || (uid_vec != NULL && uid_vec->size() > 0))
+    if ( rm_slv_max_bytes_per_char > 0 )
     {
-        sql << " AND a.puid IN (";
-        int inc_cnt = 0;
-
-        if (uid != NULL)
-        {
-            sql << "'" << uid << "'";
-            inc_cnt++;
-        }
-
-        if (uid_vec != NULL && uid_vec->size() > 0)
-        {
-            for (int i = 0; i < uid_vec->size(); i++)
-            {
-                if (inc_cnt > 0)
-                {
-                    sql << ",";
-                }
-
-                sql << "'" << (*uid_vec)[i] << "'";
-                inc_cnt++;
-            }
-        }
-        sql << ")";
+        sql << " WHERE " << db_byte_len_fun() << "(a." << att_col << ") >= " << (int)( ( max_size * storge_bytes_per_ascii_char ) / rm_slv_max_bytes_per_char );
+        where_added = true;
     }
 
-    sql << " ORDER BY calc_size ASC";
+    append_uid_filter(sql, (where_added ? " AND a.puid" : " WHERE a.puid"), uid, uid_vec);
+
+    sql << " ORDER BY puid, pseq, calc_size ASC";
 
     EIM_select_col(&(vars[0]), EIM_puid, "puid", EIM_uid_length + 1, false);
-    EIM_select_col(&(vars[1]), EIM_integer, "calc_size", sizeof(int), false);
-    EIM_select_col(&(vars[2]), EIM_integer, "stored_size", sizeof(int), false);
+    EIM_select_col(&(vars[1]), EIM_integer, "pseq", sizeof(int), false);
+    EIM_select_col(&(vars[2]), EIM_integer, "calc_size", sizeof(int), false);
 
     ifail = EIM_exec_sql_bind(sql.str().c_str(), &headers, &report, 0, 3, vars, 0, NULL);
-    EIM_check_error("Retrieving long-string sizes\n");
+    EIM_check_error("Retrieving string sizes\n");
 
     if (report != NULL)
     {
@@ -10777,6 +12758,10 @@ static int get_long_string_sizes(const char *cls_tbl, const char *cls_col, const
             EIM_find_value(headers, row->line, "puid", EIM_puid, &tmp_puid);
             puids.push_back(tmp_puid);
 
+            int* tmp_seq = NULL;
+            EIM_find_value(headers, row->line, "pseq", EIM_integer, &tmp_seq);
+            seqs.push_back(*tmp_seq);
+
             int* tmp_size = NULL;
             EIM_find_value(headers, row->line, "calc_size", EIM_integer, &tmp_size);
 
@@ -10788,27 +12773,15 @@ static int get_long_string_sizes(const char *cls_tbl, const char *cls_col, const
             {
                 calc_sizes.push_back(0);
             }
-
-            tmp_size = NULL;
-            EIM_find_value(headers, row->line, "stored_size", EIM_integer, &tmp_size);
-
-            if (tmp_size != NULL)
-            {
-                stored_sizes.push_back(*tmp_size);
-            }
-            else
-            {
-                stored_sizes.push_back(0);
-            }
         }
-        EIM_free_result(headers, report);
-        report = NULL;
-        headers = NULL;
     }
+    EIM_free_result(headers, report);
+    report = NULL;
+    headers = NULL;
 
     if (!trans_was_active)
     {
-        EIM_commit_transaction("get_long_string_sizes()");
+        EIM_commit_transaction("get_vla_string_sizes()");
     }
 
     ERROR_RECOVER
@@ -10831,19 +12804,19 @@ static int get_long_string_sizes(const char *cls_tbl, const char *cls_col, const
 }
 
 /*------------------------------------------------------------------------
-** Validate that the actual string sizes match the stored string sizes
-** and optionally correct the stored string sizes.
+** Validate the size of data in a VLA POM_string attribute against
+** the maximum size of the field.
+** We'll assume that if the stored data length is less than 1/4 of the max data length
+** that it will happily fit within the max buffer size when read from the database.
 ** ----------------------------------------------------------------------- */
-static int validate_long_string_sizes(const char* func, const char* cls, const char* attr, const char *cls_tbl, const char *cls_col, const char *att_tbl, const char *att_col, std::vector< std::string > &puids, std::vector< int > &calc_sizes, int* bad_count)
+static int validate_vla_string_sizes(const char* func, const char* cls, const char* attr, const char *cls_tbl, const char *cls_col, int max_size, std::vector< std::string > &puids, std::vector< int > &seqs, std::vector< int > &calc_sizes, int* bad_count)
 {
     int ifail = OK;
     // RM_SLV_ stands for Reference Manager String Length Validation
     int rm_slv_batch_size = 65500;       // Number of records processed per batch
-    int rm_slv_max_len = 200000;         // Maximum length of records within the batch
     int rm_slv_percent_exp = 30;         // Percentage of expected expansion due to none single byte characters
     int rm_slv_fixed_exp = 100;          // Additional fixed byte expansion to provide additional memory for unforseen expansions...
-    int rm_slv_max_mem_m = 6000;         // Maximum memory to be used within each batch... unit single record processing kicks in.
-    long rm_slv_max_int = 2147483647;    // Maximum integer value
+    int rm_slv_max_mem_m = 6000;         // Maximum memory to be used within each batch... before the batch is shrunk.
     int64_t rm_slv_meg = 1024 * 1024;       // Megabyte
 
     int rpt_worked_cnt = 0;              // Number of records that were processed
@@ -10855,34 +12828,28 @@ static int validate_long_string_sizes(const char* func, const char* cls, const c
     int rpt_corrected_cnt = 0;           // Number of records where the stored count was actually corrected
 
     int wrk_start_pos = 0;               // UID to start with.
-    int wrk_batch_size = 0;              // Batch size for the current SQL statement
-    int wrk_max_len = 0;                 // Max data length for this SQL statement on this platform
-    int wrk_max_calc = 0;                // The maximum caculated size for this batch
+    int wrk_max_len = 0;                 // Maximum size of a buffer that is expected to retrieve data
+    int wrk_batch_size = 0;              // Batch size for the current batch. 
 
                                          // Check configuration values. 
-    rm_slv_batch_size  = DDS_ask_pom_parameter_int("rm_slv_batch_size",  rm_slv_batch_size);
-    rm_slv_max_len     = DDS_ask_pom_parameter_int("rm_slv_max_len",     rm_slv_max_len);
+    rm_slv_batch_size = DDS_ask_pom_parameter_int("rm_slv_batch_size", rm_slv_batch_size);
     rm_slv_percent_exp = DDS_ask_pom_parameter_int("rm_slv_percent_exp", rm_slv_percent_exp);
-    rm_slv_fixed_exp   = DDS_ask_pom_parameter_int("rm_slv_fixed_exp",   rm_slv_fixed_exp);
-    rm_slv_max_mem_m   = DDS_ask_pom_parameter_int("rm_slv_max_mem_m",   rm_slv_max_mem_m);
+    rm_slv_fixed_exp = DDS_ask_pom_parameter_int("rm_slv_fixed_exp", rm_slv_fixed_exp);
+    rm_slv_max_mem_m = DDS_ask_pom_parameter_int("rm_slv_max_mem_m", rm_slv_max_mem_m);
     EIM_uid_t* cor_puids = NULL;
     int*       cor_lens = NULL;
+    int*       cor_seqs = NULL;
 
-    int storge_bytes_per_ascii_char = 2;    // For unicode there are two bytes for every ascii character
-
-    if (!EIM_unicode_enabled())
-    {
-        storge_bytes_per_ascii_char = 1;    // If not unicode we assume UTF-8, in which case we have 1 storage byte per ascii character
-    }
+    // Filter to ensure that we output bad uids only once into the syslog. 
+    std::map< std::string, int > dups;
+    std::map< std::string, int >::iterator it;
 
-    // As we are currently not using ENQ or temporary tables we will limit the batch size to 200 to limit the length of the SQL statement.
-    if (rm_slv_batch_size > 200)
-    {
-        rm_slv_batch_size = 200;
-    }
+    wrk_max_len = max_size + ((max_size * rm_slv_percent_exp) / 100) + rm_slv_fixed_exp;
 
+    // Every row gets a buffer of the column width, so the batch is bounded by memory alone.
     // Make sure we limit the batch size so that we don't use significantly more memory than the maximum configured.
-    int64_t temp_cnt = rm_slv_meg * rm_slv_max_mem_m / rm_slv_max_len;
+    int64_t temp_cnt = rm_slv_meg * rm_slv_max_mem_m / wrk_max_len;
+
     if (temp_cnt < rm_slv_batch_size)
     {
         rm_slv_batch_size = (int)temp_cnt;
@@ -10899,10 +12866,14 @@ static int validate_long_string_sizes(const char* func, const char* cls, const c
     }
 
     cor_puids = (EIM_uid_t*)SM_alloc(sizeof(EIM_uid_t) * (rm_slv_batch_size + 1));
+    cor_seqs = (int*)SM_alloc(sizeof(int) * (rm_slv_batch_size + 1));
     cor_lens = (int*)SM_alloc(sizeof(int) * (rm_slv_batch_size + 1));
 
     logical trans_was_active = true;
-    EIM_select_var_t vars[4];
+    EIM_select_var_t vars[3];
+    EIM_bind_var_t bind_vars[2];
+    int first_rn = 0;
+    int last_rn = 0;
     EIM_value_p_t headers = NULL;
     EIM_row_p_t report = NULL;
     EIM_row_p_t row;
@@ -10911,6 +12882,8 @@ static int validate_long_string_sizes(const char* func, const char* cls, const c
 
     str_len_val_status(true, "Start ", func, puids.size(), rpt_worked_cnt, rpt_under_cnt, rpt_over_cnt, rpt_success_cnt, rpt_unknown_cnt, rpt_eligible_cnt, rpt_corrected_cnt);
 
+    SLV_stage_keys(puids, &seqs);
+
     while (wrk_start_pos < puids.size())
     {
         trans_was_active = true;
@@ -10923,93 +12896,43 @@ static int validate_long_string_sizes(const char* func, const char* cls, const c
 
         int cor_offset = 0;
 
-        // Any time a record is larger that rm_slv_max_len, we want to set the batch size to one. 
-        // So look through the next batch of values and check for the first large data value. 
-
-        wrk_batch_size = 1;
-        wrk_max_calc = 0;
-
-        if (rm_slv_batch_size > 1 && wrk_start_pos < puids.size())
-        {
-            int term_pos = wrk_start_pos;
-
-            for (int j = 0; j < rm_slv_batch_size && term_pos < puids.size(); j++, term_pos++)
-            {
-                if (calc_sizes[wrk_start_pos + j] / storge_bytes_per_ascii_char > rm_slv_max_len)
-                {
-                    break;
-                }
-
-                if (calc_sizes[wrk_start_pos + j] > wrk_max_calc)
-                {
-                    wrk_max_calc = calc_sizes[wrk_start_pos + j];
-                }
-            }
-
-            if (term_pos - wrk_start_pos > 1)
-            {
-                wrk_batch_size = term_pos - wrk_start_pos;
-            }
-        }
+        // Calculate the batch size for this sql statement by
+        wrk_batch_size = puids.size() - wrk_start_pos;
 
-        if (wrk_batch_size == 1)
+        if (wrk_batch_size > rm_slv_batch_size)
         {
-            rm_slv_batch_size = 1;
+            wrk_batch_size = rm_slv_batch_size;
         }
 
-        if (wrk_batch_size > 0)
+        if (wrk_batch_size < 1)
         {
-            // Calculate max buffer size based on configured expected expansion ratio.
-            // Start with the largest cacluate size in our batch.
-            long tmp_max_len = wrk_max_calc;
-
-            if (wrk_batch_size == 1)
-            {
-                // If the batch size is just one the use the calcualted from for this record.
-                tmp_max_len = calc_sizes[wrk_start_pos];
-            }
-
-            if (EIM_unicode_enabled())
-            {
-                tmp_max_len = tmp_max_len >> 1;
-                tmp_max_len++;
-            }
-
-            tmp_max_len = tmp_max_len + (long)(tmp_max_len * rm_slv_percent_exp / 100) + rm_slv_fixed_exp;
-
-            if (tmp_max_len > rm_slv_max_int)
+            if (wrk_start_pos < puids.size())
             {
-                wrk_max_len = (int)rm_slv_max_int;
+                wrk_batch_size = 1;
             }
             else
             {
-                wrk_max_len = (int)tmp_max_len;
+                wrk_batch_size = 0;
             }
+        }
 
+        if (wrk_batch_size > 0)
+        {
             // Build SQL to retrieve actual data from the database
             std::stringstream sql;
 
-            sql << "SELECT a.puid puid, a." << att_col << " data, b." << cls_col << " stored_size";
-            sql << " FROM " << att_tbl << " a, " << cls_tbl << " b WHERE a.puid = b.puid AND a.puid IN (";
-
-            for (int i = 0; i < wrk_batch_size; i++)
-            {
-                if (i > 0)
-                {
-                    sql << ",";
-                }
-
-                sql << "'" << puids[wrk_start_pos++] << "'";
-            }
+            sql << "SELECT a.puid puid, a.pseq pseq, a." << cls_col << " data";
+            sql << " FROM " << cls_tbl << " a, " << tbl_slv_keys << " k WHERE a.puid = k.puid AND a.pseq = k.pseq AND k.rn > :1 AND k.rn <= :2";
 
-            sql << ")";
+            SLV_bind_key_range(bind_vars, &first_rn, &last_rn, wrk_start_pos, wrk_batch_size);
+            wrk_start_pos += wrk_batch_size;
 
             EIM_select_col(&(vars[0]), EIM_puid, "puid", EIM_uid_length + 1, false);
-            EIM_select_col(&(vars[1]), EIM_varchar, "data", wrk_max_len, false);
-            EIM_select_col(&(vars[2]), EIM_integer, "stored_size", sizeof(int), false);
+            EIM_select_col(&(vars[1]), EIM_integer, "pseq", sizeof(int), false);
+            EIM_select_col(&(vars[2]), EIM_varchar, "data", wrk_max_len + 1, false);
 
-            ifail = EIM_exec_sql_bind(sql.str().c_str(), &headers, &report, 0, 3, vars, 0, NULL);
-            EIM_check_error("Retrieving long-string data\n");
+            ifail = EIM_exec_sql_bind(sql.str().c_str(), &headers, &report, 0, 3, vars, 2, bind_vars);
+            EIM_check_error("Retrieving string data\n");
 
             if (report != NULL)
             {
@@ -11020,32 +12943,45 @@ static int validate_long_string_sizes(const char* func, const char* cls, const c
                     char* tmp_puid = NULL;
                     EIM_find_value(headers, row->line, "puid", EIM_puid, &tmp_puid);
 
-                    char* tmp_data = NULL;
-                    int str_len = 0;
-                    logical correction_required = false;
+                    if (tmp_puid == NULL)
+                    {
+                        rpt_unknown_cnt++;
+                        continue;
+                    }
 
-                    EIM_find_value(headers, row->line, "data", EIM_varchar, &tmp_data);
+                    int* tmp_seq = NULL;
+                    EIM_find_value(headers, row->line, "pseq", EIM_integer, &tmp_seq);
 
-                    if (tmp_data != NULL)
+                    if (tmp_seq == NULL)
                     {
-                        str_len = strlen(tmp_data);
+                        rpt_unknown_cnt++;
+                        continue;
                     }
 
-                    int *tmp_size = NULL;
-                    EIM_find_value(headers, row->line, "stored_size", EIM_integer, &tmp_size);
+                    if (tmp_seq == NULL)
+                    {
+                        rpt_unknown_cnt++;
+                        continue;
+                    }
+
+                    char* tmp_data = NULL;
+                    int str_len = 0;
+                    logical correction_required = false;
+
+                    EIM_find_value(headers, row->line, "data", EIM_varchar, &tmp_data);
 
-                    if (tmp_size != NULL)
+                    // Data that is not well formed UTF-8 is reported as unknown and is not truncated.
+                    if (tmp_data != NULL && slv_data_len(tmp_data, tmp_puid, &str_len))
                     {
-                        if (*tmp_size < str_len)
+                        if (max_size < str_len)
                         {
                             correction_required = true;
                             rpt_eligible_cnt++;
                             rpt_under_cnt++;
                         }
-                        else if (*tmp_size > str_len)
+                        else if (max_size > str_len)
                         {
-                            correction_required = true;
-                            rpt_eligible_cnt++;
+                            correction_required = false;
                             rpt_over_cnt++;
                         }
                         else
@@ -11056,14 +12992,13 @@ static int validate_long_string_sizes(const char* func, const char* cls, const c
                     }
                     else
                     {
-                        correction_required = true;
-                        rpt_eligible_cnt++;
+                        correction_required = false;
                         rpt_unknown_cnt++;
                     }
 
                     if (correction_required)
                     {
-                        //  resolves coverity defect 506025 : String Overflow
+                        // resolves coverity defect 506014 : String Overflow
                         if (sizeof(cor_puids[cor_offset]) > strlen(tmp_puid))
                         {
                             strcpy(cor_puids[cor_offset], tmp_puid);
@@ -11073,6 +13008,7 @@ static int validate_long_string_sizes(const char* func, const char* cls, const c
                             ERROR_internal(ERROR_line, "Size not enough to copy '%s' ", tmp_puid);
                         }
 
+                        cor_seqs[cor_offset] = *tmp_seq;
                         cor_lens[cor_offset] = str_len;
                         cor_offset++;
                     }
@@ -11088,27 +13024,38 @@ static int validate_long_string_sizes(const char* func, const char* cls, const c
 
                 do
                 {
+                    logical valid_uids = false;
                     {
                         std::stringstream msg;
                         msg << "\nreference_manager -str_len_val -u=user -p=password -g=dba -from=" << cls << ":" << attr << " -commit";
 
                         for (int i = 0; i < 20 && counter < cor_offset; i++, counter++)
                         {
-                            msg << " -uid=" << (const char*)(cor_puids[counter]);
+                            std::string temp_uid = cor_puids[counter];
+                            it = dups.find(temp_uid);
+
+                            if (it == dups.end())
+                            {
+                                valid_uids = true;
+                                dups.insert(std::pair< std::string, int>(temp_uid, 0));
+                                msg << " -uid=" << (const char*)(cor_puids[counter]);
+                            }
                         }
                         msg << "\n";
 
-                        logger()->printf(msg.str().c_str());
+                        if (valid_uids)
+                        {
+                            valid_uids = false;
+                            logger()->printf(msg.str().c_str());
+                        }
                     }
                 } while (counter < cor_offset);
             }
 
             if (cor_offset > 0 && args->commit_flag)
             {
-                // 
-                // Update data lengths here. 
-                //
-                ifail = bulk_update_integers(cls_tbl, cls_col, cor_puids, cor_lens, cor_offset);
+                // Truncate strings ... remove a few characters... most of the time one (1) character. 
+                ifail = truncate_vla_strings(cls_tbl, cls_col, max_size, cor_puids, cor_seqs, cor_lens, cor_offset);
                 rpt_corrected_cnt += cor_offset;
             }
         }
@@ -11117,13 +13064,13 @@ static int validate_long_string_sizes(const char* func, const char* cls, const c
 
         if (!trans_was_active)
         {
-            EIM_commit_transaction("validate_long_string_sizes()");
+            EIM_commit_transaction("validate_vla_string_sizes()");
         }
     }
 
     ERROR_RECOVER
 
-    const std::string msg("EXCEPTION: See syslog for additional details.");
+        const std::string msg("EXCEPTION: See syslog for additional details.");
     cons_out(msg);
 
     if (!trans_was_active)
@@ -11137,18 +13084,15 @@ static int validate_long_string_sizes(const char* func, const char* cls, const c
     }
     ERROR_END
 
-    SM_free(cor_puids);
-    SM_free(cor_lens);
-
-    *bad_count = rpt_eligible_cnt;
+    *bad_count += rpt_eligible_cnt;
     str_len_val_status(true, "Final ", func, puids.size(), rpt_worked_cnt, rpt_under_cnt, rpt_over_cnt, rpt_success_cnt, rpt_unknown_cnt, rpt_eligible_cnt, rpt_corrected_cnt);
     return(ifail);
 }
 
 /*------------------------------------------------------------------------
-** Bulk update integers for specified UIDs.
+** Truncate vla strings to fit within max size.
 ** ----------------------------------------------------------------------- */
-static int bulk_update_integers(const char *tbl, const char *col, EIM_uid_t *uids, int* ints, int size)
+static int truncate_vla_strings(const char *tbl, const char *col, int max_size, EIM_uid_t *uids, int* seqs, int* ints, int size)
 {
     int ifail = OK;
 
@@ -11158,9 +13102,11 @@ static int bulk_update_integers(const char *tbl, const char *col, EIM_uid_t *uid
     }
 
     const int maxUpdateSize = EIM_get_max_insert_size();
+    int*        adj = (int*)SM_alloc(sizeof(int) * (size + 1));
     int         batch_size = 0;
     EIM_uid_t*  uid_ptr = uids;
-    int*        int_ptr = ints;
+    int*        int_ptr = adj;
+    int*        seq_ptr = seqs;
 
     if (maxUpdateSize < size)
     {
@@ -11173,10 +13119,54 @@ static int bulk_update_integers(const char *tbl, const char *col, EIM_uid_t *uid
         batch_size = size;
     }
 
+    // Calculate the number of characters we want to truncate. 
+    {
+        int  rm_slv_max_bytes_per_char = 4;             // The divisor value for calculation of additional characters to be removed. 
+        rm_slv_max_bytes_per_char = DDS_ask_pom_parameter_int("rm_slv_max_bytes_per_char", rm_slv_max_bytes_per_char);
+        int adjval = 0;
+
+        for (int i = 0; i < size; i++)
+        {
+            if (ints[i] <= max_size)
+            {
+                adj[i] = 0;
+                continue;
+            }
+
+            adj[i] = 1;
+
+            if (rm_slv_max_bytes_per_char > 0)
+            {
+                adjval = ints[i] - max_size;
+                adjval--;
+
+                adjval = adjval / rm_slv_max_bytes_per_char;
+                adj[i] = adjval + 1;
+            }
+        }
+    }
+
+    // Only the over-length rows are updated, compact them to the front of the bind arrays.
+    EIM_uid_t*  bnd_uids = (EIM_uid_t*)SM_alloc(sizeof(EIM_uid_t) * (size + 1));
+    int*        bnd_seqs = (int*)SM_alloc(sizeof(int) * (size + 1));
+    int         bnd_cnt = 0;
+
+    for (int k = 0; k < size; k++)
+    {
+        if (adj[k] > 0)
+        {
+            adj[bnd_cnt] = adj[k];
+            bnd_seqs[bnd_cnt] = seq_ptr[k];
+            memcpy(bnd_uids[bnd_cnt], uid_ptr[k], sizeof(EIM_uid_t));
+            bnd_cnt++;
+        }
+    }
+
     // Allocate an array of pointers to bind array value pointers.
-    EIM_bind_array_value_p_t bvs[2];
+    EIM_bind_array_value_p_t bvs[3];
     bvs[0] = static_cast<EIM_bind_array_value_p_t>(SM_alloc(sizeof(EIM_bind_array_value_t)));
     bvs[1] = static_cast<EIM_bind_array_value_p_t>(SM_alloc(sizeof(EIM_bind_array_value_t)));
+    bvs[2] = static_cast<EIM_bind_array_value_p_t>(SM_alloc(sizeof(EIM_bind_array_value_t)));
 
     bvs[0]->type = EIM_integer;
     bvs[0]->len = sizeof(int);
@@ -11190,127 +13180,134 @@ static int bulk_update_integers(const char *tbl, const char *col, EIM_uid_t *uid
     bvs[1]->ind = (short *)SM_calloc(batch_size, sizeof(short));
     bvs[1]->value = NULL;
 
+    bvs[2]->type = EIM_integer;
+    bvs[2]->len = sizeof(int);
+    bvs[2]->array_size = 0;
+    bvs[2]->ind = (short *)SM_calloc(batch_size, sizeof(short));
+    bvs[2]->value = NULL;
+
+    // One statement text for every batch, the truncation amount of each row is bound.
+    char* sql = SM_sprintf("UPDATE %s SET %s = %s(%s,1,(%s(%s) - :1)) WHERE puid = :2 AND pseq = :3", tbl, col, db_substr_fun(), col, db_char_len_fun(), col);
+
     int i = 0;
-    int this_batch = size;
-    this_batch = this_batch % batch_size;
 
-    if (this_batch == 0)
+    while (i < bnd_cnt)
     {
-        this_batch = batch_size;
-    }
+        int this_batch = (bnd_cnt - i < batch_size ? bnd_cnt - i : batch_size);
 
-    while (i < size)
-    {
         bvs[0]->array_size = this_batch;
         bvs[0]->value = int_ptr + i;
 
         bvs[1]->array_size = this_batch;
-        bvs[1]->value = uid_ptr + i;
+        bvs[1]->value = bnd_uids + i;
 
-        char* sql = SM_sprintf("UPDATE %s SET %s = :1 WHERE puid = :2", tbl, col);
+        bvs[2]->array_size = this_batch;
+        bvs[2]->value = bnd_seqs + i;
 
         // Do update
-        ifail = EIM_exec_imm_array_bind(sql, "bulk_update_integers(): bulk updating string lengths", this_batch, 2, bvs);
-        EIM_check_error("bulk_update_integers(): bulk updating string lengths");
-
-        SM_free(sql);
+        ifail = EIM_exec_imm_array_bind(sql, "truncate_vla_strings(): truncating vla strings", this_batch, 3, bvs);
+        EIM_check_error("truncate_vla_strings(): truncating vla strings");
 
         i = i + this_batch;
-        this_batch = batch_size;
 
-        bvs[0]->array_size = 0;
-        bvs[0]->value = NULL;
-
-        bvs[1]->array_size = 0;
-        bvs[1]->value = NULL;
+        for (int k = 0; k < 3; k++)
+        {
+            bvs[k]->array_size = 0;
+            bvs[k]->value = NULL;
+        }
     }
 
-    if (i != size)
+    SM_free(sql);
+
+    for (int k = 0; k < 3; k++)
     {
-        ERROR_raise(ERROR_line, POM_internal_error, "validate_long_string_sizes(): Not all data written to %s table, missing at least %d records. (%d)", tbl, size - i, ifail);
+        SM_free(bvs[k]->ind);
+        SM_free(bvs[k]);
     }
 
-    SM_free(bvs[0]->ind);
-    SM_free(bvs[1]->ind);
-    SM_free(bvs[0]);
-    SM_free(bvs[1]);
+    SM_free(bnd_uids);
+    SM_free(bnd_seqs);
+    SM_free(adj);
+
+    return(ifail);
+}
+
+/*------------------------------------------------------------------------
+** Retrieves the calcualted sizes for LA (large array) POM_string attributes.
+** ----------------------------------------------------------------------- */
+static int get_la_string_sizes(const char *att_tbl, const char *att_col, int max_size, const char* uid, std::vector< std::string >  *uid_vec, std::vector< std::string > &puids, std::vector< int > &seqs, std::vector< int > &calc_sizes)
+{
+    int ifail = get_vla_string_sizes(att_tbl, att_col, max_size, uid, uid_vec, puids, seqs, calc_sizes);
+    return(ifail);
+}
 
+/*------------------------------------------------------------------------
+** Validate the size of data in a LA (large array) POM_string attribute against
+** the maximum size of the field.
+** We'll assume that if the stored data length is less than 1/4 of the max data length
+** that it will happily fit within the max buffer size when read from the database.
+** ----------------------------------------------------------------------- */
+static int validate_la_string_sizes(const char* cls, const char* attr, const char *cls_tbl, const char *cls_col, int max_size, std::vector< std::string > &puids, std::vector< int > &seqs, std::vector< int > &calc_sizes, int* bad_count)
+{
+    int ifail = validate_vla_string_sizes("Str(LA)", cls, attr, cls_tbl, cls_col, max_size, puids, seqs, calc_sizes, bad_count);
     return(ifail);
 }
 
 /*------------------------------------------------------------------------
 ** Retrieves the calcualted and stored sizes for long string data.
-** Data is returned in ascending order by calculated size.
 ** ----------------------------------------------------------------------- */
-static int get_vla_long_string_sizes(const char *att_tbl, const char *att_col, const char* uid, std::vector< std::string >  *uid_vec, std::vector< std::string > &puids, std::vector< int > &pseqs, std::vector< int > &calc_sizes, std::vector< int > &stored_sizes)
+static int get_long_string_sizes(const char *cls_tbl, const char *cls_col, const char *att_tbl, const char *att_col, const char* uid, std::vector< std::string >  *uid_vec, std::vector< std::string > &puids, std::vector< int > &calc_sizes, std::vector< int > &stored_sizes)
 {
     int ifail = OK;
-
-    if ( EIM_dbplat() != EIM_dbplat_mssql && EIM_dbplat() != EIM_dbplat_oracle )
+    // onst char *potname = DDS_ask_tname((DDS_class_p_t) OM_ask_class_of_class_id (OM_lookup_class("POM_object")));
+    if ( EIM_dbplat() != EIM_dbplat_mssql && EIM_dbplat() != EIM_dbplat_oracle && !slv_client_side() )
     {
-        ERROR_raise(ERROR_line, POM_internal_error, "Functionality is not supported for RDBMSs other than MS SQL Server and Oracle.");
+        ERROR_raise(ERROR_line, POM_internal_error, "Functionality is not supported for RDBMSs other than MS SQL Server, Oracle and Postgres.");
     }
 
     puids.clear();
-    pseqs.clear();
     calc_sizes.clear();
     stored_sizes.clear();
 
     logical trans_was_active = true;
-    EIM_select_var_t vars[4];
+    EIM_select_var_t vars[3];
     EIM_value_p_t headers = NULL;
     EIM_row_p_t report = NULL;
     EIM_row_p_t row;
 
     ERROR_PROTECT
 
-        if (!EIM_is_transaction_active())
-        {
-            trans_was_active = false;
-            EIM_start_transaction();
-        }
+    if (!EIM_is_transaction_active())
+    {
+        trans_was_active = false;
+        EIM_start_transaction();
+    }
 
     std::stringstream sql;
 
-    sql << "SELECT a.puid puid, a.pseq pseq, a.pvall stored_size, " << db_byte_len_fun() << "(a." << att_col << ") calc_size FROM " << att_tbl << " a";
-
-    if (uid != NULL || (uid_vec != NULL && uid_vec->size() > 0))
+    // On the client-side platforms an upper bound of the byte length orders the keys and sizes the fetch
+    // buffer, the data itself is measured by validate_long_string_sizes().
+    if ( slv_client_side() )
     {
-        sql << " WHERE a.puid IN (";
-
-        int inc_cnt = 0;
-
-        if (uid != NULL)
-        {
-            sql << "'" << uid << "'";
-            inc_cnt++;
-        }
+        sql << "SELECT a.puid puid, " << slv_client_byte_len_expr( std::string( "a." ) + att_col ) << " calc_size, b." << cls_col << " stored_size";
+    }
+    else
+    {
+        sql << "SELECT a.puid puid, " << db_byte_len_fun() << "(a." << att_col << ") calc_size, b." << cls_col << " stored_size";
+    }
 
-        if (uid_vec != NULL && uid_vec->size() > 0)
-        {
-            for (int i = 0; i < uid_vec->size(); i++)
-            {
-                if (inc_cnt > 0)
-                {
-                    sql << ",";
-                }
+    sql << " FROM " << att_tbl << " a, " << cls_tbl << " b WHERE a.puid = b.puid";  
 
-                sql << "'" << (*uid_vec)[i] << "'";
-                inc_cnt++;
-            }
-        }
-        sql << ")";
-    }
+    append_uid_filter(sql, " AND a.puid", uid, uid_vec);
 
     sql << " ORDER BY calc_size ASC";
 
     EIM_select_col(&(vars[0]), EIM_puid, "puid", EIM_uid_length + 1, false);
-    EIM_select_col(&(vars[1]), EIM_integer, "pseq", sizeof(int), false);
+    EIM_select_col(&(vars[1]), EIM_integer, "calc_size", sizeof(int), false);
     EIM_select_col(&(vars[2]), EIM_integer, "stored_size", sizeof(int), false);
-    EIM_select_col(&(vars[3]), EIM_integer, "calc_size", sizeof(int), false);
 
-    ifail = EIM_exec_sql_bind(sql.str().c_str(), &headers, &report, 0, 4, vars, 0, NULL);
-    EIM_check_error("Retrieving vla long-string sizes\n");
+    ifail = EIM_exec_sql_bind(sql.str().c_str(), &headers, &report, 0, 3, vars, 0, NULL);
+    EIM_check_error("Retrieving long-string sizes\n");
 
     if (report != NULL)
     {
@@ -11321,15 +13318,15 @@ static int get_vla_long_string_sizes(const char *att_tbl, const char *att_col, c
             puids.push_back(tmp_puid);
 
             int* tmp_size = NULL;
-            EIM_find_value(headers, row->line, "pseq", EIM_integer, &tmp_size);
+            EIM_find_value(headers, row->line, "calc_size", EIM_integer, &tmp_size);
 
             if (tmp_size != NULL)
             {
-                pseqs.push_back(*tmp_size);
+                calc_sizes.push_back(*tmp_size);
             }
             else
             {
-                pseqs.push_back(0);
+                calc_sizes.push_back(0);
             }
 
             tmp_size = NULL;
@@ -11343,18 +13340,6 @@ static int get_vla_long_string_sizes(const char *att_tbl, const char *att_col, c
             {
                 stored_sizes.push_back(0);
             }
-
-            tmp_size = NULL;
-            EIM_find_value(headers, row->line, "calc_size", EIM_integer, &tmp_size);
-
-            if (tmp_size != NULL)
-            {
-                calc_sizes.push_back(*tmp_size);
-            }
-            else
-            {
-                calc_sizes.push_back(0);
-            }
         }
         EIM_free_result(headers, report);
         report = NULL;
@@ -11388,9 +13373,8 @@ static int get_vla_long_string_sizes(const char *att_tbl, const char *att_col, c
 /*------------------------------------------------------------------------
 ** Validate that the actual string sizes match the stored string sizes
 ** and optionally correct the stored string sizes.
-** The input calculated sizes must be in assending order.
 ** ----------------------------------------------------------------------- */
-static int validate_vla_long_string_sizes(const char* func, const char* cls, const char* attr, const char *att_tbl, const char *att_col, std::vector< std::string > &puids, std::vector< int > &pseqs, std::vector< int > &calc_sizes, int* bad_count)
+static int validate_long_string_sizes(const char* func, const char* cls, const char* attr, const char *cls_tbl, const char *cls_col, const char *att_tbl, const char *att_col, std::vector< std::string > &puids, std::vector< int > &calc_sizes, int* bad_count)
 {
     int ifail = OK;
     // RM_SLV_ stands for Reference Manager String Length Validation
@@ -11398,7 +13382,7 @@ static int validate_vla_long_string_sizes(const char* func, const char* cls, con
     int rm_slv_max_len = 200000;         // Maximum length of records within the batch
     int rm_slv_percent_exp = 30;         // Percentage of expected expansion due to none single byte characters
     int rm_slv_fixed_exp = 100;          // Additional fixed byte expansion to provide additional memory for unforseen expansions...
-    int rm_slv_max_mem_m = 6000;         // Maximum memory to be used within each batch... unit single record processing kicks in.
+    int rm_slv_max_mem_m = 6000;         // Maximum memory to be used within each batch... before the batch is shrunk.
     long rm_slv_max_int = 2147483647;    // Maximum integer value
     int64_t rm_slv_meg = 1024 * 1024;       // Megabyte
 
@@ -11414,6 +13398,8 @@ static int validate_vla_long_string_sizes(const char* func, const char* cls, con
     int wrk_batch_size = 0;              // Batch size for the current SQL statement
     int wrk_max_len = 0;                 // Max data length for this SQL statement on this platform
     int wrk_max_calc = 0;                // The maximum caculated size for this batch
+    logical wrk_piece_mode = false;      // The batch holds records larger than rm_slv_max_len
+    std::vector< int > piece_lens;       // Byte lengths summed by SLV_piece_lens() for the batch
 
                                          // Check configuration values. 
     rm_slv_batch_size  = DDS_ask_pom_parameter_int("rm_slv_batch_size",  rm_slv_batch_size);
@@ -11422,7 +13408,6 @@ static int validate_vla_long_string_sizes(const char* func, const char* cls, con
     rm_slv_fixed_exp   = DDS_ask_pom_parameter_int("rm_slv_fixed_exp",   rm_slv_fixed_exp);
     rm_slv_max_mem_m   = DDS_ask_pom_parameter_int("rm_slv_max_mem_m",   rm_slv_max_mem_m);
     EIM_uid_t* cor_puids = NULL;
-    int*       cor_pseqs = NULL;
     int*       cor_lens = NULL;
 
     int storge_bytes_per_ascii_char = 2;    // For unicode there are two bytes for every ascii character
@@ -11432,19 +13417,8 @@ static int validate_vla_long_string_sizes(const char* func, const char* cls, con
         storge_bytes_per_ascii_char = 1;    // If not unicode we assume UTF-8, in which case we have 1 storage byte per ascii character
     }
 
-    // Filter to ensure that we output bad uids only once into the syslog. 
-    std::map< std::string, int > dups;
-    std::map< std::string, int >::iterator it;
-
-    // As we are currently not using ENQ or temporary tables we will limit the batch size to 200 to limit the length of the SQL statement.
-    if (rm_slv_batch_size > 200)
-    {
-        rm_slv_batch_size = 200;
-    }
-
     // Make sure we limit the batch size so that we don't use significantly more memory than the maximum configured.
     int64_t temp_cnt = rm_slv_meg * rm_slv_max_mem_m / rm_slv_max_len;
-
     if (temp_cnt < rm_slv_batch_size)
     {
         rm_slv_batch_size = (int)temp_cnt;
@@ -11460,12 +13434,30 @@ static int validate_vla_long_string_sizes(const char* func, const char* cls, con
         rm_slv_batch_size = 1;
     }
 
+    // Records larger than rm_slv_max_len are read in pieces, each key holding one piece buffer.
+    int rm_slv_piece_chars = SLV_piece_chars(rm_slv_max_len);
+    int rm_slv_piece_len = (rm_slv_piece_chars * 4) + 1;
+    int rm_slv_piece_batch = rm_slv_batch_size;
+
+    temp_cnt = rm_slv_meg * rm_slv_max_mem_m / rm_slv_piece_len;
+    if (temp_cnt < rm_slv_piece_batch)
+    {
+        rm_slv_piece_batch = (int)temp_cnt;
+    }
+
+    if (rm_slv_piece_batch < 1)
+    {
+        rm_slv_piece_batch = 1;
+    }
+
     cor_puids = (EIM_uid_t*)SM_alloc(sizeof(EIM_uid_t) * (rm_slv_batch_size + 1));
-    cor_pseqs = (int*)SM_alloc(sizeof(int) * (rm_slv_batch_size + 1));
     cor_lens = (int*)SM_alloc(sizeof(int) * (rm_slv_batch_size + 1));
 
     logical trans_was_active = true;
     EIM_select_var_t vars[4];
+    EIM_bind_var_t bind_vars[2];
+    int first_rn = 0;
+    int last_rn = 0;
     EIM_value_p_t headers = NULL;
     EIM_row_p_t report = NULL;
     EIM_row_p_t row;
@@ -11474,6 +13466,8 @@ static int validate_vla_long_string_sizes(const char* func, const char* cls, con
 
     str_len_val_status(true, "Start ", func, puids.size(), rpt_worked_cnt, rpt_under_cnt, rpt_over_cnt, rpt_success_cnt, rpt_unknown_cnt, rpt_eligible_cnt, rpt_corrected_cnt);
 
+    SLV_stage_keys(puids, NULL);
+
     while (wrk_start_pos < puids.size())
     {
         trans_was_active = true;
@@ -11486,13 +13480,23 @@ static int validate_vla_long_string_sizes(const char* func, const char* cls, con
 
         int cor_offset = 0;
 
-        // Any time a record is larger that rm_slv_max_len, we want to set the batch size to one. 
-        // So look check through the next batch of values for the first large data value. 
+        // The keys are ordered by calculated size, so once a record is larger than rm_slv_max_len
+        // every remaining record is too. Those are measured a piece at a time by SLV_piece_lens(). 
 
         wrk_batch_size = 1;
         wrk_max_calc = 0;
+        wrk_piece_mode = (calc_sizes[wrk_start_pos] / storge_bytes_per_ascii_char > rm_slv_max_len);
+
+        if (wrk_piece_mode)
+        {
+            wrk_batch_size = rm_slv_piece_batch;
 
-        if (rm_slv_batch_size > 1 && wrk_start_pos < puids.size())
+            if (wrk_batch_size > (int)puids.size() - wrk_start_pos)
+            {
+                wrk_batch_size = (int)puids.size() - wrk_start_pos;
+            }
+        }
+        else
         {
             int term_pos = wrk_start_pos;
 
@@ -11515,24 +13519,13 @@ static int validate_vla_long_string_sizes(const char* func, const char* cls, con
             }
         }
 
-        if (wrk_batch_size == 1)
-        {
-            rm_slv_batch_size = 1;
-        }
-
         if (wrk_batch_size > 0)
         {
             // Calculate max buffer size based on configured expected expansion ratio.
             // Start with the largest cacluate size in our batch.
             long tmp_max_len = wrk_max_calc;
 
-            if (wrk_batch_size == 1)
-            {
-                // If the batch size is just one then use the calcualted from for this record.
-                tmp_max_len = calc_sizes[wrk_start_pos];
-            }
-
-            if (EIM_unicode_enabled() && EIM_dbplat() == EIM_dbplat_mssql)
+            if (EIM_unicode_enabled())
             {
                 tmp_max_len = tmp_max_len >> 1;
                 tmp_max_len++;
@@ -11552,26 +13545,38 @@ static int validate_vla_long_string_sizes(const char* func, const char* cls, con
             // Build SQL to retrieve actual data from the database
             std::stringstream sql;
 
-            sql << "SELECT a.puid puid, a.pseq pseq, a." << att_col << " data, a.pvall stored_size";
-            sql << " FROM " << att_tbl << " a WHERE";
-
-            for (int i = 0; i < wrk_batch_size; i++)
+            sql << "SELECT a.puid puid, ";
+            if (wrk_piece_mode)
             {
-                if (i > 0)
-                {
-                    sql << " OR";
-                }
+                sql << "k.rn rn";
+            }
+            else
+            {
+                sql << "a." << att_col << " data";
+            }
+            sql << ", b." << cls_col << " stored_size";
+            sql << " FROM " << att_tbl << " a, " << cls_tbl << " b, " << tbl_slv_keys << " k WHERE a.puid = b.puid AND a.puid = k.puid AND k.rn > :1 AND k.rn <= :2";
 
-                sql << " (a.puid = '" << puids[wrk_start_pos] << "' AND a.pseq = " << pseqs[wrk_start_pos] << ")";
-                wrk_start_pos++;
+            SLV_bind_key_range(bind_vars, &first_rn, &last_rn, wrk_start_pos, wrk_batch_size);
+            wrk_start_pos += wrk_batch_size;
+
+            if (wrk_piece_mode)
+            {
+                SLV_piece_lens(att_tbl, att_col, false, first_rn, last_rn, rm_slv_piece_chars, rm_slv_piece_len, piece_lens);
             }
 
             EIM_select_col(&(vars[0]), EIM_puid, "puid", EIM_uid_length + 1, false);
-            EIM_select_col(&(vars[1]), EIM_integer, "pseq", sizeof(int), false);
-            EIM_select_col(&(vars[2]), EIM_varchar, "data", wrk_max_len, false);
-            EIM_select_col(&(vars[3]), EIM_integer, "stored_size", sizeof(int), false);
+            if (wrk_piece_mode)
+            {
+                EIM_select_col(&(vars[1]), EIM_integer, "rn", sizeof(int), false);
+            }
+            else
+            {
+                EIM_select_col(&(vars[1]), EIM_varchar, "data", wrk_max_len, false);
+            }
+            EIM_select_col(&(vars[2]), EIM_integer, "stored_size", sizeof(int), false);
 
-            ifail = EIM_exec_sql_bind(sql.str().c_str(), &headers, &report, 0, 4, vars, 0, NULL);
+            ifail = EIM_exec_sql_bind(sql.str().c_str(), &headers, &report, 0, 3, vars, 2, bind_vars);
             EIM_check_error("Retrieving long-string data\n");
 
             if (report != NULL)
@@ -11583,30 +13588,42 @@ static int validate_vla_long_string_sizes(const char* func, const char* cls, con
                     char* tmp_puid = NULL;
                     EIM_find_value(headers, row->line, "puid", EIM_puid, &tmp_puid);
 
-                    int* tmp_pseq = NULL;
-                    EIM_find_value(headers, row->line, "pseq", EIM_integer, &tmp_pseq);
-
-                    if (tmp_puid == NULL || tmp_pseq == NULL)
-                    {
-                        rpt_unknown_cnt++;
-                        continue;
-                    }
-
                     char* tmp_data = NULL;
                     int str_len = 0;
                     logical correction_required = false;
+                    logical valid_data = true;
 
-                    EIM_find_value(headers, row->line, "data", EIM_varchar, &tmp_data);
+                    if (wrk_piece_mode)
+                    {
+                        int* tmp_rn = NULL;
+                        EIM_find_value(headers, row->line, "rn", EIM_integer, &tmp_rn);
 
-                    if (tmp_data != NULL)
+                        if (tmp_rn != NULL && *tmp_rn > first_rn && *tmp_rn <= last_rn)
+                        {
+                            str_len = piece_lens[*tmp_rn - first_rn - 1];
+                            valid_data = (str_len >= 0);
+                        }
+                    }
+                    else
                     {
-                        str_len = strlen(tmp_data);
+                        EIM_find_value(headers, row->line, "data", EIM_varchar, &tmp_data);
+
+                        if (tmp_data != NULL)
+                        {
+                            valid_data = slv_data_len(tmp_data, tmp_puid, &str_len);
+                        }
                     }
 
                     int *tmp_size = NULL;
                     EIM_find_value(headers, row->line, "stored_size", EIM_integer, &tmp_size);
 
-                    if (tmp_size != NULL)
+                    // Data that is not well formed UTF-8 is reported as unknown and its size is not corrected.
+                    if (!valid_data)
+                    {
+                        correction_required = false;
+                        rpt_unknown_cnt++;
+                    }
+                    else if (tmp_size != NULL)
                     {
                         if (*tmp_size < str_len)
                         {
@@ -11635,7 +13652,7 @@ static int validate_vla_long_string_sizes(const char* func, const char* cls, con
 
                     if (correction_required)
                     {
-                        //  resolves coverity defect 506020 : String Overflow
+                        //  resolves coverity defect 506025 : String Overflow
                         if (sizeof(cor_puids[cor_offset]) > strlen(tmp_puid))
                         {
                             strcpy(cor_puids[cor_offset], tmp_puid);
@@ -11645,7 +13662,6 @@ static int validate_vla_long_string_sizes(const char* func, const char* cls, con
                             ERROR_internal(ERROR_line, "Size not enough to copy '%s' ", tmp_puid);
                         }
 
-                        cor_pseqs[cor_offset] = *tmp_pseq;
                         cor_lens[cor_offset] = str_len;
                         cor_offset++;
                     }
@@ -11661,30 +13677,17 @@ static int validate_vla_long_string_sizes(const char* func, const char* cls, con
 
                 do
                 {
-                    logical valid_uids = false;
                     {
                         std::stringstream msg;
                         msg << "\nreference_manager -str_len_val -u=user -p=password -g=dba -from=" << cls << ":" << attr << " -commit";
 
                         for (int i = 0; i < 20 && counter < cor_offset; i++, counter++)
                         {
-                            std::string temp_uid = cor_puids[counter];
-                            it = dups.find(temp_uid);
-
-                            if (it == dups.end())
-                            {
-                                valid_uids = true;
-                                dups.insert(std::pair< std::string, int>(temp_uid, 0));
-                                msg << " -uid=" << (const char*)(cor_puids[counter]);
-                            }
+                            msg << " -uid=" << (const char*)(cor_puids[counter]);
                         }
                         msg << "\n";
 
-                        if (valid_uids)
-                        {
-                            valid_uids = false;
-                            logger()->printf(msg.str().c_str());
-                        }
+                        logger()->printf(msg.str().c_str());
                     }
                 } while (counter < cor_offset);
             }
@@ -11694,7 +13697,7 @@ static int validate_vla_long_string_sizes(const char* func, const char* cls, con
                 // 
                 // Update data lengths here. 
                 //
-                ifail = bulk_update_vla_integers(att_tbl, "pvall", cor_puids, cor_pseqs, cor_lens, cor_offset);
+                ifail = bulk_update_integers(cls_tbl, cls_col, cor_puids, cor_lens, cor_offset);
                 rpt_corrected_cnt += cor_offset;
             }
         }
@@ -11709,7 +13712,7 @@ static int validate_vla_long_string_sizes(const char* func, const char* cls, con
 
     ERROR_RECOVER
 
-        const std::string msg("EXCEPTION: See syslog for additional details.");
+    const std::string msg("EXCEPTION: See syslog for additional details.");
     cons_out(msg);
 
     if (!trans_was_active)
@@ -11723,8 +13726,7 @@ static int validate_vla_long_string_sizes(const char* func, const char* cls, con
     }
     ERROR_END
 
-        SM_free(cor_puids);
-    SM_free(cor_pseqs);
+    SM_free(cor_puids);
     SM_free(cor_lens);
 
     *bad_count = rpt_eligible_cnt;
@@ -11733,9 +13735,9 @@ static int validate_vla_long_string_sizes(const char* func, const char* cls, con
 }
 
 /*------------------------------------------------------------------------
-** Bulk update integers for specified VLA tables, UIDs.
+** Bulk update integers for specified UIDs.
 ** ----------------------------------------------------------------------- */
-static int bulk_update_vla_integers(const char *tbl, const char *col, EIM_uid_t *uids, int* seqs, int* ints, int size)
+static int bulk_update_integers(const char *tbl, const char *col, EIM_uid_t *uids, int* ints, int size)
 {
     int ifail = OK;
 
@@ -11747,7 +13749,6 @@ static int bulk_update_vla_integers(const char *tbl, const char *col, EIM_uid_t
     const int maxUpdateSize = EIM_get_max_insert_size();
     int         batch_size = 0;
     EIM_uid_t*  uid_ptr = uids;
-    int*        seq_ptr = seqs;
     int*        int_ptr = ints;
 
     if (maxUpdateSize < size)
@@ -11762,10 +13763,9 @@ static int bulk_update_vla_integers(const char *tbl, const char *col, EIM_uid_t
     }
 
     // Allocate an array of pointers to bind array value pointers.
-    EIM_bind_array_value_p_t bvs[3];
+    EIM_bind_array_value_p_t bvs[2];
     bvs[0] = static_cast<EIM_bind_array_value_p_t>(SM_alloc(sizeof(EIM_bind_array_value_t)));
     bvs[1] = static_cast<EIM_bind_array_value_p_t>(SM_alloc(sizeof(EIM_bind_array_value_t)));
-    bvs[2] = static_cast<EIM_bind_array_value_p_t>(SM_alloc(sizeof(EIM_bind_array_value_t)));
 
     bvs[0]->type = EIM_integer;
     bvs[0]->len = sizeof(int);
@@ -11779,12 +13779,6 @@ static int bulk_update_vla_integers(const char *tbl, const char *col, EIM_uid_t
     bvs[1]->ind = (short *)SM_calloc(batch_size, sizeof(short));
     bvs[1]->value = NULL;
 
-    bvs[2]->type = EIM_integer;
-    bvs[2]->len = sizeof(int);
-    bvs[2]->array_size = 0;
-    bvs[2]->ind = (short *)SM_calloc(batch_size, sizeof(short));
-    bvs[2]->value = NULL;
-
     int i = 0;
     int this_batch = size;
     this_batch = this_batch % batch_size;
@@ -11802,14 +13796,11 @@ static int bulk_update_vla_integers(const char *tbl, const char *col, EIM_uid_t
         bvs[1]->array_size = this_batch;
         bvs[1]->value = uid_ptr + i;
 
-        bvs[2]->array_size = this_batch;
-        bvs[2]->value = seq_ptr + i;
-
-        char* sql = SM_sprintf("UPDATE %s SET %s = :1 WHERE puid = :2 AND pseq = :3", tbl, col);
+        char* sql = SM_sprintf("UPDATE %s SET %s = :1 WHERE puid = :2", tbl, col);
 
         // Do update
-        ifail = EIM_exec_imm_array_bind(sql, "bulk_update_vla_integers(): bulk updating vla string lengths", this_batch, 3, bvs);
-        EIM_check_error("bulk_update_vla_integers(): bulk updating vla string lengths");
+        ifail = EIM_exec_imm_array_bind(sql, "bulk_update_integers(): bulk updating string lengths", this_batch, 2, bvs);
+        EIM_check_error("bulk_update_integers(): bulk updating string lengths");
 
         SM_free(sql);
 
@@ -11821,9 +13812,6 @@ static int bulk_update_vla_integers(const char *tbl, const char *col, EIM_uid_t
 
         bvs[1]->array_size = 0;
         bvs[1]->value = NULL;
-
-        bvs[2]->array_size = 0;
-        bvs[2]->value = NULL;
     }
 
     if (i != size)
@@ -11833,32 +13821,9 @@ static int bulk_update_vla_integers(const char *tbl, const char *col, EIM_uid_t
 
     SM_free(bvs[0]->ind);
     SM_free(bvs[1]->ind);
-    SM_free(bvs[2]->ind);
     SM_free(bvs[0]);
     SM_free(bvs[1]);
-    SM_free(bvs[2]);
-
-    return(ifail);
-}
 
-/*------------------------------------------------------------------------
-** Retrieves the calcualted and stored sizes for long string data.
-** Data is returned in ascending order by calculated size.
-** ----------------------------------------------------------------------- */
-static int get_la_long_string_sizes(const char *att_tbl, const char *att_col, const char* uid, std::vector< std::string >  *uid_vec, std::vector< std::string > &puids, std::vector< int > &pseqs, std::vector< int > &calc_sizes, std::vector< int > &stored_sizes)
-{
-    int ifail = get_vla_long_string_sizes(att_tbl, att_col, uid, uid_vec, puids, pseqs, calc_sizes, stored_sizes);
-    return(ifail);
-}
-    
-/*------------------------------------------------------------------------
-** Validate that the actual string sizes match the stored string sizes
-** and optionally correct the stored string sizes.
-** The input calculated sizes must be in assending order.
-** ----------------------------------------------------------------------- */
-static int validate_la_long_string_sizes(const char* cls, const char* attr, const char *att_tbl, const char *att_col, std::vector< std::string > &puids, std::vector< int > &pseqs, std::vector< int > &calc_sizes, int* bad_count)
-{
-    int ifail = validate_vla_long_string_sizes("LSt(LA)", cls, attr, att_tbl, att_col, puids, pseqs, calc_sizes, bad_count);
     return(ifail);
 }
 
@@ -11866,402 +13831,1711 @@ static int validate_la_long_string_sizes(const char* cls, const char* attr, cons
 ** Retrieves the calcualted and stored sizes for long string data.
 ** Data is returned in ascending order by calculated size.
 ** ----------------------------------------------------------------------- */
-static int get_sa_long_string_sizes(const char *att_tbl, const char *att_col, const char* uid, std::vector< std::string >  *uid_vec, std::vector< std::string > &puids, std::vector< int > &pseqs, std::vector< int > &calc_sizes, std::vector< int > &stored_sizes)
-{
-    int ifail = get_vla_long_string_sizes(att_tbl, att_col, uid, uid_vec, puids, pseqs, calc_sizes, stored_sizes);
-    return(ifail);
-}
-
-/*------------------------------------------------------------------------
-** Validate that the actual string sizes match the stored string sizes
-** and optionally correct the stored string sizes.
-** The input calculated sizes must be in assending order.
-** ----------------------------------------------------------------------- */
-static int validate_sa_long_string_sizes(const char* cls, const char* attr, const char *att_tbl, const char *att_col, std::vector< std::string > &puids, std::vector< int > &pseqs, std::vector< int > &calc_sizes, int* bad_count)
-{
-    int ifail = validate_vla_long_string_sizes("LSt(SA)", cls, attr, att_tbl, att_col, puids, pseqs, calc_sizes, bad_count);
-    return(ifail);
-}
-
-/* ********************************************************************************
-** END OF: str_len_val_op() routines.
-** *******************************************************************************/
-
-/*------------------------------------------------------------------------
-** Validate that the system is configured for database transactions
-** and return op-not-supported if not configued. 
-** ----------------------------------------------------------------------- */
-static int database_tx_check()
+static int get_vla_long_string_sizes(const char *att_tbl, const char *att_col, const char* uid, std::vector< std::string >  *uid_vec, std::vector< std::string > &puids, std::vector< int > &pseqs, std::vector< int > &calc_sizes, std::vector< int > &stored_sizes)
 {
     int ifail = OK;
 
-#ifndef PRE_TC131_PLATFORM
-    if (!Teamcenter::POMUtilityTransaction::IsDbTxEnabled())
-    {
-        ifail = error_out(ERROR_line, POM_op_not_supported, "Ref_Mgr requires database transactions, remove the TC_DISABLE_UTIL_TRANSACTIONS environment variable.");
-    }
-#else
-    if (getenv("TC_DISABLE_TRANSACTIONS") != NULL)
+    if ( EIM_dbplat() != EIM_dbplat_mssql && EIM_dbplat() != EIM_dbplat_oracle && !slv_client_side() )
     {
-        ifail = error_out(ERROR_line, POM_op_not_supported, "Ref_Mgr requires database transactions, temporarily remove the TC_DISABLE_TRANSACTIONS environment variable from this session.");
+        ERROR_raise(ERROR_line, POM_internal_error, "Functionality is not supported for RDBMSs other than MS SQL Server, Oracle and Postgres.");
     }
-#endif
-    return(ifail);
-}
 
-/*-----------------------------------------------------------------------*/
-/* Outputs the POM_stub details assocaited with the specfied object uid. */
-static void output_stub_details( std::vector<std::string>* uid_vec, int* found_count )
-{
-    *found_count = -1;
-    int actual_found = 0;
+    puids.clear();
+    pseqs.clear();
+    calc_sizes.clear();
+    stored_sizes.clear();
+
     logical trans_was_active = true;
+    EIM_select_var_t vars[4];
+    EIM_value_p_t headers = NULL;
+    EIM_row_p_t report = NULL;
+    EIM_row_p_t row;
 
-    if ( !EIM_is_transaction_active( ) )
-    {
-        trans_was_active = false;
-        EIM_start_transaction( );
-    }
+    ERROR_PROTECT
 
-    cons_out( "" );
+        if (!EIM_is_transaction_active())
+        {
+            trans_was_active = false;
+            EIM_start_transaction();
+        }
 
-    ERROR_PROTECT
+    std::stringstream sql;
 
-    for ( int i = 0; i < uid_vec->size( ); i++ )
+    // On the client-side platforms an upper bound of the byte length orders the keys and sizes the fetch
+    // buffer, the data itself is measured by validate_vla_long_string_sizes().
+    if ( slv_client_side() )
     {
-        int ifail = OK;
-        EIM_select_var_t vars[8];
-        EIM_value_p_t headers = NULL;
-        EIM_row_p_t report = NULL;
-        EIM_row_p_t row;
-        int row_cnt = 0;
+        sql << "SELECT a.puid puid, a.pseq pseq, a.pvall stored_size, " << slv_client_byte_len_expr( std::string( "a." ) + att_col ) << " calc_size FROM " << att_tbl << " a";
+    }
+    else
+    {
+        sql << "SELECT a.puid puid, a.pseq pseq, a.pvall stored_size, " << db_byte_len_fun() << "(a." << att_col << ") calc_size FROM " << att_tbl << " a";
+    }
 
-        const char* sql = "SELECT puid, pobject_uid, pobject_class, pobject_id, pobject_name, pobject_desc, powning_user_id, pstatus_flag FROM PPOM_STUB WHERE pobject_uid = :1";
 
-        EIM_select_col( &(vars[0]), EIM_puid, "puid", MAX_UID_SIZE, false );
-        EIM_select_col( &(vars[1]), EIM_puid, "pobject_uid", 34, false );
-        EIM_select_col( &(vars[2]), EIM_varchar, "pobject_class", 30, true );
-        EIM_select_col( &(vars[3]), EIM_varchar, "pobject_id", 258, true );
-        EIM_select_col( &(vars[4]), EIM_varchar, "pobject_name", 258, true );
-        EIM_select_col( &(vars[5]), EIM_varchar, "pobject_desc", 242, true );
-        EIM_select_col( &(vars[6]), EIM_varchar, "powning_user_id", 130, true );
-        EIM_select_col( &(vars[7]), EIM_varchar, "pstatus_flag", sizeof( int ), true );
+    append_uid_filter(sql, " WHERE a.puid", uid, uid_vec);
 
-        EIM_bind_var_t bindVars[1];
-        EIM_bind_val( &bindVars[0], EIM_puid, strlen( uid_vec->at( i ).c_str( ) ) + 1, (uid_vec->at( i ).c_str( )) );
-        ifail = EIM_exec_sql_bind( sql, &headers, &report, 0, 8, vars, 1, bindVars );
+    sql << " ORDER BY calc_size ASC";
 
-        if ( !args->ignore_errors_flag )
-        {
-            EIM_check_error( "output_stub_details()\n" );
-        }
-        else if ( ifail != OK )
-        {
-            EIM_clear_error( );
-            EIM_free_result( headers, report );
-            report = NULL;
-            headers = NULL;
+    EIM_select_col(&(vars[0]), EIM_puid, "puid", EIM_uid_length + 1, false);
+    EIM_select_col(&(vars[1]), EIM_integer, "pseq", sizeof(int), false);
+    EIM_select_col(&(vars[2]), EIM_integer, "stored_size", sizeof(int), false);
+    EIM_select_col(&(vars[3]), EIM_integer, "calc_size", sizeof(int), false);
 
-            std::stringstream msg;
-            msg << uid_vec->at( i ) << ":  Error while quering the database";
-            cons_out( msg.str( ) );
-        }
+    ifail = EIM_exec_sql_bind(sql.str().c_str(), &headers, &report, 0, 4, vars, 0, NULL);
+    EIM_check_error("Retrieving vla long-string sizes\n");
 
-        if ( report != NULL )
+    if (report != NULL)
+    {
+        for (row = report; row != NULL; row = row->next)
         {
-            std::stringstream msg;
-            row_cnt = 0;
-
-            for ( row = report; row != NULL; row = row->next )
-                row_cnt++;
+            char* tmp_puid = NULL;
+            EIM_find_value(headers, row->line, "puid", EIM_puid, &tmp_puid);
+            puids.push_back(tmp_puid);
 
-            row = report;
-            msg << uid_vec->at( i ) << ":\n";
+            int* tmp_size = NULL;
+            EIM_find_value(headers, row->line, "pseq", EIM_integer, &tmp_size);
 
-            for ( int j = 0; j < row_cnt; j++, actual_found++ )
+            if (tmp_size != NULL)
             {
+                pseqs.push_back(*tmp_size);
+            }
+            else
+            {
+                pseqs.push_back(0);
+            }
 
-                char* ptr = NULL;
-                EIM_find_value( headers, row->line, "puid", EIM_puid, &ptr );
-                msg << "  " << actual_found + 1 << "  uid            = " << ptr << "\n";
-
-                ptr = NULL;
-                EIM_find_value( headers, row->line, "pobject_uid", EIM_puid, &ptr );
-                msg << "     object_uid     = " << ptr << "\n";
+            tmp_size = NULL;
+            EIM_find_value(headers, row->line, "stored_size", EIM_integer, &tmp_size);
 
-                ptr = NULL;
-                EIM_find_value( headers, row->line, "pobject_class", EIM_varchar, &ptr );
+            if (tmp_size != NULL)
+            {
+                stored_sizes.push_back(*tmp_size);
+            }
+            else
+            {
+                stored_sizes.push_back(0);
+            }
 
-                if ( ptr == NULL )
-                {
-                    msg << "     object_class   = NULL\n";
-                }
-                else
-                {
-                    msg << "     object_class   = " << ptr << "\n";
-                }
+            tmp_size = NULL;
+            EIM_find_value(headers, row->line, "calc_size", EIM_integer, &tmp_size);
 
-                ptr = NULL;
-                EIM_find_value( headers, row->line, "pobject_id", EIM_varchar, &ptr );
+            if (tmp_size != NULL)
+            {
+                calc_sizes.push_back(*tmp_size);
+            }
+            else
+            {
+                calc_sizes.push_back(0);
+            }
+        }
+        EIM_free_result(headers, report);
+        report = NULL;
+        headers = NULL;
+    }
 
-                if ( ptr == NULL )
-                {
-                    msg << "     object_id      = NULL\n";
-                }
-                else
-                {
-                    msg << "     object_id      = " << ptr << "\n";
-                }
+    if (!trans_was_active)
+    {
+        EIM_commit_transaction("get_long_string_sizes()");
+    }
 
-                ptr = NULL;
-                EIM_find_value( headers, row->line, "pobject_name", EIM_varchar, &ptr );
+    ERROR_RECOVER
 
-                if ( ptr == NULL )
+    const std::string msg("EXCEPTION: See syslog for additional details.");
+    cons_out(msg);
+
+    if (!trans_was_active)
+    {
+        EIM__clear_transaction(ERROR_ask_failure_code());
+        ERROR_raise(ERROR_line, EIM_ask_abort_code(), "Failed to execute the query\n");
+    }
+    else
+    {
+        ERROR_reraise();
+    }
+    ERROR_END
+
+    return(ifail);
+}
+
+/*------------------------------------------------------------------------
+** Validate that the actual string sizes match the stored string sizes
+** and optionally correct the stored string sizes.
+** The input calculated sizes must be in assending order.
+** ----------------------------------------------------------------------- */
+static int validate_vla_long_string_sizes(const char* func, const char* cls, const char* attr, const char *att_tbl, const char *att_col, std::vector< std::string > &puids, std::vector< int > &pseqs, std::vector< int > &calc_sizes, int* bad_count)
+{
+    int ifail = OK;
+    // RM_SLV_ stands for Reference Manager String Length Validation
+    int rm_slv_batch_size = 65500;       // Number of records processed per batch
+    int rm_slv_max_len = 200000;         // Maximum length of records within the batch
+    int rm_slv_percent_exp = 30;         // Percentage of expected expansion due to none single byte characters
+    int rm_slv_fixed_exp = 100;          // Additional fixed byte expansion to provide additional memory for unforseen expansions...
+    int rm_slv_max_mem_m = 6000;         // Maximum memory to be used within each batch... before the batch is shrunk.
+    long rm_slv_max_int = 2147483647;    // Maximum integer value
+    int64_t rm_slv_meg = 1024 * 1024;       // Megabyte
+
+    int rpt_worked_cnt = 0;              // Number of records that were processed
+    int rpt_success_cnt = 0;             // Number of records where data length matches the stored length
+    int rpt_under_cnt = 0;               // Number of records where the stored count under represents the data length
+    int rpt_over_cnt = 0;                // Number of records where the stored count over represents the data length
+    int rpt_unknown_cnt = 0;             // Number of records that we don't know about (NULL for size returned etc...)
+    int rpt_eligible_cnt = 0;            // Number of records that are eligible for correction
+    int rpt_corrected_cnt = 0;           // Number of records where the stored count was actually corrected
+
+    int wrk_start_pos = 0;               // UID to start with.
+    int wrk_batch_size = 0;              // Batch size for the current SQL statement
+    int wrk_max_len = 0;                 // Max data length for this SQL statement on this platform
+    int wrk_max_calc = 0;                // The maximum caculated size for this batch
+    logical wrk_piece_mode = false;      // The batch holds records larger than rm_slv_max_len
+    std::vector< int > piece_lens;       // Byte lengths summed by SLV_piece_lens() for the batch
+
+                                         // Check configuration values. 
+    rm_slv_batch_size  = DDS_ask_pom_parameter_int("rm_slv_batch_size",  rm_slv_batch_size);
+    rm_slv_max_len     = DDS_ask_pom_parameter_int("rm_slv_max_len",     rm_slv_max_len);
+    rm_slv_percent_exp = DDS_ask_pom_parameter_int("rm_slv_percent_exp", rm_slv_percent_exp);
+    rm_slv_fixed_exp   = DDS_ask_pom_parameter_int("rm_slv_fixed_exp",   rm_slv_fixed_exp);
+    rm_slv_max_mem_m   = DDS_ask_pom_parameter_int("rm_slv_max_mem_m",   rm_slv_max_mem_m);
+    EIM_uid_t* cor_puids = NULL;
+    int*       cor_pseqs = NULL;
+    int*       cor_lens = NULL;
+
+    int storge_bytes_per_ascii_char = 2;    // For unicode there are two bytes for every ascii character
+
+    if (!EIM_unicode_enabled())
+    {
+        storge_bytes_per_ascii_char = 1;    // If not unicode we assume UTF-8, in which case we have 1 storage byte per ascii character
+    }
+
+    // Filter to ensure that we output bad uids only once into the syslog. 
+    std::map< std::string, int > dups;
+    std::map< std::string, int >::iterator it;
+
+    // Make sure we limit the batch size so that we don't use significantly more memory than the maximum configured.
+    int64_t temp_cnt = rm_slv_meg * rm_slv_max_mem_m / rm_slv_max_len;
+
+    if (temp_cnt < rm_slv_batch_size)
+    {
+        rm_slv_batch_size = (int)temp_cnt;
+    }
+
+    if (calc_sizes.size() < rm_slv_batch_size)
+    {
+        rm_slv_batch_size = calc_sizes.size();
+    }
+
+    if (rm_slv_batch_size < 1)
+    {
+        rm_slv_batch_size = 1;
+    }
+
+    // Records larger than rm_slv_max_len are read in pieces, each key holding one piece buffer.
+    int rm_slv_piece_chars = SLV_piece_chars(rm_slv_max_len);
+    int rm_slv_piece_len = (rm_slv_piece_chars * 4) + 1;
+    int rm_slv_piece_batch = rm_slv_batch_size;
+
+    temp_cnt = rm_slv_meg * rm_slv_max_mem_m / rm_slv_piece_len;
+    if (temp_cnt < rm_slv_piece_batch)
+    {
+        rm_slv_piece_batch = (int)temp_cnt;
+    }
+
+    if (rm_slv_piece_batch < 1)
+    {
+        rm_slv_piece_batch = 1;
+    }
+
+    cor_puids = (EIM_uid_t*)SM_alloc(sizeof(EIM_uid_t) * (rm_slv_batch_size + 1));
+    cor_pseqs = (int*)SM_alloc(sizeof(int) * (rm_slv_batch_size + 1));
+    cor_lens = (int*)SM_alloc(sizeof(int) * (rm_slv_batch_size + 1));
+
+    logical trans_was_active = true;
+    EIM_select_var_t vars[4];
+    EIM_bind_var_t bind_vars[2];
+    int first_rn = 0;
+    int last_rn = 0;
+    EIM_value_p_t headers = NULL;
+    EIM_row_p_t report = NULL;
+    EIM_row_p_t row;
+
+    ERROR_PROTECT
+
+    str_len_val_status(true, "Start ", func, puids.size(), rpt_worked_cnt, rpt_under_cnt, rpt_over_cnt, rpt_success_cnt, rpt_unknown_cnt, rpt_eligible_cnt, rpt_corrected_cnt);
+
+    SLV_stage_keys(puids, &pseqs);
+
+    while (wrk_start_pos < puids.size())
+    {
+        trans_was_active = true;
+
+        if (!EIM_is_transaction_active())
+        {
+            trans_was_active = false;
+            EIM_start_transaction();
+        }
+
+        int cor_offset = 0;
+
+        // The keys are ordered by calculated size, so once a record is larger than rm_slv_max_len
+        // every remaining record is too. Those are measured a piece at a time by SLV_piece_lens(). 
+
+        wrk_batch_size = 1;
+        wrk_max_calc = 0;
+        wrk_piece_mode = (calc_sizes[wrk_start_pos] / storge_bytes_per_ascii_char > rm_slv_max_len);
+
+        if (wrk_piece_mode)
+        {
+            wrk_batch_size = rm_slv_piece_batch;
+
+            if (wrk_batch_size > (int)puids.size() - wrk_start_pos)
+            {
+                wrk_batch_size = (int)puids.size() - wrk_start_pos;
+            }
+        }
+        else
+        {
+            int term_pos = wrk_start_pos;
+
+            for (int j = 0; j < rm_slv_batch_size && term_pos < puids.size(); j++, term_pos++)
+            {
+                if (calc_sizes[wrk_start_pos + j] / storge_bytes_per_ascii_char > rm_slv_max_len)
                 {
-                    msg << "     object_name    = NULL\n";
+                    break;
                 }
-                else
+
+                if (calc_sizes[wrk_start_pos + j] > wrk_max_calc)
                 {
-                    msg << "     object_name    = " << ptr << "\n";
+                    wrk_max_calc = calc_sizes[wrk_start_pos + j];
                 }
+            }
+
+            if (term_pos - wrk_start_pos > 1)
+            {
+                wrk_batch_size = term_pos - wrk_start_pos;
+            }
+        }
+
+        if (wrk_batch_size > 0)
+        {
+            // Calculate max buffer size based on configured expected expansion ratio.
+            // Start with the largest cacluate size in our batch.
+            long tmp_max_len = wrk_max_calc;
+
+            if (EIM_unicode_enabled() && EIM_dbplat() == EIM_dbplat_mssql)
+            {
+                tmp_max_len = tmp_max_len >> 1;
+                tmp_max_len++;
+            }
+
+            tmp_max_len = tmp_max_len + (long)(tmp_max_len * rm_slv_percent_exp / 100) + rm_slv_fixed_exp;
+
+            if (tmp_max_len > rm_slv_max_int)
+            {
+                wrk_max_len = (int)rm_slv_max_int;
+            }
+            else
+            {
+                wrk_max_len = (int)tmp_max_len;
+            }
+
+            // Build SQL to retrieve actual data from the database
+            std::stringstream sql;
+
+            sql << "SELECT a.puid puid, a.pseq pseq, ";
+            if (wrk_piece_mode)
+            {
+                sql << "k.rn rn";
+            }
+            else
+            {
+                sql << "a." << att_col << " data";
+            }
+            sql << ", a.pvall stored_size";
+            sql << " FROM " << att_tbl << " a, " << tbl_slv_keys << " k WHERE a.puid = k.puid AND a.pseq = k.pseq AND k.rn > :1 AND k.rn <= :2";
+
+            SLV_bind_key_range(bind_vars, &first_rn, &last_rn, wrk_start_pos, wrk_batch_size);
+            wrk_start_pos += wrk_batch_size;
+
+            if (wrk_piece_mode)
+            {
+                SLV_piece_lens(att_tbl, att_col, true, first_rn, last_rn, rm_slv_piece_chars, rm_slv_piece_len, piece_lens);
+            }
+
+            EIM_select_col(&(vars[0]), EIM_puid, "puid", EIM_uid_length + 1, false);
+            EIM_select_col(&(vars[1]), EIM_integer, "pseq", sizeof(int), false);
+            if (wrk_piece_mode)
+            {
+                EIM_select_col(&(vars[2]), EIM_integer, "rn", sizeof(int), false);
+            }
+            else
+            {
+                EIM_select_col(&(vars[2]), EIM_varchar, "data", wrk_max_len, false);
+            }
+            EIM_select_col(&(vars[3]), EIM_integer, "stored_size", sizeof(int), false);
+
+            ifail = EIM_exec_sql_bind(sql.str().c_str(), &headers, &report, 0, 4, vars, 2, bind_vars);
+            EIM_check_error("Retrieving long-string data\n");
+
+            if (report != NULL)
+            {
+                for (row = report; row != NULL; row = row->next)
+                {
+                    rpt_worked_cnt++;
+
+                    char* tmp_puid = NULL;
+                    EIM_find_value(headers, row->line, "puid", EIM_puid, &tmp_puid);
+
+                    int* tmp_pseq = NULL;
+                    EIM_find_value(headers, row->line, "pseq", EIM_integer, &tmp_pseq);
+
+                    if (tmp_puid == NULL || tmp_pseq == NULL)
+                    {
+                        rpt_unknown_cnt++;
+                        continue;
+                    }
+
+                    char* tmp_data = NULL;
+                    int str_len = 0;
+                    logical correction_required = false;
+                    logical valid_data = true;
+
+                    if (wrk_piece_mode)
+                    {
+                        int* tmp_rn = NULL;
+                        EIM_find_value(headers, row->line, "rn", EIM_integer, &tmp_rn);
+
+                        if (tmp_rn != NULL && *tmp_rn > first_rn && *tmp_rn <= last_rn)
+                        {
+                            str_len = piece_lens[*tmp_rn - first_rn - 1];
+                            valid_data = (str_len >= 0);
+                        }
+                    }
+                    else
+                    {
+                        EIM_find_value(headers, row->line, "data", EIM_varchar, &tmp_data);
+
+                        if (tmp_data != NULL)
+                        {
+                            valid_data = slv_data_len(tmp_data, tmp_puid, &str_len);
+                        }
+                    }
+
+                    int *tmp_size = NULL;
+                    EIM_find_value(headers, row->line, "stored_size", EIM_integer, &tmp_size);
+
+                    // Data that is not well formed UTF-8 is reported as unknown and its size is not corrected.
+                    if (!valid_data)
+                    {
+                        correction_required = false;
+                        rpt_unknown_cnt++;
+                    }
+                    else if (tmp_size != NULL)
+                    {
+                        if (*tmp_size < str_len)
+                        {
+                            correction_required = true;
+                            rpt_eligible_cnt++;
+                            rpt_under_cnt++;
+                        }
+                        else if (*tmp_size > str_len)
+                        {
+                            correction_required = true;
+                            rpt_eligible_cnt++;
+                            rpt_over_cnt++;
+                        }
+                        else
+                        {
+                            correction_required = false;
+                            rpt_success_cnt++;
+                        }
+                    }
+                    else
+                    {
+                        correction_required = true;
+                        rpt_eligible_cnt++;
+                        rpt_unknown_cnt++;
+                    }
+
+                    if (correction_required)
+                    {
+                        //  resolves coverity defect 506020 : String Overflow
+                        if (sizeof(cor_puids[cor_offset]) > strlen(tmp_puid))
+                        {
+                            strcpy(cor_puids[cor_offset], tmp_puid);
+                        }
+                        else
+                        {
+                            ERROR_internal(ERROR_line, "Size not enough to copy '%s' ", tmp_puid);
+                        }
+
+                        cor_pseqs[cor_offset] = *tmp_pseq;
+                        cor_lens[cor_offset] = str_len;
+                        cor_offset++;
+                    }
+                }
+                EIM_free_result(headers, report);
+                report = NULL;
+                headers = NULL;
+            }
+
+            if (cor_offset > 0 && DDS_is_pom_parameter_enabled("RM_STR_LEN_LOG_BAD_UIDS", true))
+            {
+                int counter = 0;
+
+                do
+                {
+                    logical valid_uids = false;
+                    {
+                        std::stringstream msg;
+                        msg << "\nreference_manager -str_len_val -u=user -p=password -g=dba -from=" << cls << ":" << attr << " -commit";
+
+                        for (int i = 0; i < 20 && counter < cor_offset; i++, counter++)
+                        {
+                            std::string temp_uid = cor_puids[counter];
+                            it = dups.find(temp_uid);
+
+                            if (it == dups.end())
+                            {
+                                valid_uids = true;
+                                dups.insert(std::pair< std::string, int>(temp_uid, 0));
+                                msg << " -uid=" << (const char*)(cor_puids[counter]);
+                            }
+                        }
+                        msg << "\n";
+
+                        if (valid_uids)
+                        {
+                            valid_uids = false;
+                            logger()->printf(msg.str().c_str());
+                        }
+                    }
+                } while (counter < cor_offset);
+            }
+
+            if (cor_offset > 0 && args->commit_flag)
+            {
+                // 
+                // Update data lengths here. 
+                //
+                ifail = bulk_update_vla_integers(att_tbl, "pvall", cor_puids, cor_pseqs, cor_lens, cor_offset);
+                rpt_corrected_cnt += cor_offset;
+            }
+        }
+
+        str_len_val_status(false, NULL, func, puids.size(), rpt_worked_cnt, rpt_under_cnt, rpt_over_cnt, rpt_success_cnt, rpt_unknown_cnt, rpt_eligible_cnt, rpt_corrected_cnt);
+
+        if (!trans_was_active)
+        {
+            EIM_commit_transaction("validate_long_string_sizes()");
+        }
+    }
+
+    ERROR_RECOVER
+
+        const std::string msg("EXCEPTION: See syslog for additional details.");
+    cons_out(msg);
+
+    if (!trans_was_active)
+    {
+        EIM__clear_transaction(ERROR_ask_failure_code());
+        ERROR_raise(ERROR_line, EIM_ask_abort_code(), "Failed to execute the query\n");
+    }
+    else
+    {
+        ERROR_reraise();
+    }
+    ERROR_END
+
+        SM_free(cor_puids);
+    SM_free(cor_pseqs);
+    SM_free(cor_lens);
+
+    *bad_count = rpt_eligible_cnt;
+    str_len_val_status(true, "Final ", func, puids.size(), rpt_worked_cnt, rpt_under_cnt, rpt_over_cnt, rpt_success_cnt, rpt_unknown_cnt, rpt_eligible_cnt, rpt_corrected_cnt);
+    return(ifail);
+}
+
+/*------------------------------------------------------------------------
+** Bulk update integers for specified VLA tables, UIDs.
+** ----------------------------------------------------------------------- */
+static int bulk_update_vla_integers(const char *tbl, const char *col, EIM_uid_t *uids, int* seqs, int* ints, int size)
+{
+    int ifail = OK;
+
+    if (size < 1)
+    {
+        return(ifail);
+    }
+
+    const int maxUpdateSize = EIM_get_max_insert_size();
+    int         batch_size = 0;
+    EIM_uid_t*  uid_ptr = uids;
+    int*        seq_ptr = seqs;
+    int*        int_ptr = ints;
+
+    if (maxUpdateSize < size)
+    {
+        batch_size = maxUpdateSize;
+        if (batch_size < 1)
+            batch_size = EIM_ARRAY_MAX_SIZE;
+    }
+    else
+    {
+        batch_size = size;
+    }
+
+    // Allocate an array of pointers to bind array value pointers.
+    EIM_bind_array_value_p_t bvs[3];
+    bvs[0] = static_cast<EIM_bind_array_value_p_t>(SM_alloc(sizeof(EIM_bind_array_value_t)));
+    bvs[1] = static_cast<EIM_bind_array_value_p_t>(SM_alloc(sizeof(EIM_bind_array_value_t)));
+    bvs[2] = static_cast<EIM_bind_array_value_p_t>(SM_alloc(sizeof(EIM_bind_array_value_t)));
+
+    bvs[0]->type = EIM_integer;
+    bvs[0]->len = sizeof(int);
+    bvs[0]->array_size = 0;
+    bvs[0]->ind = (short *)SM_calloc(batch_size, sizeof(short));
+    bvs[0]->value = NULL;
+
+    bvs[1]->type = EIM_puid;
+    bvs[1]->len = sizeof(EIM_uid_t);
+    bvs[1]->array_size = 0;
+    bvs[1]->ind = (short *)SM_calloc(batch_size, sizeof(short));
+    bvs[1]->value = NULL;
+
+    bvs[2]->type = EIM_integer;
+    bvs[2]->len = sizeof(int);
+    bvs[2]->array_size = 0;
+    bvs[2]->ind = (short *)SM_calloc(batch_size, sizeof(short));
+    bvs[2]->value = NULL;
+
+    int i = 0;
+    int this_batch = size;
+    this_batch = this_batch % batch_size;
+
+    if (this_batch == 0)
+    {
+        this_batch = batch_size;
+    }
+
+    while (i < size)
+    {
+        bvs[0]->array_size = this_batch;
+        bvs[0]->value = int_ptr + i;
+
+        bvs[1]->array_size = this_batch;
+        bvs[1]->value = uid_ptr + i;
+
+        bvs[2]->array_size = this_batch;
+        bvs[2]->value = seq_ptr + i;
+
+        char* sql = SM_sprintf("UPDATE %s SET %s = :1 WHERE puid = :2 AND pseq = :3", tbl, col);
+
+        // Do update
+        ifail = EIM_exec_imm_array_bind(sql, "bulk_update_vla_integers(): bulk updating vla string lengths", this_batch, 3, bvs);
+        EIM_check_error("bulk_update_vla_integers(): bulk updating vla string lengths");
+
+        SM_free(sql);
+
+        i = i + this_batch;
+        this_batch = batch_size;
+
+        bvs[0]->array_size = 0;
+        bvs[0]->value = NULL;
+
+        bvs[1]->array_size = 0;
+        bvs[1]->value = NULL;
+
+        bvs[2]->array_size = 0;
+        bvs[2]->value = NULL;
+    }
+
+    if (i != size)
+    {
+        ERROR_raise(ERROR_line, POM_internal_error, "validate_long_string_sizes(): Not all data written to %s table, missing at least %d records. (%d)", tbl, size - i, ifail);
+    }
+
+    SM_free(bvs[0]->ind);
+    SM_free(bvs[1]->ind);
+    SM_free(bvs[2]->ind);
+    SM_free(bvs[0]);
+    SM_free(bvs[1]);
+    SM_free(bvs[2]);
+
+    return(ifail);
+}
+
+/*------------------------------------------------------------------------
+** Retrieves the calcualted and stored sizes for long string data.
+** Data is returned in ascending order by calculated size.
+** ----------------------------------------------------------------------- */
+static int get_la_long_string_sizes(const char *att_tbl, const char *att_col, const char* uid, std::vector< std::string >  *uid_vec, std::vector< std::string > &puids, std::vector< int > &pseqs, std::vector< int > &calc_sizes, std::vector< int > &stored_sizes)
+{
+    int ifail = get_vla_long_string_sizes(att_tbl, att_col, uid, uid_vec, puids, pseqs, calc_sizes, stored_sizes);
+    return(ifail);
+}
+    
+/*------------------------------------------------------------------------
+** Validate that the actual string sizes match the stored string sizes
+** and optionally correct the stored string sizes.
+** The input calculated sizes must be in assending order.
+** ----------------------------------------------------------------------- */
+static int validate_la_long_string_sizes(const char* cls, const char* attr, const char *att_tbl, const char *att_col, std::vector< std::string > &puids, std::vector< int > &pseqs, std::vector< int > &calc_sizes, int* bad_count)
+{
+    int ifail = validate_vla_long_string_sizes("LSt(LA)", cls, attr, att_tbl, att_col, puids, pseqs, calc_sizes, bad_count);
+    return(ifail);
+}
+
+/*------------------------------------------------------------------------
+** Retrieves the calcualted and stored sizes for long string data.
+** Data is returned in ascending order by calculated size.
+** ----------------------------------------------------------------------- */
+static int get_sa_long_string_sizes(const char *att_tbl, const char *att_col, const char* uid, std::vector< std::string >  *uid_vec, std::vector< std::string > &puids, std::vector< int > &pseqs, std::vector< int > &calc_sizes, std::vector< int > &stored_sizes)
+{
+    int ifail = get_vla_long_string_sizes(att_tbl, att_col, uid, uid_vec, puids, pseqs, calc_sizes, stored_sizes);
+    return(ifail);
+}
+
+/*------------------------------------------------------------------------
+** Validate that the actual string sizes match the stored string sizes
+** and optionally correct the stored string sizes.
+** The input calculated sizes must be in assending order.
+** ----------------------------------------------------------------------- */
+static int validate_sa_long_string_sizes(const char* cls, const char* attr, const char *att_tbl, const char *att_col, std::vector< std::string > &puids, std::vector< int > &pseqs, std::vector< int > &calc_sizes, int* bad_count)
+{
+    int ifail = validate_vla_long_string_sizes("LSt(SA)", cls, attr, att_tbl, att_col, puids, pseqs, calc_sizes, bad_count);
+    return(ifail);
+}
+
+/* ********************************************************************************
+** END OF: str_len_val_op() routines.
+** *******************************************************************************/
+
+/*------------------------------------------------------------------------
+** Validate that the system is configured for database transactions
+** and return op-not-supported if not configued. 
+** ----------------------------------------------------------------------- */
+static int database_tx_check()
+{
+    int ifail = OK;
+
+#ifndef PRE_TC131_PLATFORM
+    if (!Teamcenter::POMUtilityTransaction::IsDbTxEnabled())
+    {
+        ifail = error_out(ERROR_line, POM_op_not_supported, "Ref_Mgr requires database transactions, remove the TC_DISABLE_UTIL_TRANSACTIONS environment variable.");
+    }
+#else
+    if (getenv("TC_DISABLE_TRANSACTIONS") != NULL)
+    {
+        ifail = error_out(ERROR_line, POM_op_not_supported, "Ref_Mgr requires database transactions, temporarily remove the TC_DISABLE_TRANSACTIONS environment variable from this session.");
+    }
+#endif
+    return(ifail);
+}
+
+static const int   STUB_PAGE_UIDS = 10000;   // UIDs staged and queried per PPOM_STUB statement.
+static const int   STUB_COL_CNT   = 8;
+static const char* stub_col_names[STUB_COL_CNT]  = { "puid", "pobject_uid", "pobject_class", "pobject_id", "pobject_name", "pobject_desc", "powning_user_id", "pstatus_flag" };
+static const char* stub_col_labels[STUB_COL_CNT] = { "uid           ", "object_uid    ", "object_class  ", "object_id     ", "object_name   ", "object_desc   ", "owning_user_id", "status_flag   " };
+
+/* One PPOM_STUB row, NULL columns are flagged in null_mask (bit per column). */
+typedef struct stub_row_s
+{
+    std::string cols[STUB_COL_CNT];
+    int         null_mask;
+} stub_row_t;
+
+/*-----------------------------------------------------------------------*/
+/* Fetches the PPOM_STUB rows of a page of object uids in one statement, */
+/* the uids are staged in the UID set table. Returns EIM's failure code. */
+static int fetch_stub_page( std::vector<std::string>& page, std::map< std::string, std::vector<stub_row_t> >& stubs )
+{
+    EIM_select_var_t vars[STUB_COL_CNT];
+    EIM_value_p_t headers = NULL;
+    EIM_row_p_t report = NULL;
+
+    UID_SET_stage( &page );
+
+    std::stringstream sql;
+    sql << "SELECT puid, pobject_uid, pobject_class, pobject_id, pobject_name, pobject_desc, powning_user_id, pstatus_flag FROM PPOM_STUB"
+        << " WHERE pobject_uid IN (SELECT " << uid_set_col_name << " FROM " << tbl_uid_set << ")";
+
+    EIM_select_col( &(vars[0]), EIM_puid, "puid", MAX_UID_SIZE, false );
+    EIM_select_col( &(vars[1]), EIM_puid, "pobject_uid", 34, false );
+    EIM_select_col( &(vars[2]), EIM_varchar, "pobject_class", 30, true );
+    EIM_select_col( &(vars[3]), EIM_varchar, "pobject_id", 258, true );
+    EIM_select_col( &(vars[4]), EIM_varchar, "pobject_name", 258, true );
+    EIM_select_col( &(vars[5]), EIM_varchar, "pobject_desc", 242, true );
+    EIM_select_col( &(vars[6]), EIM_varchar, "powning_user_id", 130, true );
+    EIM_select_col( &(vars[7]), EIM_varchar, "pstatus_flag", sizeof( int ), true );
+
+    int ifail = EIM_exec_sql_bind( sql.str().c_str(), &headers, &report, 0, STUB_COL_CNT, vars, 0, NULL );
+
+    if ( !args->ignore_errors_flag )
+    {
+        EIM_check_error( "output_stub_details()\n" );
+    }
+    else if ( ifail != OK )
+    {
+        EIM_clear_error( );
+        EIM_free_result( headers, report );
+        return ifail;
+    }
+
+    for ( EIM_row_p_t row = report; row != NULL; row = row->next )
+    {
+        stub_row_t stub;
+        stub.null_mask = 0;
+
+        for ( int c = 0; c < STUB_COL_CNT; c++ )
+        {
+            if ( c == STUB_COL_CNT - 1 )
+            {
+                int* int_ptr = NULL;
+                EIM_find_value( headers, row->line, stub_col_names[c], EIM_integer, &int_ptr );
+
+                if ( int_ptr != NULL )
+                {
+                    stub.cols[c] = std::to_string( *int_ptr );
+                }
+                else
+                {
+                    stub.null_mask |= ( 1 << c );
+                }
+            }
+            else
+            {
+                char* ptr = NULL;
+                EIM_find_value( headers, row->line, stub_col_names[c], ( c < 2 ? EIM_puid : EIM_varchar ), &ptr );
+
+                if ( ptr != NULL )
+                {
+                    stub.cols[c] = ptr;
+                }
+                else
+                {
+                    stub.null_mask |= ( 1 << c );
+                }
+            }
+        }
+
+        stubs[stub.cols[1]].push_back( stub );
+    }
+
+    EIM_free_result( headers, report );
+    return OK;
+}
+
+/*-----------------------------------------------------------------------*/
+/* Outputs the POM_stub details assocaited with the specfied object uids.*/
+/* The stubs are fetched STUB_PAGE_UIDS uids at a time. With -out= each  */
+/* stub is written as one CSV line, otherwise the verbose layout is used.*/
+static void output_stub_details( std::vector<std::string>* uid_vec, int* found_count )
+{
+    *found_count = -1;
+    int actual_found = 0;
+    logical trans_was_active = true;
+
+    if ( !EIM_is_transaction_active( ) )
+    {
+        trans_was_active = false;
+        EIM_start_transaction( );
+    }
+
+    cons_out( "" );
+
+    if ( args->out_file != NULL && OUT_open( "uid,stub_uid,object_class,object_id,object_name,object_desc,owning_user_id,status_flag" ) != OK )
+    {
+        if ( !trans_was_active )
+        {
+            EIM_commit_transaction( "output_stub_details()" );
+        }
+        return;
+    }
+
+    ERROR_PROTECT
+
+    for ( int first = 0; first < uid_vec->size( ); first += STUB_PAGE_UIDS )
+    {
+        int last = std::min( (int)uid_vec->size( ), first + STUB_PAGE_UIDS );
+        std::vector<std::string> page( uid_vec->begin( ) + first, uid_vec->begin( ) + last );
+        std::map< std::string, std::vector<stub_row_t> > stubs;
+
+        int ifail = fetch_stub_page( page, stubs );
+
+        for ( int i = 0; i < page.size( ); i++ )
+        {
+            std::stringstream msg;
+
+            if ( ifail != OK )
+            {
+                msg << page[i] << ":  Error while quering the database";
+                cons_out( msg.str( ) );
+                continue;
+            }
+
+            std::map< std::string, std::vector<stub_row_t> >::const_iterator it = stubs.find( page[i] );
+
+            if ( it == stubs.end( ) )
+            {
+                if ( args->out_file == NULL )
+                {
+                    msg << page[i] << ":       No stub found\n";
+                    cons_out( msg.str( ) );
+                }
+                continue;
+            }
+
+            if ( args->out_file == NULL )
+            {
+                msg << page[i] << ":\n";
+            }
+
+            for ( int j = 0; j < it->second.size( ); j++, actual_found++ )
+            {
+                const stub_row_t& stub = it->second[j];
+
+                if ( args->out_file != NULL )
+                {
+                    std::vector<std::string> fields( 1, page[i] );
+                    fields.insert( fields.end( ), stub.cols, stub.cols + STUB_COL_CNT );
+                    fields.erase( fields.begin( ) + 2 );   // object uid is the first field
+
+                    std::string line = list_to_csv_string( fields );
+                    line.erase( line.size( ) - 1 );        // trailing comma
+                    OUT_printf( "%s\n", line.c_str( ) );
+                    continue;
+                }
+
+                for ( int c = 0; c < STUB_COL_CNT; c++ )
+                {
+                    if ( c == 0 )
+                    {
+                        msg << "  " << actual_found + 1 << "  ";
+                    }
+                    else
+                    {
+                        msg << "     ";
+                    }
+
+                    msg << stub_col_labels[c] << " = " << ( ( stub.null_mask & ( 1 << c ) ) ? "NULL" : stub.cols[c].c_str( ) ) << "\n";
+                }
+            }
+
+            if ( args->out_file == NULL )
+            {
+                cons_out( msg.str( ) );
+            }
+        }
+    }
+
+    *found_count = actual_found;
+
+    ERROR_RECOVER
+    const std::string msg( "EXCEPTION: See syslog for additional details. (See -i option to ignore this error.)" );
+    cons_out( msg );
+
+    if ( args->out_file != NULL )
+    {
+        OUT_close( );
+    }
+
+    if ( !trans_was_active )
+    {
+        EIM__clear_transaction( ERROR_ask_failure_code( ) );
+        ERROR_raise( ERROR_line, EIM_ask_abort_code( ), "Failed to execute the query\n" );
+    }
+    else
+    {
+        ERROR_reraise( );
+    }
+    ERROR_END
+
+    if ( args->out_file != NULL )
+    {
+        OUT_close( );
+    }
+
+    if ( !trans_was_active )
+    {
+        EIM_commit_transaction( "output_stub_details()" );
+    }
+}
+
+/* ********************************************************************************
+** New utility routines.
+** *******************************************************************************/
+static logical isReferenceable( cls_t* meta )
+{
+    logical ret = true;
+
+    if ( ( meta->properties & OM_class_prop_class_not_referenceable ) == OM_class_prop_class_not_referenceable )
+    {
+        ret = false;
+    }
+    return ret;
+}
+
+static logical isVersionable( cls_t* meta )
+{
+    logical ret = false;
+
+    if ( ( meta->properties & ( OM_class_prop_is_versionable + OM_class_prop_can_have_versionable_subclasses ) ) > 0 )
+    {
+        ret = true;
+    }
+    return ret;
+}
+
+static logical isVersionable( std::vector<cls_t>& meta, const char* class_name )
+{
+    logical ret = false;
+    logical found = false;
+
+    for ( int i = 0; i < meta.size( ); i++ )
+    {
+        if ( strcmp( meta[i].name, class_name ) == 0 )
+        {
+            ret = isVersionable( &meta[i] );
+            found = true;
+            break;
+        }
+    }
+
+    if ( !found )
+    {
+        ERROR_raise( ERROR_line, POM_internal_error, "An invalid class name was specified (%s)", class_name );
+    }
+    return ret;
+}
+
+
+
+static void filterOutFlatClasses( std::vector<cls_t>& meta, std::vector<minny_meta_t>& flat_classes )
+{
+    flat_classes.clear();
+
+    minny_meta_t flat_cls;
+
+    for ( int i = 0; i < meta.size(); i++ )
+    {
+        if ( isFlat( &meta[i] ) )
+        {
+            flat_cls.cls_id = meta[i].cls_id;
+            strncpy (flat_cls.name, meta[i].name, CLS_NAME_SIZE);
+            flat_cls.name[CLS_NAME_SIZE] = '\0';
+            strncpy( flat_cls.db_name, meta[i].db_name, CLS_DB_NAME_SIZE );
+            flat_cls.db_name[CLS_DB_NAME_SIZE] = '\0';
+            flat_cls.cls_pos = i;
+            flat_cls.count = 0;
+            flat_classes.push_back(flat_cls);
+        }  
+    }
+}
+
+static void get_int_from_sql(const char* sql, const char* column_name, int* first_row_value, int* row_count)
+{
+    *first_row_value = -1;
+    *row_count = 0;
+
+    EIM_value_p_t headers = NULL;
+    EIM_row_p_t report = NULL;
+    EIM_row_p_t row;
+    EIM_select_var_t vars[1];
+    EIM_select_col(&(vars[0]), EIM_integer, column_name, sizeof(int), false);
+
+    EIM_exec_sql_bind(sql, &headers, &report, "Getting integer value from SQL", 1, vars, 0, NULL);
+
+    if (report != NULL)
+    {
+        int row_cnt = 0;
+
+        for (row = report; row != NULL; row = row->next)
+        {
+            row_cnt++;
+        }
+
+        *row_count = row_cnt;
+
+        int* value = NULL;
+        EIM_find_value(headers, report->line, column_name, EIM_integer, (void**)& value);
+
+        if (value != NULL)
+        {
+            *first_row_value = *value;
+        }
+    }
+
+    EIM_free_result(headers, report);
+}
+
+static int get_row_count( const char* table_name )
+{
+    char* sql = SM_sprintf( "SELECT COUNT(*) AS CNT FROM %s", table_name );
+
+    int row_cnt = 0;
+    int rows_retieved = 0;
+
+    get_int_from_sql( sql, "CNT", &row_cnt, &rows_retieved );
+    SM_free( sql );
+
+    return row_cnt;
+}
+
+// Execute DML that binds a single UID (:1) once for each of the specified UIDs.
+// The UIDs are bound in batches no larger than the maximum insert size.
+// Returns the number of rows processed.
+static int exec_uid_array_dml( const char* sql, const char* message, EIM_uid_t* uids, int size )
+{
+    int rows_processed = 0;
+
+    if ( size < 1 )
+    {
+        return rows_processed;
+    }
+
+    int batch_size = EIM_get_max_insert_size();
+
+    if ( batch_size < 1 )
+    {
+        batch_size = EIM_ARRAY_MAX_SIZE;
+    }
+
+    EIM_bind_array_value_p_t bvs[1];
+    bvs[0] = static_cast<EIM_bind_array_value_p_t>(SM_alloc(sizeof(EIM_bind_array_value_t)));
+
+    bvs[0]->type = EIM_puid;
+    bvs[0]->len = sizeof(EIM_uid_t);
+    bvs[0]->array_size = 0;
+    bvs[0]->ind = (short *)SM_calloc(batch_size, sizeof(short));
+    bvs[0]->value = NULL;
+
+    for ( int i = 0; i < size; i += batch_size )
+    {
+        int this_batch = ( size - i < batch_size ? size - i : batch_size );
+
+        bvs[0]->array_size = this_batch;
+        bvs[0]->value = uids + i;
+
+        EIM_exec_imm_array_bind( sql, message, this_batch, 1, bvs );
+        EIM_check_error( message );
+
+        int rows = EIM_sqlca_rows_returned();
+
+        if ( rows > 0 )
+        {
+            rows_processed += rows;
+        }
+    }
+
+    SM_free( bvs[0]->ind );
+    SM_free( bvs[0] );
+
+    return rows_processed;
+}
+
+/* ********************************************************************************
+** START OF: UID set routines.
+**
+** Any number of UIDs (-uid= or a -f= file) are staged in a session temporary table
+** so that queries can join against it rather than pasting literal IN lists.
+** The table and its state are declared with the file-scope statics at the top.
+** *******************************************************************************/
+
+// Operations that accept a file of UIDs via -f=.
+// -find_class with -out= reads the file itself, a page at a time (see find_class_bulk).
+static logical is_uid_file_op( Op op )
+{
+    return ( op == scan_vla || op == str_len_val || op == remove_unneeded_bp || op == find_stub || op == where_ref || ( op == find_class && args->out_file == NULL ) );
+}
+
+// Read UIDs from an open UID file, one UID per line, appending them to uid_vec.
+// Blank lines and lines starting with '#' are ignored. Reading stops at the end of
+// the file or once max_uids UIDs have been appended (max_uids < 1 means no limit);
+// line_no carries the position across calls.
+static int read_uid_file( FILE* fp, const char* file_name, int* line_no, int max_uids, std::vector< std::string >* uid_vec )
+{
+    int ifail = OK;
+    int uid_cnt = 0;
+    char line[MAX_INPUT_LENGTH + 1];
+
+    while ( ( max_uids < 1 || uid_cnt < max_uids ) && fnd_fgets( line, MAX_INPUT_LENGTH, fp ) )
+    {
+        line[MAX_INPUT_LENGTH] = '\0';
+        (*line_no)++;
+
+        // Trim leading and trailing white space (including CR/LF).
+        char* start = line;
+
+        while ( *start == ' ' || *start == '\t' )
+        {
+            start++;
+        }
+
+        int len = strlen( start );
+
+        while ( len > 0 && ( start[len - 1] == ' ' || start[len - 1] == '\t' || start[len - 1] == 0x0d || start[len - 1] == 0x0a ) )
+        {
+            start[--len] = '\0';
+        }
+
+        if ( len == 0 || *start == '#' )
+        {
+            continue;
+        }
+
+        if ( len > EIM_uid_length )
+        {
+            std::stringstream msg;
+            msg << "ERROR: Invalid UID (" << start << ") on line " << *line_no << " of " << file_name;
+            cons_out( msg.str() );
+            ifail = POM_invalid_value;
+            break;
+        }
+
+        uid_vec->push_back( start );
+        uid_cnt++;
+    }
+
+    return ifail;
+}
+
+// Read UIDs from a file, one UID per line, appending them to uid_vec.
+static int load_uid_file( const char* file_name, std::vector< std::string >* uid_vec )
+{
+    FILE* fp = fnd_fopen( file_name, "r" );
+
+    if ( 0 == fp )
+    {
+        std::stringstream msg;
+        msg << "ERROR: Unable to open UID file " << file_name;
+        cons_out( msg.str() );
+        return POM_invalid_value;
+    }
+
+    int line_no = 0;
+    size_t first = uid_vec->size();
+    int ifail = read_uid_file( fp, file_name, &line_no, 0, uid_vec );
+
+    fclose( fp );
+
+    if ( ifail == OK )
+    {
+        std::stringstream msg;
+        msg << ( uid_vec->size() - first ) << " UIDs read from " << file_name;
+        cons_out( msg.str() );
+    }
+
+    return ifail;
+}
+
+// Stage the specified UIDs in the UID set temporary table, duplicates are removed.
+// The table is only reloaded when its content differs from the requested UIDs. The
+// content is tracked in uid_set_staged rather than counted; it is only recorded when
+// the load is committed here, since a caller's transaction may still be rolled back.
+// Returns the number of UIDs in the set.
+static int UID_SET_stage( std::vector< std::string >* uids )
+{
+    std::set<std::string> requested;
+
+    if ( uids != NULL )
+    {
+        for ( int i = 0; i < uids->size(); i++ )
+        {
+            if ( (*uids)[i].size() > EIM_uid_length )
+            {
+                ERROR_raise( ERROR_line, POM_invalid_value, "Invalid UID (%s) was specified.", (*uids)[i].c_str() );
+            }
+
+            requested.insert( (*uids)[i] );
+        }
+    }
+
+    logical trans_was_active = true;
+
+    if ( !EIM_is_transaction_active() )
+    {
+        trans_was_active = false;
+        EIM_start_transaction();
+    }
+
+    logical reload = true;
+
+    if ( tbl_uid_set == NULL )
+    {
+        int puid_col_type = POM_string;
+        int puid_col_len = EIM_uid_length;
+
+        int lfail = POM_create_table( POM_TEMPORARY_TABLE, "RM1_", "UID_SET", 1, &uid_set_col_name, &puid_col_type, &puid_col_len, POM_TT_CLEAR_ROWS_EOS, &tbl_uid_set );
+
+        if ( lfail != OK )
+        {
+            tbl_uid_set = NULL;
+            ERROR_raise( ERROR_line, lfail, "Unable to create temporary table for RM1_UID_SET (ifail = %d)", lfail );
+        }
+
+        RUB_create_temporary_table_index( idx_uid_set, tbl_uid_set, uid_set_col_name );
+        uid_set_staged.clear();
+    }
+    else if ( requested == uid_set_staged )
+    {
+        reload = false;
+    }
 
-                ptr = NULL;
-                EIM_find_value( headers, row->line, "pobject_desc", EIM_varchar, &ptr );
+    if ( reload )
+    {
+        POM_clear_table( tbl_uid_set );
+        uid_set_staged.clear();
 
-                if ( ptr == NULL )
-                {
-                    msg << "     object_desc    = NULL\n";
-                }
-                else
-                {
-                    msg << "     object_desc    = " << ptr << "\n";
-                }
+        int size = requested.size();
+        EIM_uid_t* keys = (EIM_uid_t*)SM_alloc( sizeof( EIM_uid_t ) * ( size + 1 ) );
+        int pos = 0;
 
-                ptr = NULL;
-                EIM_find_value( headers, row->line, "powning_user_id", EIM_varchar, &ptr );
+        for ( std::set<std::string>::const_iterator it = requested.begin(); it != requested.end(); ++it, pos++ )
+        {
+            strcpy( keys[pos], it->c_str() );
+        }
 
-                if ( ptr == NULL )
-                {
-                    msg << "     owning_user_id = NULL\n";
-                }
-                else
-                {
-                    msg << "     owning_user_id = " << ptr << "\n";
-                }
+        char* sql = SM_sprintf( "INSERT INTO %s (%s) VALUES (:1)", tbl_uid_set, uid_set_col_name );
+        int inserted = exec_uid_array_dml( sql, "UID_SET_stage(): staging UIDs", keys, size );
+        SM_free( sql );
+        SM_free( keys );
 
-                int* int_ptr = NULL;
-                EIM_find_value( headers, row->line, "pstatus_flag", EIM_integer, &int_ptr );
+        logger()->printf( "UID_SET_stage(): %d UIDs staged in %s\n", inserted, tbl_uid_set );
+    }
 
-                if ( int_ptr == NULL )
-                {
-                    msg << "     status_flag    = NULL\n";
-                }
-                else
-                {
-                    msg << "     status_flag    = " << *int_ptr << "\n";
-                }
+    if ( !trans_was_active )
+    {
+        EIM_commit_transaction( "UID_SET_stage()" );
 
-                row = row->next;
-            }
-            cons_out( msg.str( ) );
-        }
-        else
+        if ( reload )
         {
-            std::stringstream msg;
-            msg << uid_vec->at( i ) << ":       No stub found\n";
-            cons_out( msg.str( ) );
+            uid_set_staged = requested;
         }
+    }
 
-        EIM_free_result( headers, report );
-        report = NULL;
-        headers = NULL;
+    return (int)requested.size();
+}
+
+// Empty the UID set table, remove its index and schedule it to be dropped.
+// Truncation commits any open transaction on Oracle.
+static void UID_SET_release()
+{
+    if ( tbl_uid_set == NULL )
+    {
+        return;
     }
 
-    *found_count = actual_found;
+    char* sql = SM_sprintf( "TRUNCATE TABLE %s%s", tbl_uid_set, ( EIM_dbplat() == EIM_dbplat_oracle ? " DROP STORAGE" : "" ) );
+    RUB_dml_or_ddl( sql );
+    SM_free( sql );
 
-    ERROR_RECOVER
-    const std::string msg( "EXCEPTION: See syslog for additional details. (See -i option to ignore this error.)" );
-    cons_out( msg );
+    RUB_drop_temporary_table_index( idx_uid_set, tbl_uid_set );
 
-    if ( !trans_was_active )
+    POM_add_table_name_to_session_drop_table_list( POM_TEMPORARY_TABLE, tbl_uid_set );
+    tbl_uid_set = NULL;
+    uid_set_staged.clear();
+}
+
+// Create a where clause ( = or IN) for the specified UIDs.
+// Multiple UIDs are staged in the UID set table and the clause selects from it.
+// Return value should be freed by the caller.
+static char* create_uid_specific_where_clause( const char* sql_prefix, std::vector<std::string>* uids )
+{
+    if ( uids == NULL )
     {
-        EIM__clear_transaction( ERROR_ask_failure_code( ) );
-        ERROR_raise( ERROR_line, EIM_ask_abort_code( ), "Failed to execute the query\n" );
+        return NULL;
     }
-    else
+
+    int size = uids->size();
+
+    if ( size < 1 )
     {
-        ERROR_reraise( );
+        return NULL;
     }
-    ERROR_END
 
-    if ( !trans_was_active )
+    std::stringstream where_clause;
+    where_clause << sql_prefix;
+
+    if ( size == 1 )
     {
-        EIM_commit_transaction( "output_stub_details()" );
+        where_clause << " = '" << (*uids)[0] << "'";
     }
+    else
+    {
+        UID_SET_stage( uids );
+        where_clause << " IN (SELECT " << uid_set_col_name << " FROM " << tbl_uid_set << ")";
+    }
+
+    return ( SM_string_copy( where_clause.str().c_str() ) );
 }
+/* ********************************************************************************
+** END OF: UID set routines.
+** *******************************************************************************/
 
 /* ********************************************************************************
-** New utility routines.
+** START OF: Block sampling (-estimate) routines.
 ** *******************************************************************************/
-static logical isReferenceable( cls_t* meta )
+static long long sample_seed = -1;
+
+/*
+** Returns "<table_name> <alias>" decorated with the platform's block sampling clause when -estimate
+** has been specified. The seed is chosen once per process so that every statement that samples a
+** table reads the same blocks, which keeps the anti-joins and diffs consistent with each other.
+** The clause is only valid in the FROM of a top-level SELECT, DML stages the sample with SAMPLE_stage_uids().
+** -sample=100 reads the whole table without a clause, so the sampled counts of a test are exact.
+*/
+static std::string SAMPLE_table_clause( const char* table_name, const char* alias )
 {
-    logical ret = true;
+    std::stringstream clause;
 
-    if ( ( meta->properties & OM_class_prop_class_not_referenceable ) == OM_class_prop_class_not_referenceable )
+    if ( !args->estimate_flag || args->sample_pct >= 100.0 )
     {
-        ret = false;
+        clause << table_name << " " << alias;
+        return clause.str();
     }
-    return ret;
+
+    if ( sample_seed < 0 )
+    {
+        sample_seed = static_cast<long long>( time( NULL ) % 1000000 );
+        logger()->printf( "SAMPLE_table_clause(): sampling %g percent of the table blocks using seed %lld\n", args->sample_pct, sample_seed );
+    }
+
+    switch ( EIM_dbplat() )
+    {
+    case EIM_dbplat_oracle:
+        clause << table_name << " SAMPLE BLOCK (" << args->sample_pct << ") SEED (" << sample_seed << ") " << alias;
+        break;
+
+    case EIM_dbplat_mssql:
+        clause << table_name << " " << alias << " TABLESAMPLE SYSTEM (" << args->sample_pct << " PERCENT) REPEATABLE (" << sample_seed << ")";
+        break;
+
+    case EIM_dbplat_postgres:
+        clause << table_name << " " << alias << " TABLESAMPLE SYSTEM (" << args->sample_pct << ") REPEATABLE (" << sample_seed << ")";
+        break;
+
+    default:
+        ERROR_internal( ERROR_line, "Unrecognized EIM_dbplat value" );
+    }
+
+    return clause.str();
 }
 
-static logical isVersionable( cls_t* meta )
+/*
+** Extrapolates a count found in the sample to the full table.
+** Defects are rare relative to the table size so the sample count is treated as a Poisson count,
+** giving an approximate 95% interval of k +/- 1.96*sqrt(k). When nothing is found the upper
+** bound falls back to the rule of three. Block sampling clusters rows, so treat the bounds as a guide.
+*/
+static void SAMPLE_extrapolate( long long sample_count, long long* estimate, long long* low, long long* high )
 {
-    logical ret = false;
+    double fraction = args->sample_pct / 100.0;
+    double k = static_cast<double>( sample_count );
+    double margin = 1.96 * sqrt( k );
 
-    if ( ( meta->properties & ( OM_class_prop_is_versionable + OM_class_prop_can_have_versionable_subclasses ) ) > 0 )
+    *estimate = llround( k / fraction );
+
+    if ( sample_count < 1 )
     {
-        ret = true;
+        *low = 0;
+        *high = llround( 3.0 / fraction );
+    }
+    else
+    {
+        *low = llround( ( k - margin > 0.0 ? k - margin : 0.0 ) / fraction );
+        *high = llround( ( k + margin ) / fraction );
     }
-    return ret;
 }
 
-static logical isVersionable( std::vector<cls_t>& meta, const char* class_name )
+/*
+** Formats an extrapolated count as "<estimate> (95% bounds: <low> - <high>)".
+*/
+static std::string SAMPLE_format_estimate( long long sample_count )
 {
-    logical ret = false;
-    logical found = false;
+    long long estimate = 0;
+    long long low = 0;
+    long long high = 0;
+    SAMPLE_extrapolate( sample_count, &estimate, &low, &high );
 
-    for ( int i = 0; i < meta.size( ); i++ )
+    std::stringstream msg;
+    msg << estimate << " (95% bounds: " << low << " - " << high << ")";
+    return msg.str();
+}
+
+/*
+** Runs select_sql, a top-level SELECT of column_name over a block sample, and inserts the UIDs it
+** returns into column_name of table_name. The sampling clauses are only accepted by a top-level
+** query, not in the subquery of an INSERT or a MERGE, so the sample is read by the client and
+** staged with array inserts. Returns the number of UIDs staged.
+*/
+static int SAMPLE_stage_uids( const std::string& select_sql, const char* table_name, const char* column_name )
+{
+    EIM_value_p_t headers = NULL;
+    EIM_row_p_t report = NULL;
+    EIM_select_var_t vars[1];
+
+    EIM_select_col( &(vars[0]), EIM_puid, column_name, EIM_uid_length + 1, false );
+
+    EIM_exec_sql_bind( select_sql.c_str(), &headers, &report, 0, 1, vars, 0, NULL );
+    EIM_check_error( "SAMPLE_stage_uids()\n" );
+
+    int size = 0;
+
+    for ( EIM_row_p_t row = report; row != NULL; row = row->next )
     {
-        if ( strcmp( meta[i].name, class_name ) == 0 )
+        size++;
+    }
+
+    EIM_uid_t* keys = (EIM_uid_t*)SM_alloc( sizeof( EIM_uid_t ) * ( size + 1 ) );
+    int pos = 0;
+
+    for ( EIM_row_p_t row = report; row != NULL; row = row->next )
+    {
+        char* tmp_puid = NULL;
+        EIM_find_value( headers, row->line, column_name, EIM_puid, &tmp_puid );
+
+        if ( tmp_puid != NULL )
         {
-            ret = isVersionable( &meta[i] );
-            found = true;
-            break;
+            strcpy( keys[pos++], tmp_puid );
         }
     }
 
-    if ( !found )
+    EIM_free_result( headers, report );
+
+    char* sql = SM_sprintf( "INSERT INTO %s (%s) VALUES (:1)", table_name, column_name );
+    int staged = exec_uid_array_dml( sql, "SAMPLE_stage_uids(): staging sampled UIDs", keys, pos );
+    SM_free( sql );
+    SM_free( keys );
+
+    logger()->printf( "SAMPLE_stage_uids(): %d sampled UIDs staged in %s\n", staged, table_name );
+    return staged;
+}
+
+/*
+** Returns the temporary table of sampled object UIDs (column puid), creating it on first use.
+*/
+static const char* SAMPLE_uid_table()
+{
+    if ( tbl_sample_uids == NULL )
     {
-        ERROR_raise( ERROR_line, POM_internal_error, "An invalid class name was specified (%s)", class_name );
+        const char* col_name = "puid";
+        int puid_col_type = POM_string;
+        int puid_col_len = EIM_uid_length;
+
+        int lfail = POM_create_table( POM_TEMPORARY_TABLE, "RM1_", "SAMPLE_UIDS", 1, &col_name, &puid_col_type, &puid_col_len, POM_TT_CLEAR_ROWS_EOS, &tbl_sample_uids );
+
+        if ( lfail != OK )
+        {
+            tbl_sample_uids = NULL;
+            ERROR_raise( ERROR_line, lfail, "Unable to create temporary table for RM1_SAMPLE_UIDS (ifail = %d)", lfail );
+        }
+
+        RUB_create_temporary_table_index( idx_sample_uids, tbl_sample_uids, col_name );
     }
-    return ret;
+
+    return tbl_sample_uids;
 }
 
+// Remove the index of the sampled UID table and schedule the table to be dropped.
+static void SAMPLE_release()
+{
+    if ( tbl_sample_uids == NULL )
+    {
+        return;
+    }
 
+    RUB_drop_temporary_table_index( idx_sample_uids, tbl_sample_uids );
 
-static void filterOutFlatClasses( std::vector<cls_t>& meta, std::vector<minny_meta_t>& flat_classes )
-{
-    flat_classes.clear();
+    POM_add_table_name_to_session_drop_table_list( POM_TEMPORARY_TABLE, tbl_sample_uids );
+    tbl_sample_uids = NULL;
+}
+/* ********************************************************************************
+** END OF: Block sampling (-estimate) routines.
+** *******************************************************************************/
 
-    minny_meta_t flat_cls;
+/* ********************************************************************************
+** START OF: Streaming export (-out=) routines.
+**
+** -out=<file> writes every matching row of -find_ref and -validate_cids to a CSV
+** file instead of the console. Both number the rows of an attribute into a session
+** temporary table by a single statement and then read them back OUT_PAGE_ROWS at a time.
+** Neither -max nor the size of the result limits what is written.
+** *******************************************************************************/
+/*
+** Opens the -out file, gives it a fixed-size block buffer and writes the CSV header.
+*/
+static int OUT_open( const char* header )
+{
+    out_fp = fnd_fopen( args->out_file, "w" );
 
-    for ( int i = 0; i < meta.size(); i++ )
+    if ( 0 == out_fp )
     {
-        if ( isFlat( &meta[i] ) )
-        {
-            flat_cls.cls_id = meta[i].cls_id;
-            strncpy (flat_cls.name, meta[i].name, CLS_NAME_SIZE);
-            flat_cls.name[CLS_NAME_SIZE] = '\0';
-            strncpy( flat_cls.db_name, meta[i].db_name, CLS_DB_NAME_SIZE );
-            flat_cls.db_name[CLS_DB_NAME_SIZE] = '\0';
-            flat_cls.cls_pos = i;
-            flat_cls.count = 0;
-            flat_classes.push_back(flat_cls);
-        }  
+        std::stringstream msg;
+        msg << "ERROR: Unable to open output file " << args->out_file;
+        cons_out( msg.str() );
+        return POM_invalid_value;
     }
+
+    setvbuf( out_fp, NULL, _IOFBF, OUT_BLOCK_BYTES );
+    fprintf( out_fp, "%s\n", header );
+    out_row_cnt = 0;
+
+    return OK;
 }
 
-static void get_int_from_sql(const char* sql, const char* column_name, int* first_row_value, int* row_count)
+/*
+** Writes one data row to the -out file.
+*/
+static void OUT_printf( const char* format, ... )
 {
-    *first_row_value = -1;
-    *row_count = 0;
+    va_list ap;
+    va_start( ap, format );
+    vfprintf( out_fp, format, ap );
+    va_end( ap );
 
-    EIM_value_p_t headers = NULL;
-    EIM_row_p_t report = NULL;
-    EIM_row_p_t row;
-    EIM_select_var_t vars[1];
-    EIM_select_col(&(vars[0]), EIM_integer, column_name, sizeof(int), false);
+    out_row_cnt++;
+}
 
-    EIM_exec_sql_bind(sql, &headers, &report, "Getting integer value from SQL", 1, vars, 0, NULL);
+/*
+** Flushes the last block, closes the -out file and reports the number of rows written.
+*/
+static int OUT_close()
+{
+    OUT_release_stage();
 
-    if (report != NULL)
+    if ( out_fp == NULL )
     {
-        int row_cnt = 0;
+        return OK;
+    }
 
-        for (row = report; row != NULL; row = row->next)
-        {
-            row_cnt++;
-        }
+    int ifail = ( fclose( out_fp ) == 0 ? OK : POM_invalid_value );
+    out_fp = NULL;
 
-        *row_count = row_cnt;
+    std::stringstream msg;
+    msg << "\n" << out_row_cnt << " rows written to " << args->out_file;
 
-        int* value = NULL;
-        EIM_find_value(headers, report->line, column_name, EIM_integer, (void**)& value);
+    if ( ifail != OK )
+    {
+        msg << " (ERROR: the file could not be closed, its contents are incomplete)";
+    }
+    cons_out( msg.str() );
 
-        if (value != NULL)
+    return ifail;
+}
+
+/*
+** Numbers the rows of select_sql into the staging table and returns the row count.
+** select_sql must return the columns puid, ref_cid, tar_cid, slot and vcx.
+*/
+static int OUT_stage( const std::string& select_sql )
+{
+    if ( tbl_out_rows == NULL )
+    {
+        int num_cols = 6;
+        const char* col_names[] = { "rn", "puid", "ref_cid", "tar_cid", "slot", "vcx" };
+        int col_types[]         = { POM_int, POM_string, POM_int, POM_int, POM_int, POM_int };
+        int col_widths[]        = { sizeof( int ), EIM_uid_length, sizeof( int ), sizeof( int ), sizeof( int ), sizeof( int ) };
+
+        int lfail = POM_create_table( POM_TEMPORARY_TABLE, "RM1_", "OUT_ROWS", num_cols, col_names, col_types, col_widths, POM_TT_CLEAR_ROWS_EOS, &tbl_out_rows );
+
+        if ( lfail != OK )
         {
-            *first_row_value = *value;
+            tbl_out_rows = NULL;
+            ERROR_raise( ERROR_line, lfail, "Unable to create temporary table for RM1_OUT_ROWS (ifail = %d)", lfail );
         }
+
+        RUB_create_temporary_table_index( idx_out_rows, tbl_out_rows, "rn" );
     }
 
-    EIM_free_result(headers, report);
+    std::stringstream sql;
+    sql << "INSERT INTO " << tbl_out_rows << " (rn, puid, ref_cid, tar_cid, slot, vcx) ";
+    sql << "SELECT ROW_NUMBER() OVER (ORDER BY x.puid, x.slot, x.ref_cid), x.puid, x.ref_cid, x.tar_cid, x.slot, x.vcx FROM (" << select_sql << ") x";
+
+    return RUB_dml_or_ddl( sql.str().c_str() );
 }
 
-static int get_row_count( const char* table_name )
+/*
+** Reads the staged rows first_rn+1 .. first_rn+OUT_PAGE_ROWS into page.
+*/
+static void OUT_fetch_page( int first_rn, std::vector< ref_cpid_t >& page )
 {
-    char* sql = SM_sprintf( "SELECT COUNT(*) AS CNT FROM %s", table_name );
+    page.clear();
 
-    int row_cnt = 0;
-    int rows_retieved = 0;
+    int last_rn = first_rn + OUT_PAGE_ROWS;
+    char* sql = SM_sprintf( "SELECT puid, ref_cid, tar_cid, slot, vcx FROM %s WHERE rn > :1 AND rn <= :2 ORDER BY rn", tbl_out_rows );
+
+    EIM_bind_var_t bind_vars[2];
+    EIM_bind_val( &bind_vars[0], EIM_integer, sizeof( int ), &first_rn );
+    EIM_bind_val( &bind_vars[1], EIM_integer, sizeof( int ), &last_rn );
+
+    EIM_select_var_t vars[5];
+    EIM_select_col( &(vars[0]), EIM_varchar, "puid", MAX_UID_SIZE, false );
+    EIM_select_col( &(vars[1]), EIM_integer, "ref_cid", sizeof( int ), false );
+    EIM_select_col( &(vars[2]), EIM_integer, "tar_cid", sizeof( int ), false );
+    EIM_select_col( &(vars[3]), EIM_integer, "slot", sizeof( int ), false );
+    EIM_select_col( &(vars[4]), EIM_integer, "vcx", sizeof( int ), false );
+
+    EIM_value_p_t headers = NULL;
+    EIM_row_p_t report = NULL;
 
-    get_int_from_sql( sql, "CNT", &row_cnt, &rows_retieved );
+    EIM_exec_sql_bind( sql, &headers, &report, 0, 5, vars, 2, bind_vars );
+    EIM_check_error( "OUT_fetch_page()\n" );
     SM_free( sql );
 
-    return row_cnt;
-}
-
-// Create a where clause ( = or IN) for the specified UIDs. 
-// Return value should be freed by the caller. 
-static char* create_uid_specific_where_clause( const char* sql_prefix, std::vector<std::string>* uids )
-{
-    if ( uids == NULL )
+    for ( EIM_row_p_t row = report; row != NULL; row = row->next )
     {
-        return NULL;
-    }
+        ref_cpid_t ref;
+        char* tmp = NULL;
+        int* val = NULL;
 
-    int size = uids->size();
+        EIM_find_value( headers, row->line, "puid", EIM_varchar, &tmp );
+        strncpy( ref.uid, tmp, MAX_UID_SIZE );
+        ref.uid[MAX_UID_SIZE] = '\0';
 
-    if ( size < 1 )
-    {
-        return NULL;
-    }
+        EIM_find_value( headers, row->line, "ref_cid", EIM_integer, &val );
+        ref.ref_cid = *val;
+        EIM_find_value( headers, row->line, "tar_cid", EIM_integer, &val );
+        ref.tar_cid = *val;
+        EIM_find_value( headers, row->line, "slot", EIM_integer, &val );
+        ref.slot = *val;
+        EIM_find_value( headers, row->line, "vcx", EIM_integer, &val );
+        ref.vc_idx = *val;
 
-    if ( size > 100 )
-    {
-        ERROR_raise( ERROR_line, POM_invalid_value, "The maximum number of UIDs that is currently supported is 100. (%d) Please reduce the number of specified UIDs.", size );
+        page.push_back( ref );
     }
 
-    std::stringstream where_clause;
-    where_clause << sql_prefix;
+    EIM_free_result( headers, report );
+}
 
-    if ( size == 1 )
+/*
+** Empties the staging table ready for the next attribute.
+*/
+static void OUT_clear_stage()
+{
+    if ( tbl_out_rows != NULL )
     {
-        where_clause << " = '" << (*uids)[0] << "'";
+        POM_clear_table( tbl_out_rows );
     }
-    else
-    {
-        where_clause << " IN ('" << (*uids)[0] << "' ";
-
-        for ( int i = 1; i < size; i++ )
-        {
-            where_clause << ",'" << (*uids)[i] << "'";
-        }
+}
 
-        where_clause << ")";
+/*
+** Drops the index of the staging table and leaves the table to the session drop list.
+*/
+static void OUT_release_stage()
+{
+    if ( tbl_out_rows == NULL )
+    {
+        return;
     }
 
-    return ( SM_string_copy( where_clause.str().c_str() ) );
+    RUB_drop_temporary_table_index( idx_out_rows, tbl_out_rows );
+
+    POM_add_table_name_to_session_drop_table_list( POM_TEMPORARY_TABLE, tbl_out_rows );
+    tbl_out_rows = NULL;
 }
+/* ********************************************************************************
+** END OF: Streaming export (-out=) routines.
+** *******************************************************************************/
 
 /* ********************************************************************************
 ** START OF: remove_unneeded_bp_op() (RUB) routines. 
@@ -12277,6 +15551,8 @@ static const char* puid_col_name = "puid";
 static const char* from_uid_col_name = "from_uid";
 static const char* to_uid_col_name = "to_uid";
 
+static const int RUB_FLAT_CLASSES_PER_STMT = 100;  // Maximum number of flattened classes combined into one statement.
+
 /* 
 ** Returns the class names of flattened classes that are referenced from backpointers.
 ** A return value of true indicates that there are some references that contain -1 for its class ID, or otherwise it's class is unknown.
@@ -12344,10 +15620,10 @@ static logical RUB_get_flat_classes_with_bps( std::vector<minny_meta_t>& flat_cl
                 {
                     int pos = -1;
 
-                    for ( int j = 0; i < flat_classes_with_bps.size(); i++ )
+                    for ( int j = 0; j < flat_classes_with_bps.size(); j++ )
                     {
                         // Have we seen this class before?
-                        if ( flat_classes_with_bps[i].cls_id == *cls_ptr )
+                        if ( flat_classes_with_bps[j].cls_id == *cls_ptr )
                         {
                             pos = j;
                             break;
@@ -12375,7 +15651,7 @@ static logical RUB_get_flat_classes_with_bps( std::vector<minny_meta_t>& flat_cl
     return unknown_class;
 }
 
-static int RUB_create_temporary_tables( logical to_uid_processing )
+static int RUB_create_temporary_tables( logical from_uid_processing, logical to_uid_processing )
 {
     int ifail = OK;
     int lfail = OK;
@@ -12394,7 +15670,7 @@ static int RUB_create_temporary_tables( logical to_uid_processing )
     tbl_unneeded_from_uid = NULL;
     tbl_unneeded_to_uid = NULL;
 
-    if ( !to_uid_processing )
+    if ( from_uid_processing )
     {
 
         lfail = POM_create_table( POM_TEMPORARY_TABLE, "RM1_", "RUB_UNNEEDED_FROM_UID", 1, &from_uid_col_name, &puid_col_type, &puid_col_len, POM_TT_CLEAR_ROWS_EOS, &tbl_unneeded_from_uid );
@@ -12409,7 +15685,8 @@ static int RUB_create_temporary_tables( logical to_uid_processing )
             }
         }
     }
-    else
+
+    if ( to_uid_processing )
     {
         lfail = POM_create_table( POM_TEMPORARY_TABLE, "RM1_", "RUB_UNNEEDED_TO_UID", 1, &to_uid_col_name, &puid_col_type, &puid_col_len, POM_TT_CLEAR_ROWS_EOS, &tbl_unneeded_to_uid );
 
@@ -12429,22 +15706,23 @@ static int RUB_create_temporary_tables( logical to_uid_processing )
         std::stringstream msg;
         msg << "Unable to create at least one temporary table, see syslog for additional information.\n";
 
-        if ( !to_uid_processing )
+        if ( from_uid_processing )
         {
             if ( tbl_unneeded_from_uid )
             {
-                msg << "  Table name for unneeded from_uids = " << *tbl_unneeded_from_uid << "\n";
+                msg << "  Table name for unneeded from_uids = " << tbl_unneeded_from_uid << "\n";
             }
             else
             {
                 msg << "  Table name for unneeded from_uids = <NULL>\n";
             }
         }
-        else
+
+        if ( to_uid_processing )
         {
             if ( tbl_unneeded_to_uid )
             {
-                msg << "  Table name for unneeded to_uids = " << *tbl_unneeded_to_uid;
+                msg << "  Table name for unneeded to_uids = " << tbl_unneeded_to_uid;
             }
             else
             {
@@ -12680,27 +15958,46 @@ static void RUB_drop_temp_tables()
      }
  }
 
-static void RUB_log_bkptrs_to_remove( int* count )
+/*
+** Creates the POM_BACKPOINTER where clause that selects the backpointers of the unneeded 
+** from_uids and/or to_uids, depending on which temporary tables are in use.
+** Return value should be freed by the caller.
+*/
+static char* RUB_create_unneeded_bkptr_where_clause()
 {
-    *count = -1;
+    std::stringstream where_clause;
 
-    if( args->min_flag)
+    if ( tbl_unneeded_from_uid != NULL )
     {
-        return;          // We want to log minimum amount of data.
+        where_clause << "from_uid IN (SELECT from_uid FROM " << tbl_unneeded_from_uid << ")";
     }
 
-    char* sql = NULL;
-
-    if ( !args->alt )
+    if ( tbl_unneeded_to_uid != NULL )
     {
-        sql = SM_sprintf( "SELECT from_uid, from_class, to_uid, to_class, bp_count FROM POM_BACKPOINTER WHERE from_uid in (SELECT from_uid FROM %s)", tbl_unneeded_from_uid );
+        if ( tbl_unneeded_from_uid != NULL )
+        {
+            where_clause << " OR ";
+        }
 
+        where_clause << "to_uid IN (SELECT to_uid FROM " << tbl_unneeded_to_uid << ")";
     }
-    else
+
+    return ( SM_string_copy( where_clause.str().c_str() ) );
+}
+
+static void RUB_log_bkptrs_to_remove( int* count )
+{
+    *count = -1;
+
+    if( args->min_flag)
     {
-        sql = SM_sprintf( "SELECT from_uid, from_class, to_uid, to_class, bp_count FROM POM_BACKPOINTER WHERE to_uid IN (SELECT to_uid FROM %s)", tbl_unneeded_to_uid );
+        return;          // We want to log minimum amount of data.
     }
 
+    char* where = RUB_create_unneeded_bkptr_where_clause();
+    char* sql = SM_sprintf( "SELECT from_uid, from_class, to_uid, to_class, bp_count FROM POM_BACKPOINTER WHERE %s", where );
+    SM_free( where );
+
     EIM_value_p_t headers = NULL;
     EIM_row_p_t report = NULL;
     EIM_row_p_t row;
@@ -12815,35 +16112,380 @@ static void RUB_log_bkptrs_to_remove( int* count )
 }
 
 /*
-** Remove any unneeded backpointers from the backpointer table. 
-** -remove_unneeded_bp 
+** Reads up to max_keys UIDs from the specified column of a temporary table.
+** Returns the number of UIDs copied into the keys array.
 */
-static int remove_unneeded_bp_op( int* found_count )
+static int RUB_select_chunk_keys( const char* temp_table, const char* column_name, int max_keys, EIM_uid_t* keys )
+{
+    char* sql = NULL;
+
+    switch ( EIM_dbplat() )
+    {
+    case EIM_dbplat_oracle:
+        sql = SM_sprintf( "SELECT %s FROM %s WHERE ROWNUM <= %d", column_name, temp_table, max_keys );
+        break;
+
+    case EIM_dbplat_mssql:
+        sql = SM_sprintf( "SELECT TOP %d %s FROM %s", max_keys, column_name, temp_table );
+        break;
+
+    case EIM_dbplat_postgres:
+        sql = SM_sprintf( "SELECT %s FROM %s FETCH FIRST %d ROWS ONLY", column_name, temp_table, max_keys );
+        break;
+
+    default:
+        ERROR_raise( ERROR_line, POM_internal_error, "Unsupported database platform" );
+        break;
+    }
+
+    EIM_value_p_t headers = NULL;
+    EIM_row_p_t report = NULL;
+    EIM_row_p_t row;
+    EIM_select_var_t vars[1];
+    EIM_select_col( &( vars[0] ), EIM_puid, column_name, EIM_uid_length + 1, false );
+
+    EIM_exec_sql_bind( sql, &headers, &report, "RUB_select_chunk_keys() - Unable to read unneeded UIDs", 1, vars, 0, NULL );
+    EIM_check_error( "RUB_select_chunk_keys()" );
+
+    int key_cnt = 0;
+
+    for ( row = report; row != NULL && key_cnt < max_keys; row = row->next )
+    {
+        char* char_ptr = NULL;
+        EIM_find_value( headers, row->line, column_name, EIM_puid, &char_ptr );
+
+        if ( char_ptr != NULL )
+        {
+            strncpy( keys[key_cnt], char_ptr, EIM_uid_length );
+            keys[key_cnt][EIM_uid_length] = '\0';
+            key_cnt++;
+        }
+    }
+
+    SM_free( sql );
+    EIM_free_result( headers, report );
+
+    return key_cnt;
+}
+
+/*
+** Deletes the backpointers of the unneeded UIDs held in the temporary table, args->chunk_size UIDs 
+** per working transaction. The UIDs of a chunk are removed from the temporary table in the same 
+** transaction as their backpointers, so the temporary table always holds the remaining work.
+** With -rps= the deletion rate is limited to the specified number of backpointers per second.
+*/
+static int RUB_delete_bkptrs_in_chunks( const char* temp_table, const char* column_name, int* delete_count )
 {
-    *found_count = -1;
     int ifail = OK;
+    *delete_count = 0;
+
+    int remaining = get_row_count( temp_table );
+    int chunk_cnt = 0;
 
-    if ( args->uid_flag )
     {
-        std::vector<std::string>* uid_vec_lcl = args->uid_vec;
-        int uid_cnt = ( *uid_vec_lcl ).size();
+        std::stringstream msg;
+        msg << "Deleting the backpointers of " << remaining << " unneeded " << column_name << "s, " << args->chunk_size << " UIDs per transaction";
 
-        if ( uid_cnt > 100 )
+        if ( args->max_rows_per_sec > 0 )
         {
-            ifail = POM_invalid_value;
+            msg << ", at most " << args->max_rows_per_sec << " backpointers per second";
+        }
+        cons_out( msg.str() );
+    }
+
+    EIM_uid_t* keys = static_cast<EIM_uid_t*>( SM_alloc( sizeof( EIM_uid_t ) * ( args->chunk_size + 1 ) ) );
+    char* bp_sql = SM_sprintf( "DELETE FROM POM_BACKPOINTER WHERE %s = :1", column_name );
+    char* tt_sql = SM_sprintf( "DELETE FROM %s WHERE %s = :1", temp_table, column_name );
+
+    EIM_commit_transaction( "" );
+
+    while ( remaining > 0 && ifail == OK )
+    {
+        std::chrono::steady_clock::time_point chunk_start = std::chrono::steady_clock::now();
+        int key_cnt = 0;
+        int chunk_deleted = 0;
+
+        START_WORKING_TX( rub_chunk_tx, "rub_chunk_tx" );
+
+        ERROR_PROTECT
+
+        key_cnt = RUB_select_chunk_keys( temp_table, column_name, args->chunk_size, keys );
+        chunk_deleted = exec_uid_array_dml( bp_sql, "RUB_delete_bkptrs_in_chunks() - deleting backpointers", keys, key_cnt );
+        exec_uid_array_dml( tt_sql, "RUB_delete_bkptrs_in_chunks() - removing processed UIDs", keys, key_cnt );
+
+        ERROR_RECOVER
+
+        if ( ifail == OK )
+        {
+            ifail = ERROR_ask_failure_code();
+
+            if ( !ifail )
+            {
+                ifail = POM_internal_error;
+            }
+        }
+        ERROR_END
+
+        if ( ifail )
+        {
+            ROLLBACK_WORKING_TX( rub_chunk_tx, "rub_chunk_tx" );
             std::stringstream msg;
-            msg << "\nError " << ifail << " A maximum of 100 UIDs can be specified.";
+            msg << "Deletion of chunk " << ( chunk_cnt + 1 ) << " has been rolled back. (ifail=" << ifail << ") See syslog for details.";
+            msg << "\n" << *delete_count << " unneeded backpointers were deleted by previously committed chunks, " << remaining << " unneeded UIDs remain.";
             cons_out( msg.str() );
+            break;
+        }
+
+        COMMIT_WORKING_TX( rub_chunk_tx, "rub_chunk_tx" );
+
+        chunk_cnt++;
+        *delete_count += chunk_deleted;
+        remaining = ( key_cnt > 0 ? remaining - key_cnt : 0 );
+
+        if ( remaining < 0 )
+        {
+            remaining = 0;
+        }
+
+        std::stringstream msg;
+        msg << "Chunk " << chunk_cnt << " committed: " << chunk_deleted << " backpointers deleted (" << *delete_count << " total), " << remaining << " unneeded UIDs remaining";
+        cons_out( msg.str() );
+
+        if ( args->max_rows_per_sec > 0 && chunk_deleted > 0 && remaining > 0 )
+        {
+            std::chrono::milliseconds target( ( static_cast<long long>( chunk_deleted ) * 1000 ) / args->max_rows_per_sec );
+            std::chrono::milliseconds elapsed = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - chunk_start );
+
+            if ( elapsed < target )
+            {
+                std::this_thread::sleep_for( target - elapsed );
+            }
         }
     }
 
-    if ( ifail != OK )
+    EIM_start_transaction();
+
+    SM_free( bp_sql );
+    SM_free( tt_sql );
+    SM_free( keys );
+
+    return ifail;
+}
+
+/*
+** Deletes the UIDs found in any of the specified flattened class selects from a temporary table.
+** The selects are combined with UNION ALL, at most RUB_FLAT_CLASSES_PER_STMT classes per statement.
+** Returns the number of UIDs removed from the temporary table.
+*/
+static int RUB_delete_flat_class_uids_combined( const char* temp_table, const char* column_name, std::vector<std::string>& selects, int* stmt_count )
+{
+    int removed = 0;
+
+    for ( int i = 0; i < selects.size(); i += RUB_FLAT_CLASSES_PER_STMT )
     {
-        return ifail;
+        std::stringstream sql;
+        sql << "DELETE FROM " << temp_table << " WHERE " << column_name << " IN (";
+
+        for ( int j = i; j < selects.size() && j < i + RUB_FLAT_CLASSES_PER_STMT; j++ )
+        {
+            if ( j > i )
+            {
+                sql << " UNION ALL ";
+            }
+
+            sql << selects[j];
+        }
+
+        sql << ")";
+
+        removed += RUB_dml_or_ddl( sql.str().c_str() );
+        ( *stmt_count )++;
+    }
+
+    return removed;
+}
+
+/*
+** Removes the UIDs of objects stored in flattened classes from the unneeded UID temporary tables.
+** Each flattened class is visited once, serving both the from_uid and to_uid tables when both are in use.
+** A table is checked against every flattened class (forced path) when -force is specified or when some of
+** its backpointers have an unknown class, otherwise only against the classes found in its backpointers.
+** By default the flattened classes are combined into UNION ALL statements, -seq issues one statement
+** per flattened class. The elapsed time of either approach is logged so that they can be compared.
+*/
+static void RUB_eliminate_flat_class_uids( std::vector<cls_t>& meta, std::vector<minny_meta_t>& flat_classes, int* from_uid_count, int* to_uid_count )
+{
+    std::vector<minny_meta_t> flat_classes_with_from_bps;
+    std::vector<minny_meta_t> flat_classes_with_to_bps;
+    logical from_forced = false;
+    logical to_forced = false;
+    logical from_active = false;
+    logical to_active = false;
+
+    // Identify all the classes found in the POM_BACKPOINTER.from_class.
+    if ( tbl_unneeded_from_uid != NULL )
+    {
+        logical unknown_class = RUB_get_flat_classes_with_bps( flat_classes, tbl_unneeded_from_uid, from_uid_col_name, flat_classes_with_from_bps );
+        from_forced = ( args->force_flag || unknown_class );
+        from_active = ( from_forced || *from_uid_count > 0 );
+        logger()->printf( "remove_unneeded_bp_op(): Processing %d from_uids via %s processing path.\n", *from_uid_count, ( from_forced ? "forced" : "optimized" ) );
+    }
+
+    // Identify all the classes found in the POM_BACKPOINTER.to_class.
+    if ( tbl_unneeded_to_uid != NULL )
+    {
+        logical unknown_class = RUB_get_flat_classes_with_bps( flat_classes, tbl_unneeded_to_uid, to_uid_col_name, flat_classes_with_to_bps );
+        to_forced = ( args->force_flag || unknown_class );
+        to_active = ( to_forced || *to_uid_count > 0 );
+        logger()->printf( "remove_unneeded_bp_op(): Processing %d to_uids via %s processing path.\n", *to_uid_count, ( to_forced ? "forced" : "optimized" ) );
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    int stmt_count = 0;
+    int removed_count = 0;
+    std::vector<std::string> from_selects;
+    std::vector<std::string> to_selects;
+
+    for ( int i = 0; i < flat_classes.size() && ( from_active || to_active ); i++ )
+    {
+        logical from_scan = from_active && from_forced;
+        logical to_scan = to_active && to_forced;
+
+        for ( int j = 0; !from_scan && from_active && j < flat_classes_with_from_bps.size(); j++ )
+        {
+            from_scan = ( flat_classes_with_from_bps[j].cls_id == flat_classes[i].cls_id );
+        }
+
+        for ( int j = 0; !to_scan && to_active && j < flat_classes_with_to_bps.size(); j++ )
+        {
+            to_scan = ( flat_classes_with_to_bps[j].cls_id == flat_classes[i].cls_id && isReferenceable( &meta[flat_classes[i].cls_pos] ) );
+        }
+
+        if ( from_scan )
+        {
+            std::string select = std::string( "SELECT puid FROM " ) + flat_classes[i].db_name;
+
+            if ( !args->seq_flag )
+            {
+                from_selects.push_back( select );
+            }
+            else
+            {
+                int removed = RUB_dml_or_ddl( ( std::string( "DELETE FROM " ) + tbl_unneeded_from_uid + " WHERE from_uid IN (" + select + ")" ).c_str() );
+                *from_uid_count -= removed;
+                removed_count += removed;
+                stmt_count++;
+
+                if ( !from_forced && *from_uid_count < 1 )
+                {
+                    *from_uid_count = get_row_count( tbl_unneeded_from_uid );
+
+                    if ( *from_uid_count < 1 )
+                    {
+                        logger()->printf( "remove_unneeded_bp_op(): the number of from_uid target puids has gone to zero. NOT looking for additional puids in any additional flattened classes.\n" );
+                        from_active = false;
+                    }
+                }
+            }
+        }
+
+        if ( to_scan )
+        {
+            logical isVer = isVersionable( &meta[flat_classes[i].cls_pos] );
+            std::string select = std::string( "SELECT " ) + ( isVer ? aoid_col_name : puid_col_name ) + " FROM " + flat_classes[i].db_name;
+
+            if ( !args->seq_flag )
+            {
+                to_selects.push_back( select );
+            }
+            else
+            {
+                int removed = RUB_dml_or_ddl( ( std::string( "DELETE FROM " ) + tbl_unneeded_to_uid + " WHERE to_uid IN (" + select + ")" ).c_str() );
+                *to_uid_count -= removed;
+                removed_count += removed;
+                stmt_count++;
+
+                if ( !to_forced && *to_uid_count < 1 )
+                {
+                    *to_uid_count = get_row_count( tbl_unneeded_to_uid );
+
+                    if ( *to_uid_count < 1 )
+                    {
+                        logger()->printf( "remove_unneeded_bp_op(): the number of to_uid target puids has gone to zero. NOT looking for additional puids in any additional flattened classes.\n" );
+                        to_active = false;
+                    }
+                }
+            }
+        }
+    }
+
+    if ( from_selects.size() > 0 )
+    {
+        int removed = RUB_delete_flat_class_uids_combined( tbl_unneeded_from_uid, from_uid_col_name, from_selects, &stmt_count );
+        *from_uid_count -= removed;
+        removed_count += removed;
+    }
+
+    if ( to_selects.size() > 0 )
+    {
+        int removed = RUB_delete_flat_class_uids_combined( tbl_unneeded_to_uid, to_uid_col_name, to_selects, &stmt_count );
+        *to_uid_count -= removed;
+        removed_count += removed;
     }
 
-    // Initialize temporary tables.
-    ifail = RUB_create_temporary_tables(args->alt);
+    long long elapsed = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - start ).count();
+    logger()->printf( "remove_unneeded_bp_op(): %s flattened class elimination removed %d uids with %d statements in %lld ms.\n",
+                      ( args->seq_flag ? "Per-class" : "Combined" ), removed_count, stmt_count, elapsed );
+}
+
+/*
+** -estimate: Counts the sampled backpointers whose from_uid or to_uid survived the same elimination steps
+** as a full run, then extrapolates that count to the whole of POM_BACKPOINTER.
+** The sampling seed is fixed for the process so these queries read the same blocks as the candidate INSERTs.
+*/
+static void RUB_report_estimate( int* found_count )
+{
+    std::string sampled_tbl = SAMPLE_table_clause( "POM_BACKPOINTER", "a" );
+    int rows = 0;
+    int sampled_cnt = 0;
+    int unneeded_cnt = 0;
+
+    char* sql = SM_sprintf( "SELECT COUNT(*) AS CNT FROM %s", sampled_tbl.c_str() );
+    get_int_from_sql( sql, "CNT", &sampled_cnt, &rows );
+    SM_free( sql );
+
+    char* where = RUB_create_unneeded_bkptr_where_clause();
+    sql = SM_sprintf( "SELECT COUNT(*) AS CNT FROM %s WHERE %s", sampled_tbl.c_str(), where );
+    get_int_from_sql( sql, "CNT", &unneeded_cnt, &rows );
+    SM_free( sql );
+    SM_free( where );
+
+    *found_count = unneeded_cnt;
+
+    long long table_estimate = 0;
+    long long low = 0;
+    long long high = 0;
+    SAMPLE_extrapolate( sampled_cnt, &table_estimate, &low, &high );
+
+    std::stringstream msg;
+    msg << "Sampled " << sampled_cnt << " backpointers (" << args->sample_pct << "% of the blocks), " << unneeded_cnt << " of them are unneeded.";
+    msg << "\nEstimated backpointers:          " << table_estimate;
+    msg << "\nEstimated unneeded backpointers: " << SAMPLE_format_estimate( unneeded_cnt );
+    msg << "\nRun without -estimate to identify the unneeded backpointers.";
+    cons_out( msg.str() );
+}
+
+/*
+** Remove any unneeded backpointers from the backpointer table. 
+** -remove_unneeded_bp 
+*/
+static int remove_unneeded_bp_op( int* found_count )
+{
+    *found_count = -1;
+    int ifail = OK;
+
+    // Initialize temporary tables. -both processes the from_uids and the to_uids in the same run.
+    ifail = RUB_create_temporary_tables( ( !args->alt || args->both_flag ), ( args->alt || args->both_flag ) );
 
     if ( ifail != OK )
     {
@@ -12882,67 +16524,47 @@ static int remove_unneeded_bp_op( int* found_count )
 
     //
     // Identify uids from POM_BACKPOINTER.from_uid that don't exist.  If an object does not exist then the backpointer is not needed.
+    // -estimate samples POM_BACKPOINTER in a top-level SELECT and stages its result, the later steps read the staged uids.
     //
-    if ( !args->alt )
+    if ( tbl_unneeded_from_uid != NULL )
     {
         char* where = create_uid_specific_where_clause( " AND a.from_uid", args->uid_vec );
-        char* sql = SM_sprintf( "INSERT INTO %s (from_uid) (SELECT DISTINCT from_uid FROM POM_BACKPOINTER a LEFT JOIN PPOM_OBJECT b ON a.from_uid = b.puid WHERE b.puid is NULL%s)", tbl_unneeded_from_uid, ( where ? where : "" ) );
-        from_uid_count = RUB_dml_or_ddl( sql );
-        SM_free( sql );
-        SM_free( where );
+        char* sql = SM_sprintf( "SELECT DISTINCT from_uid FROM %s LEFT JOIN PPOM_OBJECT b ON a.from_uid = b.puid WHERE b.puid is NULL%s",
+            SAMPLE_table_clause( "POM_BACKPOINTER", "a" ).c_str(), ( where ? where : "" ) );
 
-        // Identify all the classes found in the POM_BACKPOINTER.from_class.
-        std::vector<minny_meta_t> flat_classes_with_from_bps;
-        logical unknown_class = RUB_get_flat_classes_with_bps( flat_classes, tbl_unneeded_from_uid, from_uid_col_name, flat_classes_with_from_bps );
-
-        if ( !args->force_flag && !unknown_class )
+        if ( args->estimate_flag )
         {
-            logger()->printf( "remove_unneeded_bp_op(): Processing %d from_uids via optimized processing path.\n", from_uid_count );
-
-            if ( from_uid_count > 0 )
-            {
-                for ( int i = 0; i < flat_classes_with_from_bps.size(); i++ )
-                {
-                    char* sql = SM_sprintf( "DELETE FROM %s WHERE from_uid IN (SELECT puid FROM %s)", tbl_unneeded_from_uid, flat_classes_with_from_bps[i].db_name );
-                    from_uid_count -= RUB_dml_or_ddl( sql );
-                    SM_free( sql );
-
-                    if ( from_uid_count < 1 )
-                    {
-                        from_uid_count = get_row_count( tbl_unneeded_from_uid );
-
-                        if ( from_uid_count < 1 )
-                        {
-                            logger()->printf( "remove_unneeded_bp_op(): the number of from_uid target puids has gone to zero. NOT looking for additional puids in any additional flattened classes.\n" );
-                            break;
-                        }
-                    }
-                }
-            }
+            from_uid_count = SAMPLE_stage_uids( sql, tbl_unneeded_from_uid, "from_uid" );
         }
         else
         {
-            logger()->printf( "remove_unneeded_bp_op(): Processing %d from_uids via forced processing path.\n", from_uid_count );
-            
-            for ( int i = 0; i < flat_classes.size(); i++ )
-            {
-                char* sql = SM_sprintf( "DELETE FROM %s WHERE from_uid IN (SELECT puid FROM %s)", tbl_unneeded_from_uid, flat_classes[i].db_name );
-                from_uid_count -= RUB_dml_or_ddl( sql );
-                SM_free( sql );
-            }
+            char* ins = SM_sprintf( "INSERT INTO %s (from_uid) (%s)", tbl_unneeded_from_uid, sql );
+            from_uid_count = RUB_dml_or_ddl( ins );
+            SM_free( ins );
         }
+        SM_free( sql );
+        SM_free( where );
     }
 
-
     //
     // Identify uids from POM_BACKPOINTER.to_uid that don't exist.  If an object does not exist, and is not stubbed, then the backpointer is not needed.
     //
-    if ( args->alt )
+    if ( tbl_unneeded_to_uid != NULL )
     {
         char* where = create_uid_specific_where_clause( " AND a.to_uid", args->uid_vec );
-        char* sql = SM_sprintf( "INSERT INTO %s (to_uid) (SELECT DISTINCT to_uid FROM POM_BACKPOINTER a LEFT JOIN PPOM_OBJECT b ON a.to_uid = b.%s WHERE b.%s is NULL%s)",
-            tbl_unneeded_to_uid, ( isPoVer ? aoid_col_name : puid_col_name ), ( isPoVer ? aoid_col_name : puid_col_name ), ( where ? where : "" ) );
-        to_uid_count = RUB_dml_or_ddl( sql );
+        char* sql = SM_sprintf( "SELECT DISTINCT to_uid FROM %s LEFT JOIN PPOM_OBJECT b ON a.to_uid = b.%s WHERE b.%s is NULL%s",
+            SAMPLE_table_clause( "POM_BACKPOINTER", "a" ).c_str(), ( isPoVer ? aoid_col_name : puid_col_name ), ( isPoVer ? aoid_col_name : puid_col_name ), ( where ? where : "" ) );
+
+        if ( args->estimate_flag )
+        {
+            to_uid_count = SAMPLE_stage_uids( sql, tbl_unneeded_to_uid, "to_uid" );
+        }
+        else
+        {
+            char* ins = SM_sprintf( "INSERT INTO %s (to_uid) (%s)", tbl_unneeded_to_uid, sql );
+            to_uid_count = RUB_dml_or_ddl( ins );
+            SM_free( ins );
+        }
         SM_free( sql );
         SM_free( where );
 
@@ -12950,54 +16572,11 @@ static int remove_unneeded_bp_op( int* found_count )
         delta_stub_count = RUB_dml_or_ddl( sql );
         to_uid_count -= delta_stub_count;
         SM_free( sql );
-
-        // Identify all the classes found in the POM_BACKPOINTER.to_class.
-        std::vector<minny_meta_t> flat_classes_with_to_bps;
-        logical unknown_class = RUB_get_flat_classes_with_bps( flat_classes, tbl_unneeded_to_uid, to_uid_col_name, flat_classes_with_to_bps );
-
-        if ( !args->force_flag && !unknown_class )
-        {
-            logger()->printf( "remove_unneeded_bp_op(): Processing %d to_uids via optimized processing path.\n", to_uid_count );
-                                
-            if ( to_uid_count > 0 )
-            {
-                for ( int i = 0; i < flat_classes_with_to_bps.size(); i++ )
-                {
-                    if ( isReferenceable( &meta[flat_classes_with_to_bps[i].cls_pos] ) )
-                    {
-                        logical isVer = isVersionable( &meta[flat_classes_with_to_bps[i].cls_pos] );
-                        char* sql = SM_sprintf( "DELETE FROM %s WHERE to_uid IN (SELECT %s FROM %s)", tbl_unneeded_to_uid, ( isVer ? aoid_col_name : puid_col_name ), flat_classes_with_to_bps[i].db_name );
-                        to_uid_count -= RUB_dml_or_ddl( sql );
-                        SM_free( sql );
-
-                        if ( to_uid_count < 1 )
-                        {
-                            to_uid_count = get_row_count( tbl_unneeded_to_uid );
-
-                            if ( to_uid_count < 1 )
-                            {
-                                logger()->printf( "remove_unneeded_bp_op(): the number of to_uid target puids has gone to zero. NOT looking for additional puids in any additional flattened classes.\n" );
-                                break;
-                            }
-                        }
-                    }
-                }
-            }
-        }
-        else
-        {
-            logger()->printf( "remove_unneeded_bp_op(): Processing %d to_uids via forced processing path.\n", to_uid_count );
-
-            for ( int i = 0; i < flat_classes.size(); i++ )
-            {
-                logical isVer = isVersionable( &meta[flat_classes[i].cls_pos] );
-                char* sql = SM_sprintf( "DELETE FROM %s WHERE to_uid IN (SELECT puid FROM %s)", tbl_unneeded_to_uid, ( isVer ? aoid_col_name : puid_col_name ), flat_classes[i].db_name );
-                RUB_dml_or_ddl( sql );
-                SM_free( sql );
-            }
-        }
     }
 
+    // Remove the uids of objects that are stored in flattened classes.
+    RUB_eliminate_flat_class_uids( meta, flat_classes, &from_uid_count, &to_uid_count );
+
     cons_out( "" ); 
 
     // Log internal optimization counts
@@ -13006,7 +16585,11 @@ static int remove_unneeded_bp_op( int* found_count )
     logger()->printf( "delta_stub_count = %d\n", delta_stub_count );
     
     int bkptr_removal_cnt = -1;
-    RUB_log_bkptrs_to_remove( &bkptr_removal_cnt );
+
+    if ( !args->estimate_flag )
+    {
+        RUB_log_bkptrs_to_remove( &bkptr_removal_cnt );
+    }
 
     if ( bkptr_removal_cnt < 0 )  // If not logging backpointers to be deleted for performance reasons then just use the found UID counts.
     {
@@ -13025,7 +16608,12 @@ static int remove_unneeded_bp_op( int* found_count )
     
     *found_count = bkptr_removal_cnt;
 
-    if ( !args->commit_flag )
+    if ( args->estimate_flag )
+    {
+        // Only the sample was examined, so nothing is deleted even when -commit is specified.
+        RUB_report_estimate( found_count );
+    }
+    else if ( !args->commit_flag )
     {   
         std::stringstream msg;
 
@@ -13039,26 +16627,43 @@ static int remove_unneeded_bp_op( int* found_count )
     }
     else
     {
-        if ( bkptr_removal_cnt > 0 )
+        if ( bkptr_removal_cnt > 0 && args->chunk_size > 0 )
         {
-            int delete_count = -1;
-            EIM_commit_transaction( "" );
-            START_WORKING_TX( remove_unneeded_bp_tx, "remove_unneeded_bp_tx" );
-
-            ERROR_PROTECT
+            int delete_count = 0;
+            int table_delete_count = 0;
 
-            char* sql = NULL;
+            if ( tbl_unneeded_from_uid != NULL )
+            {
+                ifail = RUB_delete_bkptrs_in_chunks( tbl_unneeded_from_uid, from_uid_col_name, &table_delete_count );
+                delete_count += table_delete_count;
+            }
 
-            if ( !args->alt )
+            if ( tbl_unneeded_to_uid != NULL && ifail == OK )
             {
-                sql = SM_sprintf( "DELETE FROM POM_BACKPOINTER WHERE from_uid IN (SELECT from_uid FROM %s)", tbl_unneeded_from_uid ); 
+                ifail = RUB_delete_bkptrs_in_chunks( tbl_unneeded_to_uid, to_uid_col_name, &table_delete_count );
+                delete_count += table_delete_count;
             }
-            else
+
+            if ( ifail == OK )
             {
-                sql = SM_sprintf( "DELETE FROM POM_BACKPOINTER WHERE to_uid IN (SELECT to_uid FROM %s)", tbl_unneeded_to_uid ); 
+                std::stringstream msg;
+                msg << "Deletion of " << delete_count << " unneeded backpointers has been successfully committed.";
+                cons_out( msg.str() );
             }
+        }
+        else if ( bkptr_removal_cnt > 0 )
+        {
+            int delete_count = -1;
+            EIM_commit_transaction( "" );
+            START_WORKING_TX( remove_unneeded_bp_tx, "remove_unneeded_bp_tx" );
+
+            ERROR_PROTECT
+
+            char* where = RUB_create_unneeded_bkptr_where_clause();
+            char* sql = SM_sprintf( "DELETE FROM POM_BACKPOINTER WHERE %s", where ); 
             delete_count = RUB_dml_or_ddl( sql );
             SM_free( sql );
+            SM_free( where );
 
             ERROR_RECOVER
 
@@ -13117,16 +16722,20 @@ static int remove_unneeded_bp_op( int* found_count )
 ** END OF: remove_unneeded_bp_op() routines. 
 ** *******************************************************************************/
 
-#define MAX_DATA_LINE_LEN 2050
 /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 /* unlock_and_unload                                             */
-static int unlock_and_unload( tag_t obj_tag )
+static int unlock_and_unload( int n_tags, tag_t* obj_tags )
 {
-    int ifail = POM_refresh_instances( 1, &obj_tag, NULLTAG, POM_no_lock );
+    if ( n_tags < 1 )
+    {
+        return POM_ok;
+    }
+
+    int ifail = POM_refresh_instances( n_tags, obj_tags, NULLTAG, POM_no_lock );
 
     if ( !ifail )
     {
-        ifail = POM_unload_instances( 1, &obj_tag );
+        ifail = POM_unload_instances( n_tags, obj_tags );
     }
 
     return ifail;
@@ -13187,361 +16796,551 @@ static std::string list_to_csv_string( std::vector<std::string> list )
     return sb.str( );
 }
 
-/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
-/* Find CSV parameter starting location                          */
-static char* find_csv_field( char* start )
+/*
+** A field of a CSV line, pointing into the mapping of the file. Quoted fields exclude
+** their quotes, doubled quotes ("") are only collapsed when the field is copied.
+*/
+typedef struct EV_csv_field_s
 {
-    char* ret = NULL;
-    char* cp = start;
+    const char*  ptr;                    // First character of the field
+    size_t       len;                    // Number of characters in the field
+    logical      escaped;                // Field contains doubled quotes
+} EV_csv_field_t;
+
+/*
+** Read-only, memory mapped CSV file. There is no limit on the length of a line.
+*/
+typedef struct EV_csv_reader_s
+{
+    const char*  data;                   // Start of the mapping, NULL for an empty file
+    size_t       len;                    // Length of the file
+    size_t       pos;                    // Offset of the next line
+    const char*  line;                   // Last line read, without its line terminator
+    size_t       line_len;
+    const char*  bad;                    // Data after a closing quote of the last line, NULL when well formed
+    size_t       bad_len;
+#if defined( WNT )
+    HANDLE       map;
+#endif
+} EV_csv_reader_t;
 
-    if ( cp == NULL )
+#define EV_WINDOW_LINES 100000           // CSV data lines grouped and applied at a time
+
+static void EV_csv_close( EV_csv_reader_t* rdr )
+{
+#if defined( WNT )
+    if ( rdr->data != NULL )
     {
-        return(ret);
+        UnmapViewOfFile( rdr->data );
     }
 
-    // skip leading whitespace.
-    while ( isspace( *cp ) )
+    if ( rdr->map != NULL )
     {
-        cp++;
+        CloseHandle( rdr->map );
     }
 
-    if ( *cp != ',' || *cp != '\0' )
+    rdr->map = NULL;
+#else
+    if ( rdr->data != NULL )
     {
-        ret = cp;
+        munmap( (void*)rdr->data, rdr->len );
     }
-
-    return(ret);
+#endif
+    rdr->data = NULL;
+    rdr->len = 0;
+    rdr->pos = 0;
 }
 
-/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
-/* Move past the current CSV field to the begining of the next CSV field.*/
-static char* move_past_csv_field( char* cp )
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+/* Map a CSV file for reading, skipping any UTF-8 byte order mark */
+/* The file is opened with fnd_fopen() like the other input files */
+/* and closed once mapped, the mapping keeps the file open.       */
+static int EV_csv_open( const char* file_name, EV_csv_reader_t* rdr )
 {
-    while ( isspace( *cp ) )
+    memset( rdr, 0, sizeof( *rdr ) );
+
+    FILE* fp = fnd_fopen( file_name, "rb" );
+
+    if ( fp == NULL )
+    {
+        return POM_invalid_value;
+    }
+
+#if defined( WNT )
+    HANDLE file = (HANDLE)_get_osfhandle( _fileno( fp ) );
+    LARGE_INTEGER size;
+
+    if ( file == INVALID_HANDLE_VALUE || !GetFileSizeEx( file, &size ) )
+    {
+        fclose( fp );
+        return POM_invalid_value;
+    }
+
+    rdr->len = (size_t)size.QuadPart;
+
+    if ( rdr->len > 0 )
     {
-        cp++;
+        rdr->map = CreateFileMappingA( file, NULL, PAGE_READONLY, 0, 0, NULL );
+
+        if ( rdr->map != NULL )
+        {
+            rdr->data = (const char*)MapViewOfFile( rdr->map, FILE_MAP_READ, 0, 0, 0 );
+        }
+
+        if ( rdr->data == NULL )
+        {
+            EV_csv_close( rdr );
+            fclose( fp );
+            return POM_invalid_value;
+        }
     }
+#else
+    struct stat st;
 
-    if ( *cp == '\0' )
+    if ( fstat( fileno( fp ), &st ) != 0 )
     {
-        return cp;
+        fclose( fp );
+        return POM_invalid_value;
     }
 
-    if ( *cp == ',' )
+    rdr->len = (size_t)st.st_size;
+
+    if ( rdr->len > 0 )
     {
-        cp++;
-        return cp;
+        void* addr = mmap( NULL, rdr->len, PROT_READ, MAP_PRIVATE, fileno( fp ), 0 );
+
+        if ( addr == MAP_FAILED )
+        {
+            fclose( fp );
+            rdr->len = 0;
+            return POM_invalid_value;
+        }
+
+        madvise( addr, rdr->len, MADV_SEQUENTIAL );
+        rdr->data = (const char*)addr;
     }
+#endif
+
+    fclose( fp );
 
-    ERROR_raise( ERROR_line, POM_invalid_value, "Invalid data after the end of the CSV and before the next field (%s)", cp );
+    if ( rdr->len >= 3 && memcmp( rdr->data, "\xEF\xBB\xBF", 3 ) == 0 )
+    {
+        rdr->pos = 3;
+    }
 
-    return cp;
+    return POM_ok;
 }
 
-static int find_csv_field_length( char* start )
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+/* Tokenize the next line of the file in place. Returns false at the end */
+/* of the file, an empty line returns true with no fields. Data after a  */
+/* closing quote stops the line and is left in rdr->bad for the caller.  */
+static logical EV_csv_next_line( EV_csv_reader_t* rdr, std::vector<EV_csv_field_t>& fields )
 {
-    int len = 0;
-    char* cp = start;
-    logical in_quote = false;
+    fields.clear( );
+    rdr->bad = NULL;
+    rdr->bad_len = 0;
 
-    if ( !start )
+    if ( rdr->pos >= rdr->len )
     {
-        return len;
+        return false;
     }
 
-    if ( *cp == '"' )
+    const char* line = rdr->data + rdr->pos;
+    const char* end = (const char*)memchr( line, '\n', rdr->len - rdr->pos );
+
+    if ( end == NULL )
+    {
+        end = rdr->data + rdr->len;
+        rdr->pos = rdr->len;
+    }
+    else
     {
-        in_quote = true;
-        cp++;
-        len++;
+        rdr->pos = (size_t)( end - rdr->data ) + 1;
     }
 
-    if ( in_quote )
+    while ( end > line && end[-1] == '\r' )
+    {
+        end--;
+    }
+
+    rdr->line = line;
+    rdr->line_len = (size_t)( end - line );
+
+    const char* cp = line;
+
+    while ( cp < end )
     {
-        // Quote mode - terminate on single quote.
-        while ( *cp != '\0' )
+        EV_csv_field_t field = { cp, 0, false };
+
+        // skip leading whitespace.
+        while ( cp < end && isspace( (unsigned char)*cp ) )
         {
-            if ( *cp == '"' )
-            {
-                len++;
-                cp++;
+            cp++;
+        }
+
+        if ( cp >= end )
+        {
+            break;
+        }
+
+        if ( *cp == '"' )
+        {
+            // Quote mode - terminate on single quote.
+            cp++;
+            field.ptr = cp;
 
-                if ( *cp != '\0' )
+            while ( cp < end )
+            {
+                if ( *cp == '"' )
                 {
-                    if ( *cp != '"' )
+                    if ( cp + 1 < end && cp[1] == '"' )
                     {
-                        // Terminate on single quote.
-                        break;
+                        field.escaped = true;
+                        cp += 2;
+                        continue;
                     }
-
-                    len++;
-                    cp++;
+                    break;
                 }
+                cp++;
             }
-            else
+
+            field.len = (size_t)( cp - field.ptr );
+
+            if ( cp < end )
             {
-                if ( *cp != '\0' )
-                {
-                    len++;
-                    cp++;
-                }
+                cp++;
             }
-        }
-    }
-    else
-    {
-        // Normal mode - terminate on comma (,).
-        while ( *cp != '\0' && *cp != ',' )
-        {
-            if ( *cp != '\0' )
+
+            while ( cp < end && isspace( (unsigned char)*cp ) )
             {
-                len++;
                 cp++;
             }
+
+            if ( cp < end && *cp != ',' )
+            {
+                rdr->bad = cp;
+                rdr->bad_len = (size_t)( end - cp );
+                fields.push_back( field );
+                return true;
+            }
+        }
+        else
+        {
+            // Normal mode - terminate on comma (,).
+            field.ptr = cp;
+            const char* comma = (const char*)memchr( cp, ',', (size_t)( end - cp ) );
+            cp = ( comma != NULL ? comma : end );
+            field.len = (size_t)( cp - field.ptr );
+        }
+
+        fields.push_back( field );
+
+        // Move past the comma to the next field.
+        if ( cp < end )
+        {
+            cp++;
         }
     }
-    return len;
+
+    return true;
 }
 
-static std::string extract_csv_data( char* start )
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+/* Copy a CSV field, converting doubled quotes to single quotes. */
+static std::string EV_csv_field_str( const EV_csv_field_t& field )
 {
-    std::string ret = "";
-
-    if ( !start )
+    if ( !field.escaped )
     {
-        return ret;
+        return std::string( field.ptr, field.len );
     }
 
-    char dst[MAX_DATA_LINE_LEN + 1];
-    char* buf = dst;
-    *buf = '\0';
-    char* cp = start;
-    logical in_quote = false;
+    std::string ret;
+    ret.reserve( field.len );
 
-    if ( *cp == '"' )
+    for ( size_t i = 0; i < field.len; i++ )
     {
-        in_quote = true;
-        cp++;
+        ret.push_back( field.ptr[i] );
+
+        if ( field.ptr[i] == '"' )
+        {
+            i++;
+        }
     }
 
-    if ( in_quote )
+    return ret;
+}
+
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+/* Copy a CSV field into SM memory for a POM call, converting    */
+/* doubled quotes to single quotes. The caller frees it.         */
+static char* EV_csv_field_sm( const EV_csv_field_t& field )
+{
+    char* ret = (char*)SM_alloc( field.len + 1 );
+    size_t n = 0;
+
+    for ( size_t i = 0; i < field.len; i++ )
     {
-        // Quote mode - terminate on single quote.
-        while ( *cp != '\0' )
+        ret[n++] = field.ptr[i];
+
+        if ( field.escaped && field.ptr[i] == '"' )
         {
-            if ( *cp == '"' )
-            {
-                cp++;
+            i++;
+        }
+    }
 
-                if ( *cp != '\0' )
-                {
-                    if ( *cp != '"' )
-                    {
-                        // Terminate on single quote.
-                        break;
-                    }
+    ret[n] = '\0';
+    return ret;
+}
 
-                    // Convert double quote into a single quote.
-                    *buf++ = *cp++;
-                    *buf = '\0';
-                }
-            }
-            else
-            {
-                if ( *cp != '\0' )
-                {
-                    *buf++ = *cp++;
-                    *buf = '\0';
-                }
-            }
-        }
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+/* Copy every field of a line, used for the header line.         */
+static void EV_csv_copy_fields( const std::vector<EV_csv_field_t>& fields, std::vector<std::string>& field_data )
+{
+    field_data.clear( );
+    field_data.reserve( fields.size( ) );
+
+    for ( const EV_csv_field_t& field : fields )
+    {
+        field_data.push_back( EV_csv_field_str( field ) );
     }
-    else
+}
+
+/*
+** CSV data line of a window, its fields stay in the mapping of the file.
+*/
+typedef struct EV_csv_line_s
+{
+    const char*  text;                   // The line as read, for the console and the reject file
+    size_t       len;
+    int          first;                  // Index of its first field in the window, -1 for a malformed line
+} EV_csv_line_t;
+
+/*
+** Window of CSV data lines. Nothing is copied out of the mapping until
+** edit_vlas() passes a value to POM, so the window costs two vectors.
+*/
+typedef struct EV_csv_window_s
+{
+    std::vector<EV_csv_line_t>   lines;
+    std::vector<EV_csv_field_t>  fields; // One per header column for each well formed line
+} EV_csv_window_t;
+
+static void EV_window_clear( EV_csv_window_t& window )
+{
+    window.lines.clear( );
+    window.fields.clear( );
+}
+
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+/* Add the line just read to the window, without its fields when */
+/* fields is NULL (a malformed line).                            */
+static void EV_window_add( EV_csv_window_t& window, EV_csv_reader_t* rdr, const std::vector<EV_csv_field_t>* fields )
+{
+    EV_csv_line_t line = { rdr->line, rdr->line_len, -1 };
+
+    if ( fields != NULL )
+    {
+        line.first = (int)window.fields.size( );
+        window.fields.insert( window.fields.end( ), fields->begin( ), fields->end( ) );
+    }
+
+    window.lines.push_back( line );
+}
+
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+/* Directory for scratch files: TC_TMP_DIR, else TEMP or TMPDIR. */
+static std::string EV_tmp_dir( )
+{
+    const char* names[3] = { "TC_TMP_DIR", "TEMP", "TMPDIR" };
+
+    for ( int i = 0; i < 3; i++ )
     {
-        // Normal mode - terminate on comma (,).
-        while ( *cp != '\0' && *cp != ',' )
+        std::string dir = Teamcenter::OSEnvironment::get( names[i] );
+
+        if ( !dir.empty( ) )
         {
-            if ( *cp != '\0' )
-            {
-                *buf++ = *cp++;
-                *buf = '\0';
-            }
+            return dir;
         }
     }
 
-    ret = dst;
-    return ret;
+#if defined( WNT )
+    return ".";
+#else
+    return "/tmp";
+#endif
 }
 
-static void read_next_csv_line( FILE* fp, std::vector<std::string> &field_data )
+/*
+** Micro-benchmark of the -edit_array CSV reader (-bench=csv), no database connection
+** is required. Writes a 10M line (about 800MB) CSV file to the temporary directory,
+** then times tokenizing it in place and tokenizing it into windows, as edit_array_op()
+** does. The file is removed afterwards.
+*/
+static int EV_bench_csv( )
 {
-    char line[MAX_DATA_LINE_LEN + 1];
-    field_data.clear( );
+    std::string  path = EV_tmp_dir( ) + "/ref_mgr_bench_csv.csv";
+    const char*  file_name = path.c_str( );
+    const int    lines = 10000000;
+    int          ret = OK;
+
+    FILE* fp = fnd_fopen( file_name, "w" );
 
-    if ( fnd_fgets( line, MAX_DATA_LINE_LEN, fp ) )
+    if ( fp == NULL )
     {
-        line[MAX_DATA_LINE_LEN] = '\0';
+        cons_out_no_log( "ERROR: Unable to create the benchmark CSV file " + path );
+        return FAIL;
+    }
 
-        int siz = strlen( line );
+    fprintf( fp, "action,class,uid,pos,int_vla,str_vla\n" );
 
-        for ( int i = siz - 1; i >= 0; i-- )
-        {
-            int ch = (int)line[i];
+    for ( int i = 0; i < lines; i++ )
+    {
+        fprintf( fp, "update,RF_MGR_BENCH,AAAAAAAAAAAAA%07d,%d,%d,\"value \"\"%d\"\", with comma\"\n", i % 1000000, i % 16, i, i );
+    }
 
-            if ( ch != !0x0d && ch != 0x0a )
-            {
-                break;
-            }
+    fclose( fp );
 
-            line[i] = '\0';
-        }
+    EV_csv_reader_t rdr;
+
+    if ( EV_csv_open( file_name, &rdr ) != POM_ok )
+    {
+        cons_out_no_log( "ERROR: Unable to map the benchmark CSV file" );
+        remove( file_name );
+        return FAIL;
+    }
 
-        // Look for beginning of first field.
-        char* cp = find_csv_field( &(line[0]) );
+    std::vector<EV_csv_field_t> fields;
+    EV_csv_window_t window;
+    size_t file_len = rdr.len;
+    long   counts[2] = { 0, 0 };
+    double secs[2] = { 0.0, 0.0 };
+
+    for ( int k = 0; k < 2; k++ )
+    {
+        rdr.pos = 0;
 
-        if ( cp != NULL && *cp != '\0' )
+        auto t0 = std::chrono::steady_clock::now();
+        while ( EV_csv_next_line( &rdr, fields ) )
         {
-            // Extract data from this field then move to next field.
-            while ( cp != NULL && *cp != '\0' )
+            if ( k == 1 )
             {
-                int len = find_csv_field_length( cp );
-                field_data.push_back( extract_csv_data( cp ));
+                if ( (int)window.lines.size( ) == EV_WINDOW_LINES )
+                {
+                    EV_window_clear( window );
+                }
 
-                // Find begining of next field.
-                cp += len;
-                cp = move_past_csv_field( cp );
-                cp = find_csv_field( cp );
+                EV_window_add( window, &rdr, &fields );
             }
+            counts[k] += (long)fields.size( );
         }
+        auto t1 = std::chrono::steady_clock::now();
+
+        secs[k] = std::chrono::duration< double >( t1 - t0 ).count();
+    }
+
+    EV_csv_close( &rdr );
+    remove( file_name );
+
+    double mb = (double)file_len / ( 1024.0 * 1024.0 );
+    const char* names[2] = { "tokenize", "tokenize+window" };
+
+    std::stringstream msg;
+    msg << "csv: lines=" << ( lines + 1 ) << " bytes=" << file_len << " fields=" << counts[0];
+
+    for ( int k = 0; k < 2; k++ )
+    {
+        double s = ( secs[k] > 0.0 ? secs[k] : 1e-9 );
+        msg << "\n   " << names[k] << " " << (long)( mb / s ) << " MB/s " << (long)( ( lines + 1 ) / s ) << " lines/s";
+    }
+
+    if ( counts[0] != counts[1] || counts[0] != (long)( lines + 1 ) * 6 )
+    {
+        msg << "\n   ERROR: field counts (" << counts[0] << ", " << counts[1] << ") do not match the " << ( (long)( lines + 1 ) * 6 ) << " fields written";
+        ret = FAIL;
     }
+
+    cons_out_no_log( msg.str() );
+    return ret;
 }
 
 
-static bool EV_output_fail( int line_no, std::vector<std::string>& vla_mods, std::string error_message )
+static bool EV_output_fail( int line_no, const EV_csv_line_t& line, std::string error_message )
 {
     std::stringstream sb;
     sb << "line " << line_no << " - ERROR: ";
-    sb << list_to_csv_string( vla_mods );
-    sb << "ERROR: " << error_message;
+    sb.write( line.text, line.len );
+    sb << ",ERROR: " << error_message;
     cons_out( sb.str( ) );
     return false;
 }
 
-static void EV_output_success( int line_no, std::vector<std::string>& vla_mods)
+static void EV_output_success( int line_no, const EV_csv_line_t& line )
 {
     std::stringstream sb;
     sb << "line " << line_no << " - SUCCESS: ";
-    sb << list_to_csv_string( vla_mods );
-    sb << "SUCCESS";
+    sb.write( line.text, line.len );
+    sb << ",SUCCESS";
     cons_out( sb.str( ) );
 }
 
-static bool edit_vlas( int line_no, std::vector<std::string>& header, std::vector<std::string>& vla_mods )
-{
-    bool success = false;
-    int ifail = POM_ok;
-
-    // Step 1. 
-    // Validate the action
-    // Convert UID to object tag 
-    // Cache cpid of object tag
-    // Load and lock object tag.
-
-    std::string  act = vla_mods[0];      // edit array action.
-    std::string  cls = vla_mods[1];      // class of object to edit
-    std::string  att = "";               // VLA attribute.
-    std::string  uid = vla_mods[2];      // UID of object to edit
-    std::string  pos = vla_mods[3];      // position of vlas to edit.
-    int vla_pos      = -1;               // Numeric position within VLA.
+// "uid:class" of referenced objects whose cpids have already been cached during this run.
+static std::set<std::string> EV_cached_refs;
 
-    tag_t        obj_tag = NULLTAG;      // Object being modified
-    tag_t        cls_tag = NULLTAG;      // Class of object being modified
-    tag_t        att_tag = NULLTAG;      // Attribute being modified.
-    unsigned int cache_cnt = 0;
+/*
+** Class of -edit_array lines and the attributes of its header columns, described once per run.
+*/
+typedef struct EV_class_desc_s
+{
+    tag_t               cls_tag;
+    std::vector<tag_t>  att_tags;        // Indexed by header column, the first four columns are not attributes
+    std::vector<int>    att_types;
+    std::string         error;           // Why the class or one of its header columns cannot be edited
+} EV_class_desc_t;
 
-    if ( act.compare( "insert" ) != 0 && act.compare( "delete" ) != 0 && act.compare( "append" ) != 0 && act.compare( "update" ) != 0 )
-    {
-        if ( ifail != OK || cache_cnt < 1 )
-        {
-            std::stringstream msg;
-            msg << "An invalid action (" << act << ") was specified. Action needs to be insert, delete, append or update";
-            EV_output_fail( line_no, vla_mods, msg.str( ) );
-            return success;
-        }
-    }
+static std::map<std::string, EV_class_desc_t> EV_class_descs;
 
-    vla_pos = std::stoi( pos );
+/*------------------------------------------------------------------------
+** Returns the description of cls and the header columns, resolving it on
+** first use. A class that cannot be edited is reported once, here, and its
+** error is then given for each of its lines.
+** ----------------------------------------------------------------------- */
+static const EV_class_desc_t& EV_describe_class( const std::string& cls, std::vector<std::string>& header )
+{
+    auto it = EV_class_descs.find( cls );
 
-    if ( vla_pos < 0 )
+    if ( it != EV_class_descs.end( ) )
     {
-        std::stringstream msg;
-        msg << "An invalid VLA position (" << vla_pos << ") was specified.";
-        EV_output_fail( line_no, vla_mods, msg.str( ) );
-        return success;
+        return it->second;
     }
 
-    ifail = POM_string_to_tag( uid.c_str( ), &obj_tag );
+    EV_class_desc_t& desc = EV_class_descs[cls];
+    int n_atts = (int)header.size( ) - 4;
+    std::stringstream msg;
 
-    if ( ifail != OK )
-    {
-        std::stringstream msg;
-        msg << "Unable to convert the uid (" << uid << ") into a tag. Error = " << ifail << ".";
-        EV_output_fail( line_no, vla_mods, msg.str( ) );
-        return success;
-    }
+    desc.cls_tag = NULLTAG;
+    desc.att_tags.assign( header.size( ), NULLTAG );
+    desc.att_types.assign( header.size( ), 0 );
 
-    ifail = POM_class_id_of_class ( cls.c_str( ), &cls_tag );
+    int ifail = POM_class_id_of_class( cls.c_str( ), &desc.cls_tag );
 
     if ( ifail != OK )
     {
-        std::stringstream msg;
         msg << "Unable to identify class " << cls << ". Error = " << ifail << ".";
-        EV_output_fail( line_no, vla_mods, msg.str( ) );
-        return success;
-    }
-
-    ifail = DMS_cache_cpids_of_class( 1, &obj_tag, cls.c_str( ), NULL, &cache_cnt );
-
-    if ( ifail != OK || cache_cnt < 1 )
-    {
-        std::stringstream msg;
-        msg << "Unable to cache cpid of " << uid << ". I.e. UID was not found in class " << cls << ". Error = " << ifail << ". cache_cnt = " << cache_cnt << ".";
-        EV_output_fail( line_no, vla_mods, msg.str( ) );
-        return success;
-    }
-
-    ifail = POM_load_instances( 1, &obj_tag, NULLTAG, POM_modify_lock );
-
-    if ( ifail != OK )
-    {
-        std::stringstream msg;
-        msg << "Unable to load and lock " << uid << ". Error = " << ifail << ".";
-        EV_output_fail( line_no, vla_mods, msg.str( ) );
-        return success;
     }
 
-    // Step 2. 
-    // Make the VLA edit. 
-    success = true;
-
-    for ( int i = 4; i < header.size( ); i++ )
+    for ( int i = 4; i < (int)header.size( ) && ifail == OK; i++ )
     {
-        //
-        // Identify and prepare target VLA attribute 
-        //
-        att = header[i];
-
-        ifail = POM_attr_id_of_attr ( att.c_str( ), cls.c_str( ), &att_tag );
+        ifail = POM_attr_id_of_attr( header[i].c_str( ), cls.c_str( ), &desc.att_tags[i] );
 
         if ( ifail != OK )
         {
-            unlock_and_unload( obj_tag );
-            std::stringstream msg;
-            msg << "Unable to identify attribute " << att << " in class " << cls << ". Error = " << ifail << ".";
-            EV_output_fail( line_no, vla_mods, msg.str( ) );
-            return false;
+            msg << "Unable to identify attribute " << header[i] << " in class " << cls << ". Error = " << ifail << ".";
         }
+    }
 
+    if ( ifail == OK )
+    {
         char** att_names = NULL;
         int* types = NULL;
         int* str_lens = NULL;
@@ -13550,10 +17349,30 @@ static bool edit_vlas( int line_no, std::vector<std::string>& header, std::vecto
         int* descs = NULL;
         int* fails = NULL;
 
-        ifail = POM_describe_attrs( cls_tag, 1, &att_tag, &att_names, &types, &str_lens, &ref_class, &lengths, &descs, &fails );
+        ifail = POM_describe_attrs( desc.cls_tag, n_atts, &desc.att_tags[4], &att_names, &types, &str_lens, &ref_class, &lengths, &descs, &fails );
+
+        for ( int j = 0; j < n_atts && msg.str( ).empty( ); j++ )
+        {
+            const std::string& att = header[j + 4];
+            int att_fail = ( ifail != OK ? ifail : ( fails ? fails[j] : OK ) );
+            int att_type = ( types ? types[j] : 0 );
+            int att_length = ( lengths ? lengths[j] : 0 );
+
+            if ( att_fail != OK )
+            {
+                msg << "Unable to describe attribute " << att << " from class " << cls << ". Error = " << att_fail << ".";
+            }
+            else if ( att_length != -1 )
+            {
+                msg << "Attribute " << att << " from class " << cls << " is NOT a VLA (length = " << att_length << ").";
+            }
+            else if ( att_type != POM_int && att_type != POM_string && att_type != POM_typed_reference && att_type != POM_untyped_reference )
+            {
+                msg << "Attribute " << att << " from class " << cls << " is NOT a POM_int, POM_string, POM_typed_reference or POM_untyped_reference (type = " << att_type << ").";
+            }
 
-        int att_type = (types ? *types : 0);
-        int att_length = (lengths ? *lengths : 0);
+            desc.att_types[j + 4] = att_type;
+        }
 
         SM_free( (void*)att_names );
         SM_free( (void*)types );
@@ -13562,33 +17381,68 @@ static bool edit_vlas( int line_no, std::vector<std::string>& header, std::vecto
         SM_free( (void*)lengths );
         SM_free( (void*)descs );
         SM_free( (void*)fails );
+    }
 
-        if ( ifail != OK )
-        {
-            unlock_and_unload( obj_tag );
-            std::stringstream msg;
-            msg << "Unable to describe attribute " << att << " from class " << cls << ". Error = " << ifail << ".";
-            EV_output_fail( line_no, vla_mods, msg.str( ) );
-            return false;
-        }
+    desc.error = msg.str( );
 
-        if ( att_length != -1 )
-        {
-            unlock_and_unload( obj_tag );
-            std::stringstream msg;
-            msg << "Attribute " << att << " from class " << cls << " is NOT a VLA (length = " << att_length << ").";
-            EV_output_fail( line_no, vla_mods, msg.str( ) );
-            return false;
-        }
+    if ( !desc.error.empty( ) )
+    {
+        cons_out( "ERROR: " + desc.error );
+    }
 
-        if ( att_type != POM_int && att_type != POM_string && att_type != POM_typed_reference && att_type != POM_untyped_reference )
-        {
-            unlock_and_unload( obj_tag );
-            std::stringstream msg;
-            msg << "Attribute " << att << " from class " << cls << " is NOT a POM_int, POM_string, POM_typed_reference or POM_untyped_reference (type = " << att_type << ").";
-            EV_output_fail( line_no, vla_mods, msg.str( ) );
-            return false;
-        }
+    return desc;
+}
+
+static bool edit_vlas( int line_no, std::vector<std::string>& header, const EV_csv_line_t& line, const EV_csv_field_t* vla_mods, tag_t obj_tag, const EV_class_desc_t& desc )
+{
+    bool success = false;
+    int ifail = POM_ok;
+
+    // Step 1. 
+    // Validate the action and position.
+    // The object has already been loaded and locked by EV_edit_class()
+    // and the attributes have been described by EV_describe_class().
+
+    std::string  act = EV_csv_field_str( vla_mods[0] );      // edit array action.
+    std::string  cls = EV_csv_field_str( vla_mods[1] );      // class of object to edit
+    std::string  att = "";                                   // VLA attribute.
+    std::string  uid = EV_csv_field_str( vla_mods[2] );      // UID of object to edit
+    std::string  pos = EV_csv_field_str( vla_mods[3] );      // position of vlas to edit.
+    int vla_pos      = -1;               // Numeric position within VLA.
+
+    tag_t        att_tag = NULLTAG;      // Attribute being modified.
+
+    if ( act.compare( "insert" ) != 0 && act.compare( "delete" ) != 0 && act.compare( "append" ) != 0 && act.compare( "update" ) != 0 )
+    {
+        std::stringstream msg;
+        msg << "An invalid action (" << act << ") was specified. Action needs to be insert, delete, append or update";
+        EV_output_fail( line_no, line, msg.str( ) );
+        return success;
+    }
+
+    vla_pos = std::stoi( pos );
+
+    if ( vla_pos < 0 )
+    {
+        std::stringstream msg;
+        msg << "An invalid VLA position (" << vla_pos << ") was specified.";
+        EV_output_fail( line_no, line, msg.str( ) );
+        return success;
+    }
+
+    // Step 2. 
+    // Make the VLA edit. 
+    success = true;
+
+    for ( int i = 4; i < header.size( ); i++ )
+    {
+        //
+        // Target VLA attribute 
+        //
+        att = header[i];
+
+        att_tag = desc.att_tags[i];
+        int att_type = desc.att_types[i];
 
         // 
         // Prepare target data.
@@ -13603,14 +17457,14 @@ static bool edit_vlas( int line_no, std::vector<std::string>& header, std::vecto
             switch ( att_type )
             {
             case POM_string:
-                new_string = SM_string_copy( vla_mods[i].c_str( ) );
+                new_string = EV_csv_field_sm( vla_mods[i] );
                 break;
             case POM_int:
-                new_int = std::stoi( vla_mods[i] );
+                new_int = std::stoi( EV_csv_field_str( vla_mods[i] ) );
                 break;
             case POM_typed_reference:
             case POM_untyped_reference:
-                new_string = SM_string_copy( vla_mods[i].c_str( ) );
+                new_string = EV_csv_field_sm( vla_mods[i] );
                 char* ptr = strchr( new_string, ':' );
 
                 // Null terminate UID before class
@@ -13626,14 +17480,16 @@ static bool edit_vlas( int line_no, std::vector<std::string>& header, std::vecto
                 {
                     std::stringstream msg;
                     msg << "Unable to convert the target uid (" << new_string << ") into a tag. Error = " << ifail << ".";
-                    EV_output_fail( line_no, vla_mods, msg.str( ) );
+                    EV_output_fail( line_no, line, msg.str( ) );
                     prep_fail = true;
                     success = false;
                 }
                 else
                 {
                     unsigned int cnt = 0;
-                    if ( !ptr || strcmp( ptr, "skip_cache" ) != 0 )
+                    std::string ref_key = std::string( new_string ) + ":" + ( ptr ? ptr : "POM_object" );
+
+                    if ( ( !ptr || strcmp( ptr, "skip_cache" ) != 0 ) && EV_cached_refs.find( ref_key ) == EV_cached_refs.end( ) )
                     {
                         // Cache CPID of referenced object.
                         if ( ptr == NULL )
@@ -13651,10 +17507,14 @@ static bool edit_vlas( int line_no, std::vector<std::string>& header, std::vecto
                         {
                             std::stringstream msg;
                             msg << "Unable to cache cpid of the new reference " << new_string << ". Error = " << ifail << ". cache_cnt = " << cnt << ".";
-                            EV_output_fail( line_no, vla_mods, msg.str( ) );
+                            EV_output_fail( line_no, line, msg.str( ) );
                             prep_fail = true;
                             success = false;
                         }
+                        else
+                        {
+                            EV_cached_refs.insert( ref_key );
+                        }
                     }
                 }
                 break;
@@ -13719,44 +17579,468 @@ static bool edit_vlas( int line_no, std::vector<std::string>& header, std::vecto
                 }
             }
 
-            if ( ifail )
+            if ( ifail )
+            {
+                std::stringstream msg;
+                msg << "Unable to " << act << " VLA record (pos = " << vla_pos << ") from " << cls << ":" << att << ":" << uid << ".  Error = " << ifail << ".";
+                EV_output_fail( line_no, line, msg.str( ) );
+                success = false;
+            }
+        }
+
+        SM_free( (void*)new_string );
+    }
+
+    return success;
+}
+
+/*
+** CSV data lines of one object, in file order.
+*/
+typedef struct EV_object_s
+{
+    std::string       uid;
+    tag_t             obj_tag;
+    std::vector<int>  lines;             // Indexes into the CSV data lines
+} EV_object_t;
+
+#define EV_LOAD_BATCH_SIZE 1000          // Objects cached, loaded and saved per call
+
+/*------------------------------------------------------------------------
+** Applies the edits to the objects of one class. The cpids of each batch of
+** objects are cached and the batch is loaded and locked with one call each. All
+** edits to an object are applied in memory before the object is saved, so an
+** object touched by many lines is loaded and saved once. When a bulk call fails
+** the batch is retried one object at a time so the failing lines can be reported.
+** ----------------------------------------------------------------------- */
+static bool EV_edit_class( const std::string& cls, std::vector<EV_object_t>& objs, std::vector<std::string>& header, EV_csv_window_t& window, int line_base, int* line_no, std::vector<int>& rejects )
+{
+    bool success = true;
+    int ifail = POM_ok;
+    const EV_class_desc_t& desc = EV_describe_class( cls, header );
+
+    if ( !desc.error.empty( ) )
+    {
+        for ( auto& obj : objs )
+        {
+            for ( int idx : obj.lines )
+            {
+                EV_output_fail( line_base + idx + 1, window.lines[idx], desc.error );
+                rejects.push_back( idx );
+            }
+        }
+        return false;
+    }
+
+    for ( size_t start = 0; start < objs.size( ); start += EV_LOAD_BATCH_SIZE )
+    {
+        size_t end = ( start + EV_LOAD_BATCH_SIZE < objs.size( ) ? start + EV_LOAD_BATCH_SIZE : objs.size( ) );
+        std::vector<EV_object_t*> batch;
+        std::vector<EV_object_t*> loaded;
+        std::vector<tag_t> tags;
+
+        for ( size_t i = start; i < end; i++ )
+        {
+            EV_object_t& obj = objs[i];
+            ifail = POM_string_to_tag( obj.uid.c_str( ), &obj.obj_tag );
+
+            if ( ifail != OK )
+            {
+                std::stringstream msg;
+                msg << "Unable to convert the uid (" << obj.uid << ") into a tag. Error = " << ifail << ".";
+
+                for ( int idx : obj.lines )
+                {
+                    EV_output_fail( line_base + idx + 1, window.lines[idx], msg.str( ) );
+                    rejects.push_back( idx );
+                }
+                success = false;
+                continue;
+            }
+
+            batch.push_back( &obj );
+            tags.push_back( obj.obj_tag );
+        }
+
+        if ( batch.empty( ) )
+        {
+            continue;
+        }
+
+        // Cache cpids and load the whole batch.
+        unsigned int cache_cnt = 0;
+        ifail = DMS_cache_cpids_of_class( (int)tags.size( ), tags.data( ), cls.c_str( ), NULL, &cache_cnt );
+
+        if ( ifail == OK && cache_cnt >= tags.size( ) )
+        {
+            ifail = POM_load_instances( (int)tags.size( ), tags.data( ), NULLTAG, POM_modify_lock );
+        }
+        else if ( ifail == OK )
+        {
+            ifail = POM_invalid_value;
+        }
+
+        if ( ifail == OK )
+        {
+            loaded = batch;
+        }
+        else
+        {
+            for ( EV_object_t* obj : batch )
+            {
+                const char* err = "load and lock";
+                cache_cnt = 0;
+                ifail = DMS_cache_cpids_of_class( 1, &obj->obj_tag, cls.c_str( ), NULL, &cache_cnt );
+
+                if ( ifail == OK && cache_cnt > 0 )
+                {
+                    ifail = POM_load_instances( 1, &obj->obj_tag, NULLTAG, POM_modify_lock );
+                }
+                else
+                {
+                    err = "cache cpid of";
+                }
+
+                if ( ifail != OK || cache_cnt < 1 )
+                {
+                    std::stringstream msg;
+                    msg << "Unable to " << err << " " << obj->uid << ". I.e. UID was not found in class " << cls << ". Error = " << ifail << ". cache_cnt = " << cache_cnt << ".";
+
+                    for ( int idx : obj->lines )
+                    {
+                        EV_output_fail( line_base + idx + 1, window.lines[idx], msg.str( ) );
+                        rejects.push_back( idx );
+                    }
+                    success = false;
+                }
+                else
+                {
+                    loaded.push_back( obj );
+                }
+            }
+        }
+
+        // Apply every edit to the loaded objects in memory.
+        std::vector<EV_object_t*> edited;
+        std::vector<tag_t> loaded_tags;
+        std::vector<tag_t> save_tags;
+
+        for ( EV_object_t* obj : loaded )
+        {
+            std::vector<int> ok_lines;
+            loaded_tags.push_back( obj->obj_tag );
+
+            for ( int idx : obj->lines )
+            {
+                *line_no = line_base + idx + 1;
+
+                const EV_csv_line_t& line = window.lines[idx];
+
+                if ( edit_vlas( line_base + idx + 1, header, line, &window.fields[line.first], obj->obj_tag, desc ) )
+                {
+                    ok_lines.push_back( idx );
+                }
+            }
+
+            if ( ok_lines.size( ) == obj->lines.size( ) )
             {
-                std::stringstream msg;
-                msg << "Unable to " << act << " VLA record (pos = " << vla_pos << ") from " << cls << ":" << att << ":" << uid << ".  Error = " << ifail << ".";
-                EV_output_fail( line_no, vla_mods, msg.str( ) );
+                edited.push_back( obj );
+                save_tags.push_back( obj->obj_tag );
+            }
+            else
+            {
+                // None of the object's edits are saved, so all of its lines are rejected.
+                // The failed lines have been reported by edit_vlas(), report the others too.
+                for ( int idx : ok_lines )
+                {
+                    EV_output_fail( line_base + idx + 1, window.lines[idx], "not applied: another edit to this object failed" );
+                }
+
+                rejects.insert( rejects.end( ), obj->lines.begin( ), obj->lines.end( ) );
                 success = false;
             }
         }
 
-        SM_free( (void*)new_string );
+        // Save each edited object once.
+        if ( !save_tags.empty( ) )
+        {
+            ifail = POM_save_instances( (int)save_tags.size( ), save_tags.data( ), false );
+
+            for ( EV_object_t* obj : edited )
+            {
+                // After a failed bulk save each object is saved on its own, so its own error is reported.
+                int save_fail = ( ifail != OK ? POM_save_instances( 1, &obj->obj_tag, false ) : OK );
+
+                if ( save_fail != OK )
+                {
+                    std::stringstream msg;
+                    msg << "Unable to save object " << obj->uid << ". Error = " << save_fail << ".";
+
+                    for ( int idx : obj->lines )
+                    {
+                        EV_output_fail( line_base + idx + 1, window.lines[idx], msg.str( ) );
+                        rejects.push_back( idx );
+                    }
+                    success = false;
+                    continue;
+                }
+
+                for ( int idx : obj->lines )
+                {
+                    EV_output_success( line_base + idx + 1, window.lines[idx] );
+                }
+            }
+        }
+
+        unlock_and_unload( (int)loaded_tags.size( ), loaded_tags.data( ) );
     }
 
-    if ( success )
+    return success;
+}
+
+/*------------------------------------------------------------------------
+** Groups a window of CSV data lines by class and object, keeping the order of
+** lines within each object, and applies them. line_base is the number of data
+** lines before the window. The indexes of lines that were not applied are added
+** to rejects.
+** ----------------------------------------------------------------------- */
+static bool EV_edit_window( std::vector<std::string>& header, EV_csv_window_t& window, int line_base, int* line_no, std::vector<int>& rejects )
+{
+    bool success = true;
+    std::map<std::string, std::vector<EV_object_t>> groups;
+    std::map<std::string, size_t> obj_index;
+
+    for ( int idx = 0; idx < (int)window.lines.size( ); idx++ )
     {
-        int ifail = POM_save_instances( 1, &obj_tag, false );
+        // Malformed lines have no fields and have already been rejected.
+        if ( window.lines[idx].first < 0 )
+        {
+            continue;
+        }
 
-        if ( ifail )
+        const EV_csv_field_t* fields = &window.fields[window.lines[idx].first];
+        std::string cls = EV_csv_field_str( fields[1] );
+        std::string uid = EV_csv_field_str( fields[2] );
+        std::vector<EV_object_t>& objs = groups[cls];
+        std::string key = cls + ":" + uid;
+        auto it = obj_index.find( key );
+
+        if ( it == obj_index.end( ) )
+        {
+            EV_object_t obj;
+            obj.uid = uid;
+            obj.obj_tag = NULLTAG;
+            it = obj_index.insert( std::make_pair( key, objs.size( ) ) ).first;
+            objs.push_back( obj );
+        }
+
+        objs[it->second].lines.push_back( idx );
+    }
+
+    for ( auto& group : groups )
+    {
+        if ( !EV_edit_class( group.first, group.second, header, window, line_base, line_no, rejects ) )
         {
-            std::stringstream msg;
-            msg << "Unable to save object " << uid << ". Error = " << ifail << ".";
-            EV_output_fail( line_no, vla_mods, msg.str( ) );
             success = false;
-            unlock_and_unload( obj_tag );
         }
-        else
+    }
+
+    return success;
+}
+
+/*------------------------------------------------------------------------
+** Describes every class named in the class column of the remaining data
+** lines, so that bad class and attribute names are reported before the first
+** edit. Only the class column is copied, the read position is restored.
+** ----------------------------------------------------------------------- */
+static void EV_describe_file_classes( EV_csv_reader_t* rdr, std::vector<std::string>& header )
+{
+    std::vector<EV_csv_field_t> fields;
+    std::set<std::string> classes;
+    size_t pos = rdr->pos;
+
+    while ( EV_csv_next_line( rdr, fields ) && !fields.empty( ) )
+    {
+        if ( rdr->bad == NULL && fields.size( ) == header.size( ) )
         {
-            EV_output_success( line_no, vla_mods );
-            unlock_and_unload( obj_tag );
+            classes.insert( EV_csv_field_str( fields[1] ) );
         }
     }
-    else
+
+    rdr->pos = pos;
+
+    for ( const std::string& cls : classes )
     {
-        unlock_and_unload( obj_tag );
+        EV_describe_class( cls, header );
     }
-    return success;
 }
 
-static int edit_array_op( )
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+/* Why the line just read cannot be edited, empty when it can.   */
+static std::string EV_csv_line_error( EV_csv_reader_t* rdr, std::vector<EV_csv_field_t>& fields, std::vector<std::string>& header )
+{
+    std::stringstream msg;
+
+    if ( rdr->bad != NULL )
+    {
+        msg << "Invalid data after the end of the CSV and before the next field (" << std::string( rdr->bad, rdr->bad_len ) << ")";
+    }
+    else if ( fields.size( ) != header.size( ) )
+    {
+        msg << "There must be the same number of data columns as there are header columns (" << fields.size( ) << " instead of " << header.size( ) << "). Check your CSV input file.";
+    }
+
+    return msg.str( );
+}
+
+/*------------------------------------------------------------------------
+** Reads up to max_lines CSV data lines into window. Returns false once the
+** data is exhausted, I.e. at the end of the file or an empty line.
+** A malformed line (wrong number of columns, data after a closing quote) sets
+** *ifail, unless rejects is given: the line is then reported, kept in window
+** without fields and its index is added to rejects.
+** ----------------------------------------------------------------------- */
+static logical EV_read_window( EV_csv_reader_t* rdr, std::vector<std::string>& header, int max_lines, EV_csv_window_t& window, int line_base, int* line_no, int* ifail, std::vector<int>* rejects )
+{
+    std::vector<EV_csv_field_t> fields;
+    EV_window_clear( window );
+
+    while ( (int)window.lines.size( ) < max_lines )
+    {
+        if ( !EV_csv_next_line( rdr, fields ) || fields.empty( ) )
+        {
+            return false;
+        }
+
+        std::string error = EV_csv_line_error( rdr, fields, header );
+
+        if ( !error.empty( ) )
+        {
+            *line_no = line_base + (int)window.lines.size( ) + 1;
+
+            if ( rejects == NULL )
+            {
+                cons_out( "ERROR: " + error );
+                *ifail = POM_invalid_value;
+                return false;
+            }
+
+            std::stringstream msg;
+            msg << "line " << *line_no << " - ERROR: " << std::string( rdr->line, rdr->line_len ) << ",ERROR: " << error;
+            cons_out( msg.str( ) );
+
+            rejects->push_back( (int)window.lines.size( ) );
+            EV_window_add( window, rdr, NULL );
+            continue;
+        }
+
+        EV_window_add( window, rdr, &fields );
+    }
+
+    return true;
+}
+
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+/* Write rejected CSV data lines in file order, as they were     */
+/* read.                                                         */
+static void EV_write_rejects( FILE* fp, EV_csv_window_t& window, std::vector<int>& rejects )
+{
+    std::sort( rejects.begin( ), rejects.end( ) );
+    rejects.erase( std::unique( rejects.begin( ), rejects.end( ) ), rejects.end( ) );
+
+    for ( int idx : rejects )
+    {
+        fwrite( window.lines[idx].text, 1, window.lines[idx].len, fp );
+        fputc( '\n', fp );
+    }
+
+    fflush( fp );
+}
+
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+/* Record the last committed CSV data line in the resume file,   */
+/* replacing the value of the previous chunk.                    */
+static void EV_write_resume( const std::string& resume_name, int line_base )
+{
+    FILE* fp = fnd_fopen( resume_name.c_str( ), "w" );
+
+    if ( fp == NULL )
+    {
+        logger( )->printf( "Unable to write the last committed line %d to %s\n", line_base, resume_name.c_str( ) );
+        return;
+    }
+
+    fprintf( fp, "%d\n", line_base );
+    fclose( fp );
+}
+
+/*------------------------------------------------------------------------
+** -commit -chunk=: edits and commits chunk_lines CSV data lines per working
+** transaction. Lines of objects that could not be edited and malformed lines
+** are written to the reject file and do not stop the run. A chunk counts the
+** lines read, rejected lines included, so -resume= stays a count of data lines. An exception rolls back the current chunk
+** and stops the run, the chunks before it stay committed and the console reports
+** the -resume= value that continues from the first uncommitted line. That value
+** is also rewritten to resume_name after every commit, so it survives a crash.
+** ----------------------------------------------------------------------- */
+static int EV_edit_in_chunks( EV_csv_reader_t* rdr, std::vector<std::string>& header, int line_base, int chunk_lines, FILE* rej_fp, const std::string& resume_name, int* reject_cnt )
+{
+    int ifail = POM_ok;
+    int chunk_cnt = 0;
+    logical more = true;
+    EV_csv_window_t window;
+
+    while ( more && ifail == POM_ok )
+    {
+        int line_no = line_base;
+        std::vector<int> rejects;
+        more = EV_read_window( rdr, header, chunk_lines, window, line_base, &line_no, &ifail, &rejects );
+
+        if ( ifail != POM_ok || window.lines.empty( ) )
+        {
+            break;
+        }
+
+        START_WORKING_TX( ev_chunk_tx, "ev_chunk_tx" );
+
+        ERROR_PROTECT
+
+        EV_edit_window( header, window, line_base, &line_no, rejects );
+
+        ERROR_RECOVER
+
+        ifail = ERROR_ask_failure_code( );
+        EIM_clear_error( );
+
+        ERROR_END
+
+        if ( ifail != POM_ok )
+        {
+            ROLLBACK_WORKING_TX( ev_chunk_tx, "ev_chunk_tx" );
+            std::stringstream msg;
+            msg << "Chunk " << ( chunk_cnt + 1 ) << " (lines " << ( line_base + 1 ) << "-" << ( line_base + (int)window.lines.size( ) ) << ") has been rolled back at line " << line_no << ". (ifail=" << ifail << ") See syslog for details.";
+            msg << "\nLast committed line = " << line_base << " (see " << resume_name << "), continue with -resume=" << line_base;
+            cons_out( msg.str( ) );
+            break;
+        }
+
+        COMMIT_WORKING_TX( ev_chunk_tx, "ev_chunk_tx" );
+
+        chunk_cnt++;
+        *reject_cnt += (int)rejects.size( );
+        EV_write_rejects( rej_fp, window, rejects );
+        line_base += (int)window.lines.size( );
+        EV_write_resume( resume_name, line_base );
+
+        std::stringstream msg;
+        msg << "Chunk " << chunk_cnt << " committed: " << ( (int)window.lines.size( ) - (int)rejects.size( ) ) << " lines edited, " << rejects.size( ) << " rejected. Last committed line = " << line_base << " (-resume=" << line_base << ")";
+        cons_out( msg.str( ) );
+    }
+
+    return ifail;
+}
+
+static int edit_array_op( int* found_count )
 {
     cons_out( "" );
     int ifail = OK;
@@ -13780,10 +18064,9 @@ static int edit_array_op( )
         return POM_invalid_value;
     }
 
-    std::vector<unsigned char> inString;
-    FILE* fp = fnd_fopen( args->file_name, "r" );
+    EV_csv_reader_t rdr;
 
-    if ( 0 == fp )
+    if ( EV_csv_open( args->file_name, &rdr ) != POM_ok )
     {
         std::stringstream msg;
         msg << "ERROR: Unable to open file";
@@ -13794,13 +18077,22 @@ static int edit_array_op( )
     // 
     // Read CSV header line. 
     //
+    std::vector<EV_csv_field_t> fields;
     std::vector<std::string> header;
-    read_next_csv_line( fp, header );
+    EV_csv_next_line( &rdr, fields );
+    EV_csv_copy_fields( fields, header );
+
+    if ( rdr.bad != NULL )
+    {
+        cons_out( "ERROR: Invalid data after the end of a quoted header column (" + std::string( rdr.bad, rdr.bad_len ) + ")." );
+        EV_csv_close( &rdr );
+        return POM_invalid_value;
+    }
 
     if ( header.size() < 5 )
     {
         cons_out( "ERROR: Insufficient number of header columns found in CSV input file. (action,class,uid,postion,<vla_attr>,...)" );
-        fclose( fp );
+        EV_csv_close( &rdr );
         return POM_invalid_value;
     }
 
@@ -13832,59 +18124,99 @@ static int edit_array_op( )
 
     if ( ifail )
     {
-        fclose( fp );
+        EV_csv_close( &rdr );
         return ifail;
     }
 
     // 
-    // Read in all data from CSV file.
+    // Skip the lines committed by a previous run.
     //
-    std::vector<std::vector<std::string>> file_data;
+    int line_base = 0;
 
-    int cnt = 0;
+    while ( line_base < args->resume_line && EV_csv_next_line( &rdr, fields ) && !fields.empty( ) )
+    {
+        line_base++;
+    }
 
-    do
+    if ( args->resume_line > 0 )
     {
-        std::vector<std::string>  data;
-        read_next_csv_line( fp, data );
+        std::stringstream msg;
+        msg << "Resuming after CSV data line " << line_base << ".";
+        cons_out( msg.str( ) );
+    }
+
+    EV_describe_file_classes( &rdr, header );
 
-        cnt = data.size( );
+    if ( args->commit_flag && args->chunk_size > 0 )
+    {
+        std::string rej_name = ( args->out_file != NULL ? std::string( args->out_file ) : std::string( args->file_name ) + ".reject" );
+        std::string resume_name = rej_name + ".resume";
+
+        // A resumed run adds its rejects to those of the interrupted run.
+        FILE* rej_fp = fnd_fopen( rej_name.c_str( ), args->resume_line > 0 ? "a" : "w" );
 
-        if ( cnt > 0 )
+        if ( rej_fp == NULL )
         {
-            if ( cnt != header.size( ) )
-            {
-                cons_out( "ERROR: There must be the same number of data columns as there are header columns. Check your CSV input file." );
-                fclose( fp );
-                ifail = POM_invalid_value;
-                return ifail;
-            }
+            cons_out( "ERROR: Unable to open the reject file " + rej_name );
+            EV_csv_close( &rdr );
+            return POM_invalid_value;
+        }
 
-            file_data.push_back( data );
+        if ( args->resume_line == 0 )
+        {
+            std::string line = list_to_csv_string( header );
+            line.pop_back( );
+            fprintf( rej_fp, "%s\n", line.c_str( ) );
         }
 
-    } while ( cnt > 0 );
+        int reject_cnt = 0;
+        ifail = EV_edit_in_chunks( &rdr, header, line_base, args->chunk_size, rej_fp, resume_name, &reject_cnt );
 
-    fclose( fp );
+        fclose( rej_fp );
+        EV_csv_close( &rdr );
+
+        std::stringstream msg;
+        msg << "Processing complete. " << reject_cnt << " lines rejected to " << rej_name << ".";
+        cons_out( msg.str( ) );
+
+        // With -cnt= the number of rejects is checked against it instead.
+        *found_count = reject_cnt;
+
+        if ( !ifail && reject_cnt > 0 && args->target_cnt < 0 )
+        {
+            ifail = POM_invalid_value;
+        }
+        return ifail;
+    }
 
     // 
-    // Edit VLAs.
+    // Read the data lines a window at a time and edit VLAs as the file is read.
     //
+    EV_csv_window_t window;
+    std::vector<int> rejects;
     int line_no = 0;
     bool success = true;
+    logical more = true;
 
     START_WORKING_TX( edit_vlas_tx, "edit_vlas_tx" );
 
     ERROR_PROTECT
 
-    for ( auto data : file_data )
+    while ( more && ifail == POM_ok )
     {
-        line_no++;
+        more = EV_read_window( &rdr, header, EV_WINDOW_LINES, window, line_base, &line_no, &ifail, NULL );
+        rejects.clear( );
 
-        if( !edit_vlas( line_no, header, data ))
+        if ( ifail != POM_ok )
+        {
+            success = false;
+        }
+        else if ( !EV_edit_window( header, window, line_base, &line_no, rejects ) )
         {
             success = false;
         }
+
+        line_base += (int)window.lines.size( );
     }
 
     ERROR_RECOVER
@@ -13895,6 +18227,8 @@ static int edit_array_op( )
 
     ERROR_END
 
+    EV_csv_close( &rdr );
+
     if ( !success || ifail )
     {
         ROLLBACK_WORKING_TX( edit_vlas_tx, "edit_vlas_tx" );
@@ -14481,7 +18815,8 @@ static void BPV_clear_temp_table( char* table_name )
     EIM_exec_imm( sql.c_str(), "BPV_clear_temporary_table(): Clearing temporary table" );
 }
 
-static int BPV_insert_refs_into_temp_table( const char* base_tbl, int cpid, const char* ref_tbl, const char* ref_uid_col, const char* ref_cls_col, const char* temp_tbl )
+// base_join is the table, aliased b, and the join condition that select the referencing objects.
+static int BPV_insert_refs_into_temp_table( const char* base_join, int cpid, const char* ref_tbl, const char* ref_uid_col, const char* ref_cls_col, const char* temp_tbl )
 {
     int ifail = POM_ok;
     std::string sql;
@@ -14490,35 +18825,35 @@ static int BPV_insert_refs_into_temp_table( const char* base_tbl, int cpid, cons
     {
         sql = fmt__format( "MERGE INTO %s d "
             "USING (SELECT a.puid AS from_uid, max(%d) AS from_class, a.%s AS to_uid, max(a.%s) AS to_class, count(*) AS bp_count FROM %s a "
-            "JOIN %s b ON a.puid = b.puid AND b.ppid = %d WHERE a.%s IS NOT NULL AND a.%s <> 'AAAAAAAAAAAAAA' GROUP BY a.puid, a.%s) c "
+            "JOIN %s WHERE a.%s IS NOT NULL AND a.%s <> 'AAAAAAAAAAAAAA' GROUP BY a.puid, a.%s) c "
             "ON (c.from_uid = d.from_uid AND c.to_uid = d.to_uid) "
             "WHEN MATCHED THEN "
             "UPDATE SET d.bp_count = (d.bp_count + c.bp_count) "
             "WHEN NOT MATCHED THEN "
             "INSERT (from_uid, from_class, to_uid, to_class, bp_count) "
             "VALUES (c.from_uid, c.from_class, c.to_uid, c.to_class, c.bp_count)",
-            temp_tbl, cpid, ref_uid_col, ref_cls_col, ref_tbl, base_tbl, cpid, ref_uid_col, ref_uid_col, ref_uid_col );
+            temp_tbl, cpid, ref_uid_col, ref_cls_col, ref_tbl, base_join, ref_uid_col, ref_uid_col, ref_uid_col );
     }
     else if ( EIM_dbplat( ) == EIM_dbplat_mssql )
     {
         sql = fmt__format( "MERGE INTO %s d "
             "USING (SELECT a.puid AS from_uid, max(%d) AS from_class, a.%s AS to_uid, max(a.%s) AS to_class, count(*) AS bp_count FROM %s a "
-            "JOIN %s b ON a.puid = b.puid AND b.ppid = %d WHERE a.%s IS NOT NULL AND a.%s <> 'AAAAAAAAAAAAAA' GROUP BY a.puid, a.%s) c "
+            "JOIN %s WHERE a.%s IS NOT NULL AND a.%s <> 'AAAAAAAAAAAAAA' GROUP BY a.puid, a.%s) c "
             "ON (c.from_uid = d.from_uid AND c.to_uid = d.to_uid) "
             "WHEN MATCHED THEN "
             "UPDATE SET d.bp_count = (d.bp_count + c.bp_count) "
             "WHEN NOT MATCHED THEN "
             "INSERT (from_uid, from_class, to_uid, to_class, bp_count) "
             "VALUES (c.from_uid, c.from_class, c.to_uid, c.to_class, c.bp_count);",
-            temp_tbl, cpid, ref_uid_col, ref_cls_col, ref_tbl, base_tbl, cpid, ref_uid_col, ref_uid_col, ref_uid_col );
+            temp_tbl, cpid, ref_uid_col, ref_cls_col, ref_tbl, base_join, ref_uid_col, ref_uid_col, ref_uid_col );
     }
     else if ( EIM_dbplat( ) == EIM_dbplat_postgres )
     {
         sql = fmt__format( "INSERT INTO %s AS d (from_uid, from_class, to_uid, to_class, bp_count) "
             "(SELECT a.puid AS from_uid, max(%d) AS from_class, a.%s AS to_uid, max(a.%s) AS to_class, count(*) AS bp_count "
-            "FROM %s a JOIN %s b ON a.puid = b.puid AND b.ppid = %d WHERE a.%s IS NOT NULL AND a.%s <> 'AAAAAAAAAAAAAA' GROUP BY a.puid, a.%s) "
+            "FROM %s a JOIN %s WHERE a.%s IS NOT NULL AND a.%s <> 'AAAAAAAAAAAAAA' GROUP BY a.puid, a.%s) "
             "ON CONFLICT (from_uid, to_uid) DO UPDATE SET bp_count = (d.bp_count + EXCLUDED.bp_count)",
-            temp_tbl, cpid, ref_uid_col, ref_cls_col, ref_tbl, base_tbl, cpid, ref_uid_col, ref_uid_col, ref_uid_col );
+            temp_tbl, cpid, ref_uid_col, ref_cls_col, ref_tbl, base_join, ref_uid_col, ref_uid_col, ref_uid_col );
     }
 
     EIM_exec_imm( sql.c_str( ), "Merging, references to be validated, into temporary table" );
@@ -14536,12 +18871,22 @@ static int validate_bp2_op( int* found_count )
     int processed_classes = 0;
     int processed_columns = 0;
     int processed_last_cpid = -1;
+    long long sampled_invalid_from_classes = 0;
+    long long sampled_invalid_bp_counts = 0;
+    long long sampled_missing_bps = 0;
+    long long sampled_unneeded_bps = 0;
 
     if ( found_count )
     {
         *found_count = 0;
     }
 
+    if ( args->estimate_flag && args->log_details )
+    {
+        cons_out( "\n-log_details is ignored with -estimate, only the sampled counts are reported." );
+        args->log_details = FALSE;
+    }
+
     // Get classes to process
     ifail = BPV_get_classes( args->class_n, cls_names, cls_cpids );
 
@@ -14590,6 +18935,23 @@ static int validate_bp2_op( int* found_count )
         std::string base_query_tbl = get_top_query_table( cls_cpids[i] );
 #endif  
 
+        // -estimate reads a block sample of the base query table. The sample is only taken by top-level
+        // SELECTs: the sampled objects are staged once and the MERGE and the backpointers side of the
+        // unneeded backpointer diff read the staged puids, so both sides of the diff describe the same objects.
+        std::string base_query_src = SAMPLE_table_clause( base_query_tbl.c_str(), "b" );
+        std::string base_join = fmt__format( "%s b ON a.puid = b.puid AND b.ppid = %d", base_query_tbl.c_str(), cls_cpids[i] );
+        std::string sample_filter;
+
+        if ( args->estimate_flag )
+        {
+            const char* sample_tbl = SAMPLE_uid_table();
+            BPV_clear_temp_table( (char*)sample_tbl );
+            SAMPLE_stage_uids( fmt__format( "SELECT b.puid FROM %s WHERE b.ppid = %d", base_query_src.c_str(), cls_cpids[i] ), sample_tbl, "puid" );
+
+            base_join = fmt__format( "%s b ON a.puid = b.puid", sample_tbl );
+            sample_filter = fmt__format( " AND from_uid IN (SELECT puid FROM %s)", sample_tbl );
+        }
+
         // Identify all the reference columns, minus the no-backpointer columns, for this object class. 
         std::vector<std::string> ref_table;
         std::vector<std::string> ref_uid_col;
@@ -14611,7 +18973,7 @@ static int validate_bp2_op( int* found_count )
             {
                 processed_columns++;
 
-                ifail = BPV_insert_refs_into_temp_table( base_query_tbl.c_str(), cls_cpids[i], ref_table[j].c_str(), ref_uid_col[j].c_str(), ref_cls_col[j].c_str(), tmp_tbl );
+                ifail = BPV_insert_refs_into_temp_table( base_join.c_str(), cls_cpids[i], ref_table[j].c_str(), ref_uid_col[j].c_str(), ref_cls_col[j].c_str(), tmp_tbl );
 
                 if ( ifail )
                 {
@@ -14640,13 +19002,13 @@ static int validate_bp2_op( int* found_count )
                 if ( !args->log_details )
                 {
                     sql = fmt__format( "SELECT TO_CHAR(COUNT(*)) AS strs FROM POM_BACKPOINTER a "
-                                       "JOIN %s b ON a.from_uid = b.puid and b.ppid = :1 WHERE a.from_class <> :2", base_query_tbl.c_str() );
+                                       "JOIN %s ON a.from_uid = b.puid and b.ppid = :1 WHERE a.from_class <> :2", base_query_src.c_str() );
                     select_strs( sql.c_str(), "validate_bp2_op(): Finding invalid_from_classes", MAX_COUNT_CHAR_SIZE + 2, 2, bind_vars, values );
                 }
                 else
                 {
                     sql = fmt__format( "SELECT a.from_uid, a.from_class, a.to_uid, a.to_class, a.bp_count FROM POM_BACKPOINTER a "
-                                       "JOIN %s b ON a.from_uid = b.puid and b.ppid = :1 WHERE a.from_class <> :2", base_query_tbl.c_str() );
+                                       "JOIN %s ON a.from_uid = b.puid and b.ppid = :1 WHERE a.from_class <> :2", base_query_src.c_str() );
                     log_bps_w_invalid_from_class( sql.c_str(), "validate_bp2_op(): Finding invalid_from_classes", 2, bind_vars, tmp_cpid, values );               
                 }
                 invalid_from_classes = values[0];
@@ -14685,7 +19047,7 @@ static int validate_bp2_op( int* found_count )
                 if ( !args->log_details )
                 {
                     sql = fmt__format( "SELECT TO_CHAR(COUNT(*)) AS strs FROM ( "
-                                       "SELECT from_uid, to_uid FROM POM_BACKPOINTER WHERE from_class = %d MINUS SELECT from_uid, to_uid FROM %s )", tmp_cpid, tmp_tbl );
+                                       "SELECT from_uid, to_uid FROM POM_BACKPOINTER WHERE from_class = %d%s MINUS SELECT from_uid, to_uid FROM %s )", tmp_cpid, sample_filter.c_str(), tmp_tbl );
                     select_strs( sql.c_str(), "validate_bp2_op(): Finding uneeded backpointers", MAX_COUNT_CHAR_SIZE + 2, 0, NULL, values );
                 }
                 else
@@ -14706,15 +19068,15 @@ static int validate_bp2_op( int* found_count )
                 if ( !args->log_details )
                 {
                     sql = fmt__format( "SELECT CAST(COUNT_BIG(*) as varchar(%d)) AS strs FROM POM_BACKPOINTER a "
-                                       "JOIN %s b ON a.from_uid = b.puid and b.ppid = :1 WHERE a.from_class <> :2",
-                        MAX_COUNT_CHAR_SIZE, base_query_tbl.c_str() );
+                                       "JOIN %s ON a.from_uid = b.puid and b.ppid = :1 WHERE a.from_class <> :2",
+                        MAX_COUNT_CHAR_SIZE, base_query_src.c_str() );
                     select_strs( sql.c_str(), "validate_bp2_op(): Finding invalid_from_classes", MAX_COUNT_CHAR_SIZE + 2, 2, bind_vars, values );
                 }
                 else
                 {
                     sql = fmt__format( "SELECT a.from_uid, a.from_class, a.to_uid, a.to_class, a.bp_count FROM POM_BACKPOINTER a "
-                                       "JOIN %s b ON a.from_uid = b.puid and b.ppid = :1 WHERE a.from_class <> :2",
-                        base_query_tbl.c_str() );
+                                       "JOIN %s ON a.from_uid = b.puid and b.ppid = :1 WHERE a.from_class <> :2",
+                        base_query_src.c_str() );
                     log_bps_w_invalid_from_class( sql.c_str(), "validate_bp2_op(): Finding invalid_from_classes", 2, bind_vars, tmp_cpid, values );               
                 }
                 invalid_from_classes = values[0];
@@ -14755,8 +19117,8 @@ static int validate_bp2_op( int* found_count )
                 if ( !args->log_details )
                 {
                     sql = fmt__format( "SELECT CAST(COUNT_BIG(*) as varchar(%d)) AS strs FROM ( "
-                                       "SELECT from_uid, to_uid FROM POM_BACKPOINTER WHERE from_class = %d EXCEPT SELECT from_uid, to_uid FROM %s ) AS c",
-                        MAX_COUNT_CHAR_SIZE, tmp_cpid, tmp_tbl );
+                                       "SELECT from_uid, to_uid FROM POM_BACKPOINTER WHERE from_class = %d%s EXCEPT SELECT from_uid, to_uid FROM %s ) AS c",
+                        MAX_COUNT_CHAR_SIZE, tmp_cpid, sample_filter.c_str(), tmp_tbl );
                     select_strs( sql.c_str(), "validate_bp2_op(): Finding uneeded backpointers", MAX_COUNT_CHAR_SIZE + 2, 0, NULL, values );
                 }
                 else
@@ -14777,15 +19139,15 @@ static int validate_bp2_op( int* found_count )
                 if ( !args->log_details )
                 {
                     sql = fmt__format( "SELECT COUNT(*)::text AS strs FROM POM_BACKPOINTER AS a "
-                                       "JOIN %s AS b ON a.from_uid = b.puid and b.ppid = :1 WHERE a.from_class <> :2",
-                        base_query_tbl.c_str() );
+                                       "JOIN %s ON a.from_uid = b.puid and b.ppid = :1 WHERE a.from_class <> :2",
+                        base_query_src.c_str() );
                     select_strs( sql.c_str(), "validate_bp2_op(): Finding invalid_from_classes", MAX_COUNT_CHAR_SIZE + 2, 2, bind_vars, values );
                 }
                 else
                 {
                     sql = fmt__format( "SELECT a.from_uid, a.from_class, a.to_uid, a.to_class, a.bp_count FROM POM_BACKPOINTER AS a "
-                                       "JOIN %s AS b ON a.from_uid = b.puid and b.ppid = :1 WHERE a.from_class <> :2",
-                        base_query_tbl.c_str() );
+                                       "JOIN %s ON a.from_uid = b.puid and b.ppid = :1 WHERE a.from_class <> :2",
+                        base_query_src.c_str() );
                     log_bps_w_invalid_from_class( sql.c_str(), "validate_bp2_op(): Finding invalid_from_classes", 2, bind_vars, tmp_cpid, values );
                 }
                 invalid_from_classes = values[0];
@@ -14826,8 +19188,8 @@ static int validate_bp2_op( int* found_count )
                 if ( !args->log_details )
                 {
                     sql = fmt__format( "WITH cte( from_uid, to_uid ) AS ( "
-                                       "SELECT from_uid, to_uid FROM POM_BACKPOINTER WHERE from_class = %d EXCEPT SELECT from_uid, to_uid FROM %s ) "
-                                       "SELECT COUNT(*)::text AS strs FROM cte", tmp_cpid, tmp_tbl );
+                                       "SELECT from_uid, to_uid FROM POM_BACKPOINTER WHERE from_class = %d%s EXCEPT SELECT from_uid, to_uid FROM %s ) "
+                                       "SELECT COUNT(*)::text AS strs FROM cte", tmp_cpid, sample_filter.c_str(), tmp_tbl );
                     select_strs( sql.c_str(), "validate_bp2_op(): Finding uneeded backpointers", MAX_COUNT_CHAR_SIZE + 2, 0, NULL, values );
                 }
                 else
@@ -14858,8 +19220,8 @@ static int validate_bp2_op( int* found_count )
                 }
 
                 // BPV:,class,cpid,Invalid_from_class,Invalid_bp_count,Missing_bp,Unneeded_bp,Comment,
-                std::string msg = fmt__format( "BPV:Summary,%s,%d,%s,%s,%s,%s,,", cls_names[i].c_str(), cls_cpids[i],
-                    invalid_from_classes.c_str(), invalid_bp_counts.c_str(), missing_bps.c_str(), unneeded_bps.c_str() );
+                std::string msg = fmt__format( "BPV:Summary,%s,%d,%s,%s,%s,%s,%s,", cls_names[i].c_str(), cls_cpids[i],
+                    invalid_from_classes.c_str(), invalid_bp_counts.c_str(), missing_bps.c_str(), unneeded_bps.c_str(), ( args->estimate_flag ? "sampled" : "" ) );
 
                 cons_out_no_log( msg );
                 logger()->printf( "%s\n", msg.c_str() );
@@ -14880,6 +19242,14 @@ static int validate_bp2_op( int* found_count )
                     temp = std::stoll( unneeded_bps, nullptr, 10 );
                     *found_count += (int)(temp & 0x7fffffff);
                 }
+
+                if ( args->estimate_flag )
+                {
+                    sampled_invalid_from_classes += std::stoll( invalid_from_classes, nullptr, 10 );
+                    sampled_invalid_bp_counts += std::stoll( invalid_bp_counts, nullptr, 10 );
+                    sampled_missing_bps += std::stoll( missing_bps, nullptr, 10 );
+                    sampled_unneeded_bps += std::stoll( unneeded_bps, nullptr, 10 );
+                }
             }
         }
         // Clean up after the class we just processed.
@@ -14897,11 +19267,23 @@ static int validate_bp2_op( int* found_count )
     cons_out( fmt__format( "Processed classes:     %d", processed_classes ) );
     cons_out( fmt__format( "Processed columns:     %d", processed_columns ) );
     cons_out( fmt__format( "Last CPID:             %d", processed_last_cpid ) );
+
+    if ( args->estimate_flag )
+    {
+        cons_out( fmt__format( "\nEstimates extrapolated from a %g percent block sample:", args->sample_pct ) );
+        cons_out( "Invalid from_class:    " + SAMPLE_format_estimate( sampled_invalid_from_classes ) );
+        cons_out( "Invalid bp_count:      " + SAMPLE_format_estimate( sampled_invalid_bp_counts ) );
+        cons_out( "Missing backpointers:  " + SAMPLE_format_estimate( sampled_missing_bps ) );
+        cons_out( "Unneeded backpointers: " + SAMPLE_format_estimate( sampled_unneeded_bps ) );
+    }
+
     if ( classes_with_problems > 0 && args->log_details)
     {
         cons_out( fmt__format( "Search syslog for \"BPV:\" for additional information" ) );
     }
 
+    SAMPLE_release();
+
     return ifail;
 }
 
@@ -14912,6 +19294,57 @@ static int validate_bp2_op( int* found_count )
 /* ********************************************************************************
 ** START OF: validate_cids_op() routines.
 ** *******************************************************************************/
+static const char* VCIDS_ALL_CLASSES = "ALL";              // -vc=ALL validates against POM_object and every flattened class.
+static std::vector< std::string > vcids_val_classes;        // -vc=ALL validation class names, indexed by ref_cpid_t::vc_idx.
+static std::vector< int > vcids_val_class_cnts;             // -vc=ALL problem class IDs found per validation class.
+static const int VCIDS_REPAIR_CHUNK_SIZE = 10000;           // -commit: default rows corrected per working transaction (see -chunk=).
+static int vcids_before_cnt = 0;                            // -commit: bad class IDs found before the repair.
+static int vcids_after_cnt = 0;                             // -commit: bad class IDs remaining after the repair.
+static int vcids_repaired_cnt = 0;                          // -commit: class IDs corrected.
+
+static logical is_vc_all()
+{
+    return ( args->val_class_n != NULL && strcmp( args->val_class_n, VCIDS_ALL_CLASSES ) == 0 );
+}
+
+/*-----------------------------------------------------------------
+** -vc=ALL: Builds a derived table of every object's puid and ppid by combining PPOM_OBJECT with the
+** tables of all flattened classes. Each row is tagged (vcx) with the position of its validation class
+** so that problem class IDs can be attributed to the class that owns the target object.
+** ---------------------------------------------------------------- */
+static int create_all_val_classes_target( const std::vector< std::string >& flattened_classes, std::string& target )
+{
+    int ifail = POM_ok;
+    std::stringstream sql;
+
+    vcids_val_classes.clear();
+    vcids_val_classes.push_back( "POM_object" );
+    vcids_val_classes.insert( vcids_val_classes.end(), flattened_classes.begin(), flattened_classes.end() );
+    vcids_val_class_cnts.assign( vcids_val_classes.size(), 0 );
+
+    sql << "(";
+
+    for ( int i = 0; i < vcids_val_classes.size(); i++ )
+    {
+        const char* cls_tbl = NULL;
+        ifail = get_class_table_name( vcids_val_classes[i].c_str(), &cls_tbl );
+
+        if ( ifail || !cls_tbl )
+        {
+            std::stringstream msg;
+            msg << "\nError " << ifail << " Unable to identify class table for class " << vcids_val_classes[i];
+            cons_out( msg.str() );
+            return ( ifail ? ifail : POM_invalid_string );
+        }
+
+        sql << ( i > 0 ? " UNION ALL " : "" ) << "SELECT puid, ppid, " << i << " AS vcx FROM " << cls_tbl;
+        SM_free( (void*)cls_tbl );
+    }
+
+    sql << ")";
+    target = sql.str();
+    return ifail;
+}
 
 /*-----------------------------------------------------------------*/
 static void output_att_ref_cid_data( const char prefix, const cls_t* cls, const cls_t* flat, const att_t* att )
@@ -14958,49 +19391,78 @@ static void output_att_ref_cid_data( const char prefix, const cls_t* cls, const
     }
 
 
-    ref_cpid_t* uids = (ref_cpid_t*)att->uids;
-/*
-    for ( int i = 0; i < att->uid_cnt; i++ )
-    {
-        out_msg << "\n        " << uids[i].uid << " " << uids[i].ref_cid << " " << uids[i].tar_cid;
-    }
-*/
-    int col_offset = 0;
-    int max_offset = 1;
+    ref_cpid_t* uids = (ref_cpid_t*)att->uids;
+/*
+    for ( int i = 0; i < att->uid_cnt; i++ )
+    {
+        out_msg << "\n        " << uids[i].uid << " " << uids[i].ref_cid << " " << uids[i].tar_cid;
+    }
+*/
+    std::string ref_tbl = get_ref_table(cls, flat, att);                 // reference table
+
+    for ( int i = 0; i < att->uid_cnt; i++ )
+    {
+        std::string ref_uid_col = get_ref_column(att, uids[i].slot);       // reference UID column of the slot holding the reference
+        std::string ref_cid_col = get_ref_cid_column(att, uids[i].slot);   // reference class ID column of the slot holding the reference
+
+        char* data_msg = SM_sprintf( "    VCIDS:UPDATE %s SET %s = %d WHERE %s = '%s' AND %s = %d;%s%s",
+            ref_tbl.c_str(), ref_cid_col.c_str(), uids[i].tar_cid, ref_uid_col.c_str(), uids[i].uid, ref_cid_col.c_str(), uids[i].ref_cid,
+            ( is_vc_all() ? " -- " : "" ), ( is_vc_all() ? vcids_val_classes[uids[i].vc_idx].c_str() : "" ) );
+
+        // out_msg << "\n    VCIDS:UPDATE " << ref_tbl << " SET " << ref_cid_col << " = " << uids[i].tar_cid << " WHERE ";
+        // out_msg << ref_uid_col << " = '" << uids[i].uid << "' AND " << ref_cid_col << " = " << uids[i].ref_cid;
+
+        if ( args->min_flag )
+        {
+            lprintf( "%s\n", data_msg );
+        }
+        else
+        {
+            cons_out( data_msg );
+        }
+
+        SM_free( data_msg );
+    }
+}
+
+
+/*----------------------------------------------------------------------- -
+** Returns the FROM-clause source, aliased "s", of an attribute's references
+** as (ref_uid, ref_cid, slot) rows. Small-array slots are unpivoted so that
+** the target table is joined once for the whole attribute.
+** ---------------------------------------------------------------------- - */
+static std::string get_ref_cid_source( const cls_t* cls, const cls_t* flat, const att_t* att )
+{
+    std::string ref_tbl = get_ref_table( cls, flat, att );
+    std::stringstream src;
 
-    if (isSA(att))
+    if ( !isSA( att ) )
     {
-        max_offset = att->plength;
+        src << "(SELECT " << get_ref_column( att, 0 ) << " AS ref_uid, " << get_ref_cid_column( att, 0 ) << " AS ref_cid, 0 AS slot FROM " << ref_tbl << ") s ";
     }
-
-    for (; col_offset < max_offset; col_offset++)
+    else if ( EIM_dbplat( ) == EIM_dbplat_oracle )
     {
-        std::string ref_tbl = get_ref_table(cls, flat, att);             // reference table
-        std::string ref_uid_col = get_ref_column(att, col_offset);       // reference UID column
-        std::string ref_cid_col = get_ref_cid_column(att, col_offset);   // reference class ID column
+        src << ref_tbl << " UNPIVOT ((ref_uid, ref_cid) FOR slot IN (";
 
-        for ( int i = 0; i < att->uid_cnt; i++ )
+        for ( int col_offset = 0; col_offset < att->plength; col_offset++ )
         {
-            char* data_msg = SM_sprintf( "    VCIDS:UPDATE %s SET %s = %d WHERE %s = '%s' AND %s = %d;",
-                ref_tbl.c_str(), ref_cid_col.c_str(), uids[i].tar_cid, ref_uid_col.c_str(), uids[i].uid, ref_cid_col.c_str(), uids[i].ref_cid );
-
-            // out_msg << "\n    VCIDS:UPDATE " << ref_tbl << " SET " << ref_cid_col << " = " << uids[i].tar_cid << " WHERE ";
-            // out_msg << ref_uid_col << " = '" << uids[i].uid << "' AND " << ref_cid_col << " = " << uids[i].ref_cid;
-
-            if ( args->min_flag )
-            {
-                lprintf( "%s\n", data_msg );
-            }
-            else
-            {
-                cons_out( data_msg );
-            }
+            src << ( col_offset > 0 ? ", " : "" ) << "(" << get_ref_column( att, col_offset ) << ", " << get_ref_cid_column( att, col_offset ) << ") AS " << col_offset;
+        }
+        src << ")) s ";
+    }
+    else
+    {
+        src << ref_tbl << " a " << ( EIM_dbplat( ) == EIM_dbplat_mssql ? "CROSS APPLY" : "CROSS JOIN LATERAL" ) << " (VALUES ";
 
-            SM_free( data_msg );
+        for ( int col_offset = 0; col_offset < att->plength; col_offset++ )
+        {
+            src << ( col_offset > 0 ? ", " : "" ) << "(a." << get_ref_column( att, col_offset ) << ", a." << get_ref_cid_column( att, col_offset ) << ", " << col_offset << ")";
         }
+        src << ") AS s (ref_uid, ref_cid, slot) ";
     }
-}
 
+    return src.str();
+}
 
 /*----------------------------------------------------------------------- -
 ** Get UIDs with invalid class IDs
@@ -15008,33 +19470,20 @@ static void output_att_ref_cid_data( const char prefix, const cls_t* cls, const
 static int get_ref_cids( const char* target_ppid_tbl, cls_t* cls, const cls_t* flat, att_t* att, int max_records )
 {
     int ifail = OK;
-    int record_cnt = max_records;
 
     ERROR_PROTECT
     att->uids = NULL;
     att->uid_cnt = 0;
 
-    int col_offset = 0;
-    int max_offset = 1; 
-
-    if ( isSA( att ) )
+    if ( max_records > 0 || max_records == -1 )
     {
-        max_offset = att->plength;
-    }
-
-    for ( ; col_offset < max_offset && (record_cnt > 0 || max_records == -1); col_offset++ )
-    {
-        EIM_select_var_t vars[3];
+        EIM_select_var_t vars[5];
         EIM_value_p_t headers = NULL;
         EIM_row_p_t report = NULL;
         EIM_row_p_t row;
         int row_cnt = 0;
         ref_cpid_t* alloc_uids = NULL;
 
-        std::string ref_tbl = get_ref_table( cls, flat, att );             // reference table
-        std::string ref_uid_col = get_ref_column( att, col_offset );       // reference UID column
-        std::string ref_cid_col = get_ref_cid_column( att, col_offset );   // reference class ID column
-
         std::stringstream sql;
         sql << "SELECT ";
 
@@ -15050,11 +19499,11 @@ static int get_ref_cids( const char* target_ppid_tbl, cls_t* cls, const cls_t* f
             sql << "TOP " << (args->max_ref_cnt) << " ";
         }
 
-        sql << "a." << ref_uid_col << " as puid, a." << ref_cid_col << " as ref, b.ppid as tar FROM " << ref_tbl << " a ";
+        sql << "s.ref_uid as puid, s.ref_cid as ref, b.ppid as tar, s.slot as slot" << ( is_vc_all() ? ", b.vcx as vcx" : "" ) << " FROM " << get_ref_cid_source( cls, flat, att );
 
-        sql << "INNER JOIN " << target_ppid_tbl << " b ON a." << ref_uid_col << " = b.puid ";
+        sql << "INNER JOIN " << target_ppid_tbl << " b ON s.ref_uid = b.puid ";
 
-        sql << "WHERE a." << ref_cid_col << " <> b.ppid";
+        sql << "WHERE s.ref_cid <> b.ppid";
 
         if ( EIM_dbplat( ) == EIM_dbplat_oracle )
         {
@@ -15068,7 +19517,9 @@ static int get_ref_cids( const char* target_ppid_tbl, cls_t* cls, const cls_t* f
         EIM_select_col( &(vars[0]), EIM_varchar, "puid", MAX_UID_SIZE, false );
         EIM_select_col( &(vars[1]), EIM_integer, "ref", sizeof( int ), false );
         EIM_select_col( &(vars[2]), EIM_integer, "tar", sizeof( int ), false );
-        ifail = EIM_exec_sql_bind( sql.str( ).c_str( ), &headers, &report, 0, 3, vars, 0, NULL );
+        EIM_select_col( &(vars[3]), EIM_integer, "slot", sizeof( int ), false );
+        EIM_select_col( &(vars[4]), EIM_integer, "vcx", sizeof( int ), false );
+        ifail = EIM_exec_sql_bind( sql.str( ).c_str( ), &headers, &report, 0, ( is_vc_all() ? 5 : 4 ), vars, 0, NULL );
 
         if ( !args->ignore_errors_flag )
         {
@@ -15094,7 +19545,6 @@ static int get_ref_cids( const char* target_ppid_tbl, cls_t* cls, const cls_t* f
 
             for ( row = report; row != NULL; row = row->next ) row_cnt++;
 
-            record_cnt -= row_cnt;
             alloc_uids = (ref_cpid_t*)SM_realloc( att->uids, ( sizeof( ref_cpid_t ) * ( att->uid_cnt + row_cnt ) ) );
             att->uids = NULL;
 
@@ -15105,6 +19555,8 @@ static int get_ref_cids( const char* target_ppid_tbl, cls_t* cls, const cls_t* f
                 alloc_uids[off].uid[0] = '\0';
                 alloc_uids[off].ref_cid = 0;
                 alloc_uids[off].tar_cid = 0;
+                alloc_uids[off].slot = 0;
+                alloc_uids[off].vc_idx = 0;
 
                 char* tmp = NULL;
                 EIM_find_value( headers, row->line, "puid", EIM_varchar, &tmp );
@@ -15119,6 +19571,18 @@ static int get_ref_cids( const char* target_ppid_tbl, cls_t* cls, const cls_t* f
                 EIM_find_value( headers, row->line, "tar", EIM_integer, &cpid );
                 alloc_uids[off].tar_cid = *cpid;
 
+                int* slot = NULL;
+                EIM_find_value( headers, row->line, "slot", EIM_integer, &slot );
+                alloc_uids[off].slot = *slot;
+
+                if ( is_vc_all() )
+                {
+                    int* vcx = NULL;
+                    EIM_find_value( headers, row->line, "vcx", EIM_integer, &vcx );
+                    alloc_uids[off].vc_idx = *vcx;
+                    vcids_val_class_cnts[*vcx]++;
+                }
+
                 off++;
             }
 
@@ -15148,6 +19612,233 @@ static int get_ref_cids( const char* target_ppid_tbl, cls_t* cls, const cls_t* f
     return(ifail);
 }
 
+/*----------------------------------------------------------------------- -
+** -out: Writes every reference of the attribute with an invalid class ID
+** to the -out file. att->uid_cnt is set to the number of rows written,
+** att->uids is not allocated.
+** ---------------------------------------------------------------------- - */
+static int stream_ref_cids( const char* target_ppid_tbl, cls_t* cls, const cls_t* flat, att_t* att )
+{
+    int ifail = OK;
+
+    att->uids = NULL;
+    att->uid_cnt = 0;
+
+    ERROR_PROTECT
+    std::stringstream sql;
+    sql << "SELECT ";
+
+    if ( !args->noparallel_flag && EIM_dbplat( ) == EIM_dbplat_oracle )
+    {
+        sql << "/*+ parallel */ ";
+    }
+
+    sql << "distinct s.ref_uid as puid, s.ref_cid as ref_cid, b.ppid as tar_cid, s.slot as slot, " << ( is_vc_all() ? "b.vcx" : "0" ) << " as vcx FROM " << get_ref_cid_source( cls, flat, att );
+    sql << "INNER JOIN " << target_ppid_tbl << " b ON s.ref_uid = b.puid WHERE s.ref_cid <> b.ppid";
+
+    int staged = OUT_stage( sql.str() );
+
+    std::string ref_tbl = get_ref_table( cls, flat, att );
+    std::vector< ref_cpid_t > page;
+
+    for ( int rn = 0; rn < staged; rn += OUT_PAGE_ROWS )
+    {
+        OUT_fetch_page( rn, page );
+
+        for ( size_t i = 0; i < page.size(); i++ )
+        {
+            std::string ref_uid_col = get_ref_column( att, page[i].slot );
+            std::string ref_cid_col = get_ref_cid_column( att, page[i].slot );
+            const char* val_class = ( is_vc_all() ? vcids_val_classes[page[i].vc_idx].c_str() : args->val_class_n );
+
+            OUT_printf( "%s,%s,%s,%s,%d,%d,%s\n", ref_tbl.c_str(), ref_uid_col.c_str(), ref_cid_col.c_str(), page[i].uid, page[i].ref_cid, page[i].tar_cid, val_class );
+
+            if ( is_vc_all() )
+            {
+                vcids_val_class_cnts[page[i].vc_idx]++;
+            }
+        }
+    }
+
+    OUT_clear_stage();
+    att->uid_cnt = staged;
+
+    if ( flat == NULL )
+    {
+        cls->ref_cnt += staged;
+    }
+    else
+    {
+        cls->flt_cnt += staged;
+    }
+
+    ERROR_RECOVER
+    ifail = ERROR_ask_failure_code();
+
+    if ( !args->ignore_errors_flag )
+    {
+        const std::string msg( "EXCEPTION [stream_ref_cids()]: See syslog for additional details. (See -i option to ignore this error.)" );
+        cons_out( msg );
+        ERROR_reraise( );
+    }
+    EIM_clear_error( );
+    ERROR_END
+
+    return(ifail);
+}
+
+/*----------------------------------------------------------------------- -
+** Counts the references, over all slots of the attribute, whose class ID
+** does not match the ppid of the target object.
+** ---------------------------------------------------------------------- - */
+static int count_bad_ref_cids( const char* target_ppid_tbl, const cls_t* cls, const cls_t* flat, const att_t* att )
+{
+    std::stringstream sql;
+    sql << "SELECT COUNT(*) AS CNT FROM " << get_ref_cid_source( cls, flat, att );
+    sql << "INNER JOIN " << target_ppid_tbl << " b ON s.ref_uid = b.puid WHERE s.ref_cid <> b.ppid";
+
+    int cnt = 0;
+    int rows = 0;
+    get_int_from_sql( sql.str().c_str(), "CNT", &cnt, &rows );
+
+    return ( cnt > 0 ? cnt : 0 );
+}
+
+/*----------------------------------------------------------------------- -
+** -commit: Sets each slot's class-ID column to the ppid of the target object.
+** The class IDs are corrected straight from the join, at most chunk_size
+** rows per statement, and each chunk is committed in its own working transaction.
+** With -vc=ALL a puid found in several validation class tables with different
+** ppids is ambiguous and left as it is. No more than max_repairs rows, the bad
+** class IDs counted beforehand, are corrected.
+** ---------------------------------------------------------------------- - */
+static int repair_ref_cids( const char* target_ppid_tbl, cls_t* cls, const cls_t* flat, att_t* att, int max_repairs, int* repaired )
+{
+    int ifail = OK;
+    int chunk_size = ( args->chunk_size > 0 ? args->chunk_size : VCIDS_REPAIR_CHUNK_SIZE );
+    int max_offset = ( isSA( att ) ? att->plength : 1 );
+    std::string ref_tbl = get_ref_table( cls, flat, att );
+    std::string repair_tbl( target_ppid_tbl );
+    *repaired = 0;
+
+    if ( is_vc_all() )
+    {
+        // One ppid per puid, otherwise the rows flip between the ppids on every chunk (and ORA-30926 in the MERGE).
+        repair_tbl = "(SELECT puid, MIN(ppid) AS ppid FROM " + repair_tbl + " t GROUP BY puid HAVING COUNT(DISTINCT ppid) = 1)";
+    }
+
+    EIM_commit_transaction( "" );
+
+    for ( int col_offset = 0; col_offset < max_offset && *repaired < max_repairs && ifail == OK; col_offset++ )
+    {
+        std::string u = get_ref_column( att, col_offset );
+        std::string c = get_ref_cid_column( att, col_offset );
+        std::stringstream sql;
+
+        switch ( EIM_dbplat() )
+        {
+        case EIM_dbplat_oracle:
+            sql << "MERGE INTO " << ref_tbl << " a USING (SELECT a2.rowid AS rid, b.ppid FROM " << ref_tbl << " a2 INNER JOIN " << repair_tbl << " b ON a2." << u << " = b.puid";
+            sql << " WHERE a2." << c << " <> b.ppid AND ROWNUM <= " << chunk_size << ") s ON (a.rowid = s.rid) WHEN MATCHED THEN UPDATE SET a." << c << " = s.ppid";
+            break;
+
+        case EIM_dbplat_mssql:
+            sql << "UPDATE TOP (" << chunk_size << ") a SET a." << c << " = b.ppid FROM " << ref_tbl << " a INNER JOIN " << repair_tbl << " b ON a." << u << " = b.puid";
+            sql << " WHERE a." << c << " <> b.ppid";
+            break;
+
+        case EIM_dbplat_postgres:
+            sql << "UPDATE " << ref_tbl << " a SET " << c << " = b.ppid FROM " << repair_tbl << " b WHERE a." << u << " = b.puid AND a." << c << " <> b.ppid";
+            sql << " AND a.ctid = ANY (ARRAY(SELECT a2.ctid FROM " << ref_tbl << " a2 INNER JOIN " << repair_tbl << " b2 ON a2." << u << " = b2.puid";
+            sql << " WHERE a2." << c << " <> b2.ppid FETCH FIRST " << chunk_size << " ROWS ONLY))";
+            break;
+
+        default:
+            ERROR_internal( ERROR_line, "Unrecognized EIM_dbplat value" );
+        }
+
+        int chunk_updated = chunk_size;
+
+        while ( chunk_updated >= chunk_size && *repaired < max_repairs && ifail == OK )
+        {
+            chunk_updated = 0;
+
+            START_WORKING_TX( vcids_repair_tx, "vcids_repair_tx" );
+
+            ERROR_PROTECT
+
+            chunk_updated = RUB_dml_or_ddl( sql.str().c_str() );
+
+            ERROR_RECOVER
+
+            if ( ifail == OK )
+            {
+                ifail = ERROR_ask_failure_code();
+
+                if ( !ifail )
+                {
+                    ifail = POM_internal_error;
+                }
+            }
+            ERROR_END
+
+            if ( ifail )
+            {
+                ROLLBACK_WORKING_TX( vcids_repair_tx, "vcids_repair_tx" );
+                std::stringstream msg;
+                msg << "\nRepair of " << ref_tbl << "." << c << " has been rolled back. (ifail=" << ifail << ") See syslog for details.";
+                msg << "\n" << *repaired << " class IDs of " << cls->name << ":" << att->name << " were corrected by previously committed chunks.";
+                cons_out( msg.str() );
+                break;
+            }
+
+            COMMIT_WORKING_TX( vcids_repair_tx, "vcids_repair_tx" );
+            *repaired += chunk_updated;
+
+            if ( args->verbose_flag )
+            {
+                std::stringstream msg;
+                msg << "    VCIDS:Chunk committed: " << chunk_updated << " class IDs corrected in " << ref_tbl << "." << c;
+                cons_out( msg.str() );
+            }
+        }
+    }
+
+    EIM_start_transaction();
+
+    return ifail;
+}
+
+/*----------------------------------------------------------------------- -
+** Counts, repairs and then re-counts the bad class IDs of an attribute,
+** accumulating the before/after/repaired totals.
+** ---------------------------------------------------------------------- - */
+static int repair_att_ref_cids( const char* target_ppid_tbl, cls_t* cls, const cls_t* flat, att_t* att )
+{
+    int repaired = 0;
+    int before = count_bad_ref_cids( target_ppid_tbl, cls, flat, att );
+    int ifail = repair_ref_cids( target_ppid_tbl, cls, flat, att, before, &repaired );
+    int after = count_bad_ref_cids( target_ppid_tbl, cls, flat, att );
+
+    vcids_before_cnt += before;
+    vcids_after_cnt += after;
+    vcids_repaired_cnt += repaired;
+
+    std::stringstream msg;
+    msg << "    VCIDS:Repaired " << get_ref_table_and_column( cls, flat, att, -1, true ) << ": before = " << before << ", corrected = " << repaired << ", after = " << after;
+
+    if ( args->min_flag )
+    {
+        lprintf( "%s\n", msg.str().c_str() );
+    }
+    else
+    {
+        cons_out( msg.str() );
+    }
+
+    return ifail;
+}
+
 /*------------------------------------------------------------------------
 ** Searches (non-flattened) reference attributes for class-ID values that
 ** do not match class ID (ppid) values in the target class table.
@@ -15165,7 +19856,8 @@ static int output_ref_cids( const char* target_ppid_tbl, cls_t* cls, int* accum_
         for ( int j = 0; j < att_cnt && *accum_cnt < args->max_ref_cnt; j++ )
         {
             int remaining = args->max_ref_cnt - *accum_cnt;
-            int lcl_ifail = get_ref_cids( target_ppid_tbl, cls, NULL, &cls->atts[j], (remaining > 0 ? remaining : 0) );
+            int lcl_ifail = ( args->out_file != NULL ? stream_ref_cids( target_ppid_tbl, cls, NULL, &cls->atts[j] )
+                                                     : get_ref_cids( target_ppid_tbl, cls, NULL, &cls->atts[j], (remaining > 0 ? remaining : 0) ) );
 
             if ( lcl_ifail != OK )
             {
@@ -15182,10 +19874,36 @@ static int output_ref_cids( const char* target_ppid_tbl, cls_t* cls, int* accum_
 
             if ( cls->atts[j].uid_cnt > 0 )
             {
-                output_att_ref_cid_data( VSR_DATA_LINE, cls, NULL, &cls->atts[j] );
-                *accum_cnt += cls->atts[j].uid_cnt;
+                if ( args->out_file != NULL )
+                {
+                    std::stringstream msg;
+                    msg << cls->atts[j].uid_cnt << " class IDs written to " << args->out_file;
+                    output_att_msg( cls, NULL, &cls->atts[j], msg.str().c_str() );
+                }
+                else
+                {
+                    output_att_ref_cid_data( VSR_DATA_LINE, cls, NULL, &cls->atts[j] );
+                }
+
+                if ( !args->commit_flag )
+                {
+                    *accum_cnt += cls->atts[j].uid_cnt;
+                }
+                else
+                {
+                    // Repairs are not limited by -max, so keep going through all the attributes.
+                    lcl_ifail = repair_att_ref_cids( target_ppid_tbl, cls, NULL, &cls->atts[j] );
+
+                    if ( ifail == OK )
+                    {
+                        ifail = lcl_ifail;
+                    }
+                }
                 // Free up memory used to temporary hold UIDs. 
-                SM_free( cls->atts[j].uids );
+                if ( cls->atts[j].uids != NULL )
+                {
+                    SM_free( cls->atts[j].uids );
+                }
                 cls->atts[j].uids = NULL;
                 cls->atts[j].uid_cnt = 0;
             }
@@ -15248,7 +19966,8 @@ static int output_flattened_ref_cids( const char* target_ppid_tbl, const std::ve
                         continue;
                     }
                     int remaining = args->max_ref_cnt - *accum_cnt;
-                    int lcl_ifail = get_ref_cids( target_ppid_tbl, cur_cls, flat, &cur_cls->atts[j], ( remaining > 0 ? remaining : 0 ) );
+                    int lcl_ifail = ( args->out_file != NULL ? stream_ref_cids( target_ppid_tbl, cur_cls, flat, &cur_cls->atts[j] )
+                                                             : get_ref_cids( target_ppid_tbl, cur_cls, flat, &cur_cls->atts[j], ( remaining > 0 ? remaining : 0 ) ) );
 
                     if ( lcl_ifail != OK )
                     {
@@ -15265,10 +19984,36 @@ static int output_flattened_ref_cids( const char* target_ppid_tbl, const std::ve
 
                     if ( cur_cls->atts[j].uid_cnt > 0 )
                     {
-                        output_att_ref_cid_data( VSR_DATA_LINE, cur_cls, flat, &cur_cls->atts[j] );
-                        *accum_cnt += cur_cls->atts[j].uid_cnt;
+                        if ( args->out_file != NULL )
+                        {
+                            std::stringstream msg;
+                            msg << cur_cls->atts[j].uid_cnt << " class IDs written to " << args->out_file;
+                            output_att_msg( cur_cls, flat, &cur_cls->atts[j], msg.str().c_str() );
+                        }
+                        else
+                        {
+                            output_att_ref_cid_data( VSR_DATA_LINE, cur_cls, flat, &cur_cls->atts[j] );
+                        }
+
+                        if ( !args->commit_flag )
+                        {
+                            *accum_cnt += cur_cls->atts[j].uid_cnt;
+                        }
+                        else
+                        {
+                            // Repairs are not limited by -max, so keep going through all the attributes.
+                            lcl_ifail = repair_att_ref_cids( target_ppid_tbl, cur_cls, flat, &cur_cls->atts[j] );
+
+                            if ( ifail == OK )
+                            {
+                                ifail = lcl_ifail;
+                            }
+                        }
                         // Free up memory used to temporary hold UIDs. 
-                        SM_free( cur_cls->atts[j].uids );
+                        if ( cur_cls->atts[j].uids != NULL )
+                        {
+                            SM_free( cur_cls->atts[j].uids );
+                        }
                         cur_cls->atts[j].uids = NULL;
                         cur_cls->atts[j].uid_cnt = 0;
                     }
@@ -15300,7 +20045,7 @@ static int validate_cids_op( int* found_count )
     else
     {
         // Check that the user has specified a validation class that contains the ppid column. (-vc=<class_name>)
-        if (strcmp("POM_object", args->val_class_n) != 0)
+        if (strcmp("POM_object", args->val_class_n) != 0 && !is_vc_all())
         {
             get_flattened_class_names(flattened_classes);
             ifail = POM_invalid_string;
@@ -15339,14 +20084,32 @@ static int validate_cids_op( int* found_count )
             msg << "\n       " << flattened_classes[i];
         }
 
-        msg << "\n\n       Note: For complete coverage the utility should be run once with each of these classes.";
+        msg << "\n\n       Note: For complete coverage the utility should be run once with each of these classes,";
+        msg << "\n             or once with -vc=" << VCIDS_ALL_CLASSES << " to validate against all of them in a single pass.";
         cons_out(msg.str());
 
         return ifail;
     }
 
     const char* target_ppid_tbl = NULL;
-    ifail = get_class_table_name( args->val_class_n, &target_ppid_tbl );
+    std::string all_target;
+
+    if ( is_vc_all() )
+    {
+        // Every reference column is read once and joined against all the validation class tables.
+        get_flattened_class_names( flattened_classes );
+        ifail = create_all_val_classes_target( flattened_classes, all_target );
+
+        if ( ifail )
+        {
+            return ifail;
+        }
+        target_ppid_tbl = all_target.c_str();
+    }
+    else
+    {
+        ifail = get_class_table_name( args->val_class_n, &target_ppid_tbl );
+    }
 
     if (ifail || !target_ppid_tbl)
     {
@@ -15363,7 +20126,14 @@ static int validate_cids_op( int* found_count )
 
     {
         std::stringstream msg;
-        msg << "\nValidation class = " << args->val_class_n << " / table = " << target_ppid_tbl;
+        if ( is_vc_all() )
+        {
+            msg << "\nValidation classes = POM_object and " << flattened_classes.size() << " flattened classes";
+        }
+        else
+        {
+            msg << "\nValidation class = " << args->val_class_n << " / table = " << target_ppid_tbl;
+        }
         cons_out(msg.str());
     }
 
@@ -15383,6 +20153,17 @@ static int validate_cids_op( int* found_count )
         dumpRefMetadata( meta );
     }
 
+    if ( args->out_file != NULL )
+    {
+        // -max does not apply, every bad class ID is streamed to the -out file.
+        args->max_ref_cnt = INT_MAX;
+
+        if ( OUT_open( "table,uid_column,cid_column,puid,bad_cid,correct_cid,validation_class" ) != OK )
+        {
+            return POM_invalid_value;
+        }
+    }
+
     /* Loop through each class and all reference attributes */
     /* looking for references with invalid class IDs.       */
     int ref_cnt = 0;
@@ -15508,6 +20289,12 @@ static int validate_cids_op( int* found_count )
         cons_out( msg.str( ) );
     }
 
+    if ( args->commit_flag )
+    {
+        // With -commit the repaired attributes are not limited by -max, report what was found before the repair.
+        ref_cnt = vcids_before_cnt;
+    }
+
     if ( found_count)
     {
         // We always retrieve 1 more than the maximum
@@ -15519,8 +20306,32 @@ static int validate_cids_op( int* found_count )
     msg << "\nNormal reference attributes processed     = " << att_processed;
     msg << "\nFlattened reference attributes processed  = " << flat_att_processed;
     msg << "\nReferences with bad class IDs found       = " << ref_cnt;
+
+    if ( args->commit_flag )
+    {
+        msg << "\nClass IDs corrected                       = " << vcids_repaired_cnt;
+        msg << "\nBad class IDs remaining after the repair  = " << vcids_after_cnt;
+    }
+
+    for ( int i = 0; is_vc_all() && i < vcids_val_classes.size(); i++ )
+    {
+        if ( vcids_val_class_cnts[i] > 0 )
+        {
+            msg << "\n    Validation class " << vcids_val_classes[i] << " = " << vcids_val_class_cnts[i];
+        }
+    }
     cons_out( msg.str( ) );
 
+    if ( args->out_file != NULL )
+    {
+        lcl_ifail = OUT_close();
+
+        if ( ifail == OK )
+        {
+            ifail = lcl_ifail;
+        }
+    }
+
     return(ifail);
 }
 